@@ -12,8 +12,11 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCryptographicHash>
@@ -29,6 +32,7 @@
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
 
+#include <AssetChunking.h>
 #include <ClientServerUtils.h>
 #include <NodeType.h>
 #include <SharedUtil.h>
@@ -36,9 +40,32 @@
 #include <image/TextureProcessing.h>
 
 #include "AssetServerLogging.h"
-#include "BakeAssetTask.h"
+#include "HotAssetCache.h"
+#include "MappedAssetCache.h"
+#include "SendAssetManifestTask.h"
 #include "SendAssetTask.h"
+#include "StoredChunkIndex.h"
 #include "UploadAssetTask.h"
+#include "UploadChunkedAssetTask.h"
+
+// caps on the asset files we keep mapped between requests, address space is only plentiful on 64-bit
+static const int MAX_MAPPED_ASSETS = 256;
+static const qint64 MAX_MAPPED_ASSET_BYTES = sizeof(void*) > 4 ? 4LL * 1024 * 1024 * 1024 : 256LL * 1024 * 1024;
+
+// default size of the in memory cache of hot assets, and the largest asset it will hold
+static const int DEFAULT_HOT_ASSET_CACHE_MEGABYTES = 256;
+static const qint64 MAX_HOT_ASSET_BYTES = 64 * 1024 * 1024;
+static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+
+// downloads a single node may have running on the transfer pool at once, the rest wait their turn
+static const int MAX_CONCURRENT_SENDS_PER_NODE = 4;
+
+// oven processes baking at once, how long one bake may take and how much memory it may use, by default
+static const int DEFAULT_BAKE_WORKER_COUNT = 2;
+static const int DEFAULT_BAKE_TIMEOUT_SECS = 10 * 60;
+static const int DEFAULT_BAKE_MEMORY_LIMIT_MEGABYTES = 4096;
+// a bake is tried this many times before an oven that keeps crashing or timing out on it fails it
+static const int MAX_BAKE_ATTEMPTS = 3;
 
 static const uint8_t MIN_CORES_FOR_MULTICORE = 4;
 static const uint8_t CPU_AFFINITY_COUNT_HIGH = 2;
@@ -115,18 +142,7 @@ const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
-    auto it = _pendingBakes.find(assetHash);
-    if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
-        task->setAutoDelete(false);
-        _pendingBakes[assetHash] = task;
-
-        connect(task.get(), &BakeAssetTask::bakeComplete, this, &AssetServer::handleCompletedBake);
-        connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
-        connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
-
-        _bakingTaskPool.start(task.get());
-    } else {
+    if (!_bakeFarm.queueBake(assetHash, assetPath, filePath)) {
         qDebug() << "Already in queue";
     }
 }
@@ -136,9 +152,10 @@ QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash)
 }
 
 std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
-    auto it = _pendingBakes.find(hash);
-    if (it != _pendingBakes.end()) {
-        return { (*it)->isBaking() ? AssetUtils::Baking : AssetUtils::Pending, "" };
+    if (_bakeFarm.isBaking(hash)) {
+        return { AssetUtils::Baking, "" };
+    } else if (_bakeFarm.isQueued(hash)) {
+        return { AssetUtils::Pending, "" };
     }
 
     if (path.startsWith(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
@@ -294,7 +311,9 @@ void updateConsumedCores() {
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
-    _bakingTaskPool(this),
+    _mappedAssets(std::make_shared<MappedAssetCache>(MAX_MAPPED_ASSETS, MAX_MAPPED_ASSET_BYTES)),
+    _hotAssets(std::make_shared<HotAssetCache>(DEFAULT_HOT_ASSET_CACHE_MEGABYTES * BYTES_PER_MEGABYTE, MAX_HOT_ASSET_BYTES)),
+    _bakeFarm(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
 {
     BAKEABLE_TEXTURE_EXTENSIONS = image::getSupportedFormats();
@@ -304,11 +323,17 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+
+    connect(&_bakeFarm, &BakeFarm::bakeComplete, this, &AssetServer::handleCompletedBake);
+    connect(&_bakeFarm, &BakeFarm::bakeFailed, this, &AssetServer::handleFailedBake);
+    connect(&_bakeFarm, &BakeFarm::bakeAborted, this, &AssetServer::handleAbortedBake);
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation }, this, "queueRequests");
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetGetManifest,
+                                              PacketType::AssetUpload, PacketType::AssetUploadManifest,
+                                              PacketType::AssetUploadChunks, PacketType::AssetMappingOperation },
+                                            this, "queueRequests");
 
 #ifdef Q_OS_WIN
     updateConsumedCores();
@@ -329,25 +354,10 @@ void AssetServer::aboutToFinish() {
 
     // remove pending transfer tasks
     _transferTaskPool.clear();
+    _nodeSends.clear();
 
-    // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
-    auto it = _pendingBakes.begin();
-    while (it != _pendingBakes.end()) {
-        auto pendingRunnable =  _bakingTaskPool.tryTake(it->get());
-
-        if (pendingRunnable) {
-            it = _pendingBakes.erase(it);
-        } else {
-            qDebug() << "Aborting bake for" << it.key();
-            it.value()->abort();
-            ++it;
-        }
-    }
-
-    // make sure all bakers are finished or aborted
-    while (_pendingBakes.size() > 0) {
-        QCoreApplication::processEvents();
-    }
+    // drop the queued bakes and stop the ovens, this waits for them to go
+    _bakeFarm.abortAll();
 }
 
 void AssetServer::run() {
@@ -363,6 +373,7 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_MANIFESTS_SUBDIR = "manifests";
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -424,6 +435,27 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    _manifestsDirectory = _resourcesDirectory;
+    if (!_resourcesDirectory.mkpath(ASSET_MANIFESTS_SUBDIR) || !_manifestsDirectory.cd(ASSET_MANIFESTS_SUBDIR)) {
+        qCCritical(asset_server) << "Unable to create chunk manifest directory for asset-server files. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+    _storedChunks = std::make_shared<StoredChunkIndex>(_filesDirectory, _manifestsDirectory, _mappedAssets);
+
+    // set up the ovens before anything is queued for them
+    static const QString BAKE_WORKER_COUNT_OPTION = "bake_worker_count";
+    static const QString BAKE_TIMEOUT_OPTION = "bake_timeout";
+    static const QString BAKE_MEMORY_LIMIT_OPTION = "bake_memory_limit";
+    auto bakeWorkerCount = assetServerObject[BAKE_WORKER_COUNT_OPTION].toInt(DEFAULT_BAKE_WORKER_COUNT);
+    auto bakeTimeoutSecs = assetServerObject[BAKE_TIMEOUT_OPTION].toInt(DEFAULT_BAKE_TIMEOUT_SECS);
+    auto bakeMemoryLimitMegabytes = assetServerObject[BAKE_MEMORY_LIMIT_OPTION].toInt(DEFAULT_BAKE_MEMORY_LIMIT_MEGABYTES);
+    _bakeFarm.setWorkerCount(bakeWorkerCount);
+    _bakeFarm.setBakeTimeout(std::max(0, bakeTimeoutSecs) * (int)MSECS_PER_SECOND);
+    _bakeFarm.setMemoryLimit(std::max(0, bakeMemoryLimitMegabytes) * BYTES_PER_MEGABYTE);
+    _bakeFarm.setMaxAttempts(MAX_BAKE_ATTEMPTS);
+    qCInfo(asset_server) << "Baking with up to" << bakeWorkerCount << "ovens.";
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -436,12 +468,19 @@ void AssetServer::completeSetup() {
 
         qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
 
+        static const QString VERIFY_ASSET_FILES_OPTION = "verify_asset_files";
+        bool verifyAssetFiles = assetServerObject[VERIFY_ASSET_FILES_OPTION].toBool(false);
+
         if (_fileMappings.size() > 0) {
-            cleanupUnmappedFiles();
+            cleanupUnmappedFiles(verifyAssetFiles);
             cleanupBakedFilesForDeletedAssets();
         }
 
+        // after the cleanup, which drops the manifests of the files it removed
+        _storedChunks->load();
+
         nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
+        connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetServer::handleNodeKilled);
 
         bakeAssets();
     } else {
@@ -458,6 +497,12 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the in memory cache for hot assets
+    static const QString HOT_ASSET_CACHE_SIZE_OPTION = "hot_asset_cache_size";
+    auto hotAssetCacheMegabytes = assetServerObject[HOT_ASSET_CACHE_SIZE_OPTION].toInt(DEFAULT_HOT_ASSET_CACHE_MEGABYTES);
+    _hotAssets->setMaxBytes(std::max(0, hotAssetCacheMegabytes) * BYTES_PER_MEGABYTE);
+    qCInfo(asset_server) << "Keeping up to" << hotAssetCacheMegabytes << "MB of hot assets in memory.";
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -466,7 +511,11 @@ void AssetServer::completeSetup() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
     packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
-    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
+    packetReceiver.registerListener(PacketType::AssetGetManifest, this, "handleAssetGetManifest");
+    // uploads are delivered from their first packet so they can be hashed as they arrive
+    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload", true);
+    packetReceiver.registerListener(PacketType::AssetUploadManifest, this, "handleAssetUploadManifest");
+    packetReceiver.registerListener(PacketType::AssetUploadChunks, this, "handleAssetUploadChunks");
     packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
 
     replayRequests();
@@ -504,9 +553,18 @@ void AssetServer::replayRequests() {
             case PacketType::AssetGetInfo:
                 handleAssetGetInfo(request.first, request.second);
                 break;
+            case PacketType::AssetGetManifest:
+                handleAssetGetManifest(request.first, request.second);
+                break;
             case PacketType::AssetUpload:
                 handleAssetUpload(request.first, request.second);
                 break;
+            case PacketType::AssetUploadManifest:
+                handleAssetUploadManifest(request.first, request.second);
+                break;
+            case PacketType::AssetUploadChunks:
+                handleAssetUploadChunks(request.first, request.second);
+                break;
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
@@ -517,25 +575,73 @@ void AssetServer::replayRequests() {
     }
 }
 
-void AssetServer::cleanupUnmappedFiles() {
+void AssetServer::forgetAssetFile(const AssetUtils::AssetHash& hash) {
+    auto filePath = _filesDirectory.filePath(hash);
+    _mappedAssets->evict(filePath);
+    _hotAssets->evict(filePath);
+    _assetFileSizes.remove(hash);
+    QFile::remove(_manifestsDirectory.filePath(hash));
+}
+
+// Hashes the given asset files on a pool of worker threads and returns the ones whose contents don't match their name
+static QStringList findCorruptAssetFiles(const QDir& filesDirectory, const QStringList& hashes) {
+    // hashing is mostly waiting on the disk, so a few more workers than cores keeps it busy
+    static const int MAX_VERIFY_THREADS = 8;
+    int threadCount = std::max(1, std::min({ (int)std::thread::hardware_concurrency(), MAX_VERIFY_THREADS, hashes.size() }));
+
+    std::atomic<int> nextIndex { 0 };
+    std::vector<char> corrupt(hashes.size(), false);
+
+    auto verifyFiles = [&] {
+        int index;
+        while ((index = nextIndex++) < hashes.size()) {
+            QByteArray hash;
+            if (AssetUtils::hashFile(filesDirectory.filePath(hashes[index]), hash)) {
+                corrupt[index] = hash.toHex() != hashes[index].toLower().toLatin1();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(verifyFiles);
+    }
+    verifyFiles();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    QStringList corruptHashes;
+    for (int i = 0; i < hashes.size(); ++i) {
+        if (corrupt[i]) {
+            corruptHashes << hashes[i];
+        }
+    }
+    return corruptHashes;
+}
+
+void AssetServer::cleanupUnmappedFiles(bool verifyMappedFiles) {
     QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
 
     auto files = _filesDirectory.entryInfoList(QDir::Files);
 
     qCInfo(asset_server) << "Performing unmapped asset cleanup.";
 
+    QSet<AssetUtils::AssetHash> mappedHashes;
+    for (auto& pair : _fileMappings) {
+        mappedHashes.insert(pair.second);
+    }
+
+    QStringList mappedFiles;
+
     for (const auto& fileInfo : files) {
         auto filename = fileInfo.fileName();
         if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
+            if (mappedHashes.contains(filename)) {
+                mappedFiles << filename;
+            } else {
                 // remove the unmapped file
+                forgetAssetFile(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -548,6 +654,25 @@ void AssetServer::cleanupUnmappedFiles() {
             }
         }
     }
+
+    // manifests are worked out again when they're asked for, so any left behind by a crash can just go
+    for (const auto& filename : _manifestsDirectory.entryList(QDir::Files)) {
+        if (!mappedHashes.contains(filename)) {
+            _manifestsDirectory.remove(filename);
+        }
+    }
+
+    if (verifyMappedFiles && !mappedFiles.isEmpty()) {
+        qCInfo(asset_server) << "Verifying" << mappedFiles.size() << "mapped asset files.";
+
+        auto corruptFiles = findCorruptAssetFiles(_filesDirectory, mappedFiles);
+        for (const auto& filename : corruptFiles) {
+            // clients will refuse it, but leave it be, an upload of the original asset replaces it
+            qCWarning(asset_server) << "\tAsset file" << filename << "does not match its hash, it needs to be uploaded again.";
+        }
+
+        qCInfo(asset_server) << "Asset verification found" << corruptFiles.size() << "corrupt files.";
+    }
 }
 
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
@@ -695,6 +820,11 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                     maybeBake(assetPath, originalAssetHash);
                 }
             }
+
+            // someone wants this asset now, if it is waiting to be baked it goes before the ones nobody asked for
+            if (!bakingDisabled) {
+                _bakeFarm.prioritize(originalAssetHash);
+            }
         }
     } else {
         replyPacket.writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -842,10 +972,25 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->write(assetHash);
 
     QString fileName = QString(hexHash);
+
+    // everyone arriving at once asks about the same assets, only go to the disk the first time
+    auto sizeIt = _assetFileSizes.find(fileName);
+    if (sizeIt != _assetFileSizes.end()) {
+        ++_assetInfoHits;
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacket->writePrimitive(sizeIt.value());
+
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->sendPacket(std::move(replyPacket), *senderNode);
+        return;
+    }
+    ++_assetInfoMisses;
+
     QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
 
     if (fileInfo.exists() && fileInfo.isReadable()) {
         qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+        _assetFileSizes.insert(fileName, fileInfo.size());
         replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
         replyPacket->writePrimitive(fileInfo.size());
     } else {
@@ -866,11 +1011,162 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
         return;
     }
 
-    // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    queueSendAssetTask(message, senderNode);
+}
+
+void AssetServer::handleAssetGetManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto minSize = qint64(sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH);
+
+    if (message->getSize() < minSize) {
+        qCDebug(asset_server) << "ERROR bad manifest request";
+        return;
+    }
+
+    auto task = new SendAssetManifestTask(message, senderNode, _filesDirectory, _manifestsDirectory, _mappedAssets,
+                                          _storedChunks);
     _transferTaskPool.start(task);
 }
 
+void AssetServer::startUploadAssetTask(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode, QByteArray hash) {
+    if (message->failed()) {
+        return;
+    }
+
+    qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
+
+    auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _storedChunks, hash);
+    _transferTaskPool.start(task);
+}
+
+void AssetServer::handleAssetUploadManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+    auto hash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+    uint64_t fileSize { 0 };
+    message->readPrimitive(&fileSize);
+
+    // a big asset has a lot of chunks, the list of the ones we need can take more than one packet
+    auto replyPacketList = NLPacketList::create(PacketType::AssetUploadManifestReply, QByteArray(), true, true);
+    replyPacketList->writePrimitive(messageID);
+
+    AssetChunking::Manifest manifest;
+    if (senderNode && !senderNode->getCanWriteToAssetServer()) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    } else if (fileSize > _filesizeLimit) {
+        // before the client sends any of it
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else if (hash.size() != AssetUtils::SHA256_HASH_LENGTH ||
+               !AssetChunking::deserializeManifest(message->readAll(), manifest) ||
+               AssetChunking::getAssetSize(manifest) != (qint64)fileSize) {
+        qCDebug(asset_server) << "ERROR bad upload manifest";
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else {
+        // the chunks we don't have anywhere, each asked for once, none at all if we have the whole asset already
+        std::vector<uint32_t> missingChunks;
+        if (!QFile::exists(_filesDirectory.filePath(hash.toHex()))) {
+            QSet<QByteArray> requestedChunks;
+            for (uint32_t i = 0; i < manifest.size(); ++i) {
+                const auto& chunkHash = manifest[i].hash;
+                if (!requestedChunks.contains(chunkHash) && !_storedChunks->hasChunk(chunkHash)) {
+                    requestedChunks.insert(chunkHash);
+                    missingChunks.push_back(i);
+                }
+            }
+        }
+
+        qCDebug(asset_server) << "Chunked upload of" << hash.toHex() << "needs" << missingChunks.size() << "of"
+                              << manifest.size() << "chunks";
+
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacketList->writePrimitive((uint32_t)missingChunks.size());
+        for (auto index : missingChunks) {
+            replyPacketList->writePrimitive(index);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), message->getSenderSockAddr());
+    }
+}
+
+void AssetServer::handleAssetUploadChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (!senderNode || senderNode->getCanWriteToAssetServer()) {
+        qCDebug(asset_server) << "Starting an UploadChunkedAssetTask for upload from" << message->getSourceID();
+
+        auto task = new UploadChunkedAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _storedChunks);
+        _transferTaskPool.start(task);
+        return;
+    }
+
+    // the same answer a whole upload from this node gets
+    auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    permissionErrorPacket->writePrimitive(messageID);
+    permissionErrorPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacket(std::move(permissionErrorPacket), *senderNode);
+    } else {
+        nodeList->sendPacket(std::move(permissionErrorPacket), message->getSenderSockAddr());
+    }
+}
+
+void AssetServer::queueSendAssetTask(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    QUuid nodeID = senderNode ? senderNode->getUUID() : QUuid();
+    auto& sends = _nodeSends[nodeID];
+
+    if (sends.running >= MAX_CONCURRENT_SENDS_PER_NODE) {
+        // this node already has its share of the transfer pool, don't let a big download starve everyone else
+        sends.queued.enqueue({ message, senderNode });
+        return;
+    }
+
+    startSendAssetTask(nodeID, message, senderNode);
+}
+
+void AssetServer::startSendAssetTask(const QUuid& nodeID, QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    ++_nodeSends[nodeID].running;
+
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _mappedAssets, _hotAssets);
+    task->setFinishedCallback([this, nodeID] {
+        QMetaObject::invokeMethod(this, "sendAssetTaskFinished", Q_ARG(QUuid, nodeID));
+    });
+    _transferTaskPool.start(task);
+}
+
+void AssetServer::sendAssetTaskFinished(QUuid nodeID) {
+    auto it = _nodeSends.find(nodeID);
+    if (it == _nodeSends.end()) {
+        return;
+    }
+
+    --it->running;
+    if (!it->queued.isEmpty()) {
+        auto next = it->queued.dequeue();
+        startSendAssetTask(nodeID, next.first, next.second);
+    } else if (it->running <= 0) {
+        _nodeSends.erase(it);
+    }
+}
+
+void AssetServer::handleNodeKilled(SharedNodePointer node) {
+    // nobody is left to receive what the node had waiting, the sends already running clean up after themselves
+    auto it = _nodeSends.find(node->getUUID());
+    if (it != _nodeSends.end()) {
+        it->queued.clear();
+        if (it->running <= 0) {
+            _nodeSends.erase(it);
+        }
+    }
+}
+
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     bool canWriteToAssetServer = true;
     if (senderNode) {
@@ -879,10 +1175,34 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
 
 
     if (canWriteToAssetServer) {
-        qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
+        if (message->isComplete()) {
+            startUploadAssetTask(message, senderNode, QByteArray());
+            return;
+        }
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
-        _transferTaskPool.start(task);
+        // hash the file data on the receiving thread as the packets come in, rather than all at once when they're done
+        auto hasher = std::make_shared<UploadAssetHasher>(_filesizeLimit);
+        ReceivedMessage* rawMessage = message.data();
+        QWeakPointer<ReceivedMessage> weakMessage = message;
+
+        connect(rawMessage, &ReceivedMessage::progress, this, [hasher, rawMessage](qint64 size) {
+            hasher->update(*rawMessage);
+        }, Qt::DirectConnection);
+
+        connect(rawMessage, &ReceivedMessage::completed, this, [this, hasher, weakMessage, senderNode] {
+            auto message = weakMessage.toStrongRef();
+            if (message && hasher->claim()) {
+                hasher->update(*message);
+                QMetaObject::invokeMethod(this, "startUploadAssetTask", Q_ARG(QSharedPointer<ReceivedMessage>, message),
+                                          Q_ARG(SharedNodePointer, senderNode), Q_ARG(QByteArray, hasher->result()));
+            }
+        }, Qt::DirectConnection);
+
+        // the rest of it may have arrived before we got here
+        if (message->isComplete() && hasher->claim()) {
+            hasher->update(*message);
+            startUploadAssetTask(message, senderNode, hasher->result());
+        }
     } else {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
@@ -957,6 +1277,32 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    QJsonObject transferStats;
+    transferStats["1. Hot Assets"] = _hotAssets->getStats();
+
+    auto mappedStats = _mappedAssets->getStats();
+    QJsonObject mappedAssetStats;
+    mappedAssetStats["1. hits"] = (double)mappedStats.hits;
+    mappedAssetStats["2. misses"] = (double)mappedStats.misses;
+    mappedAssetStats["3. evictions"] = (double)mappedStats.evictions;
+    mappedAssetStats["4. openMappings"] = mappedStats.openMappings;
+    mappedAssetStats["5. mappedBytes"] = (double)mappedStats.mappedBytes;
+    transferStats["2. Mapped Assets"] = mappedAssetStats;
+
+    QJsonObject assetInfoStats;
+    assetInfoStats["1. hits"] = (double)_assetInfoHits;
+    assetInfoStats["2. misses"] = (double)_assetInfoMisses;
+    assetInfoStats["3. knownSizes"] = _assetFileSizes.size();
+    transferStats["3. Asset Info"] = assetInfoStats;
+
+    int queuedSends = 0;
+    for (const auto& sends : _nodeSends) {
+        queuedSends += sends.queued.size();
+    }
+    transferStats["4. Queued Sends"] = queuedSends;
+    serverStats["Transfers"] = transferStats;
+    serverStats["Baking"] = _bakeFarm.getStats();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1170,6 +1516,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            forgetAssetFile(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -1308,8 +1655,6 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
     meta.bakeVersion = currentTypeVersion;
 
     writeMetaFile(originalAssetHash, meta);
-
-    _pendingBakes.remove(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1331,8 +1676,6 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
         }
 
         writeMetaFile(originalAssetHash, meta);
-
-        _pendingBakes.remove(originalAssetHash);
     };
 
     bool errorCompletingBake { false };
@@ -1464,8 +1807,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath) {
     qDebug() << "Aborted bake:" << originalAssetHash;
 
-    // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
-    _pendingBakes.remove(originalAssetHash);
+    // for an aborted bake there is nothing to record, it is baked again next time around
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
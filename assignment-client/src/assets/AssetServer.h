@@ -12,13 +12,17 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <memory>
+
 #include <QtCore/QDir>
+#include <QtCore/QQueue>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
+#include "BakeFarm.h"
 #include "ReceivedMessage.h"
 
 #include "RegisteredMetaTypes.h"
@@ -68,7 +72,9 @@ struct AssetMeta {
     QString redirectTarget;
 };
 
-class BakeAssetTask;
+class HotAssetCache;
+class MappedAssetCache;
+class StoredChunkIndex;
 
 class AssetServer : public ThreadedAssignment {
     Q_OBJECT
@@ -86,14 +92,25 @@ private slots:
     void queueRequests(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
+    void handleAssetGetManifest(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetUploadManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void sendStatsPacket() override;
 
+    void startUploadAssetTask(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode, QByteArray hash);
+    void sendAssetTaskFinished(QUuid nodeID);
+    void handleNodeKilled(SharedNodePointer node);
+
 private:
     void replayRequests();
 
+    /// Starts a SendAssetTask for the request, or queues it if the node already has its share of the transfer pool
+    void queueSendAssetTask(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void startSendAssetTask(const QUuid& nodeID, QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleGetAllMappingOperation(NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
@@ -119,8 +136,11 @@ private:
 
     bool setBakingEnabled(const AssetUtils::AssetPathList& paths, bool enabled);
 
-    /// Delete any unmapped files from the local asset directory
-    void cleanupUnmappedFiles();
+    /// Drop whatever we cached about an asset file, call before removing it
+    void forgetAssetFile(const AssetUtils::AssetHash& hash);
+
+    /// Delete any unmapped files from the local asset directory, optionally checking the mapped ones against their hash
+    void cleanupUnmappedFiles(bool verifyMappedFiles = false);
 
     /// Delete any baked files for assets removed from the local asset directory
     void cleanupBakedFilesForDeletedAssets();
@@ -152,12 +172,33 @@ private:
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+    /// Chunk manifests of the asset files that have been uploaded or asked for, named after the asset hash
+    QDir _manifestsDirectory;
+    /// Where the chunks in those manifests are, so uploads can skip the ones we already have
+    std::shared_ptr<StoredChunkIndex> _storedChunks;
 
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
-    QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
-    QThreadPool _bakingTaskPool;
+    /// Open mappings of recently sent asset files, shared by the SendAssetTasks
+    std::shared_ptr<MappedAssetCache> _mappedAssets;
+    /// Bytes of the assets being asked for over and over, shared by the SendAssetTasks
+    std::shared_ptr<HotAssetCache> _hotAssets;
+
+    // sizes of the asset files we've been asked about, asset files never change once written
+    QHash<AssetUtils::AssetHash, qint64> _assetFileSizes;
+    quint64 _assetInfoHits { 0 };
+    quint64 _assetInfoMisses { 0 };
+
+    // downloads running on the transfer pool and waiting for it, per node, only touched from the assignment thread
+    struct NodeSends {
+        int running { 0 };
+        QQueue<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>> queued;
+    };
+    QHash<QUuid, NodeSends> _nodeSends;
+
+    /// Oven processes baking assets in the background, and the queue of assets waiting for them
+    BakeFarm _bakeFarm;
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
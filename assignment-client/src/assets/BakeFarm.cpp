@@ -0,0 +1,294 @@
+//
+//  BakeFarm.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeFarm.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <OvenWorker.h>
+#include <PathUtils.h>
+
+#include "AssetServerLogging.h"
+
+// bakes that nobody has asked for yet, in the order they were queued
+static const qint64 BACKGROUND_BAKE_PRIORITY = 0;
+
+// an oven process is replaced after this many bakes, so whatever it leaks or fragments doesn't build up forever
+static const int MAX_BAKES_PER_OVEN_PROCESS = 50;
+
+BakeFarm::BakeFarm(QObject* parent) : QObject(parent) {
+}
+
+bool BakeFarm::queueBake(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath,
+                         const QString& filePath) {
+    if (_jobs.contains(assetHash)) {
+        return false;
+    }
+
+    Job job;
+    job.hash = assetHash;
+    job.path = assetPath;
+    job.filePath = filePath;
+    job.key.priority = BACKGROUND_BAKE_PRIORITY;
+    job.queuedTimer.start();
+    enqueue(job);
+    _jobs.insert(assetHash, job);
+
+    startBakes();
+    return true;
+}
+
+void BakeFarm::enqueue(Job& job) {
+    job.key.sequence = _nextSequence++;
+    _queue.emplace(job.key, job.hash);
+}
+
+void BakeFarm::prioritize(const AssetUtils::AssetHash& assetHash) {
+    auto it = _jobs.find(assetHash);
+    if (it == _jobs.end() || it->worker) {
+        return;
+    }
+
+    // the most recent request goes first, the one before it second, and so on
+    _queue.erase(it->key);
+    it->key.priority = _nextPriority++;
+    enqueue(*it);
+}
+
+bool BakeFarm::isQueued(const AssetUtils::AssetHash& assetHash) const {
+    auto it = _jobs.find(assetHash);
+    return it != _jobs.end() && !it->worker;
+}
+
+bool BakeFarm::isBaking(const AssetUtils::AssetHash& assetHash) const {
+    auto it = _jobs.find(assetHash);
+    return it != _jobs.end() && it->worker;
+}
+
+OvenWorker* BakeFarm::getIdleWorker() {
+    for (auto worker : _workers) {
+        if (!worker->isBaking()) {
+            return worker;
+        }
+    }
+
+    if ((int)_workers.size() >= _workerCount) {
+        return nullptr;
+    }
+
+    OvenWorker::Options options;
+    options.ovenPath = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir().absoluteFilePath("oven");
+    options.memoryLimit = _memoryLimit;
+    // bakes are background work, keep the ovens from competing with the asset server for the CPU
+    options.lowPriority = true;
+    options.maxBakesPerProcess = MAX_BAKES_PER_OVEN_PROCESS;
+
+    auto worker = new OvenWorker(options, this);
+    connect(worker, &OvenWorker::bakeFinished, this, [this, worker](int statusCode, QJsonObject details) {
+        handleBakeFinished(worker, statusCode, details["fromCache"].toBool());
+    });
+    connect(worker, &OvenWorker::bakeCrashed, this, [this, worker](QString reason, bool timedOut) {
+        handleBakeCrashed(worker, reason, timedOut);
+    });
+    _workers.push_back(worker);
+    return worker;
+}
+
+void BakeFarm::startBakes() {
+    while (!_queue.empty()) {
+        auto worker = getIdleWorker();
+        if (!worker) {
+            return;
+        }
+
+        auto hash = _queue.begin()->second;
+        _queue.erase(_queue.begin());
+        auto& job = _jobs[hash];
+
+        QString errors;
+        if (!startBake(job, worker, errors)) {
+            auto path = job.path;
+            _jobs.remove(hash);
+            ++_failed;
+            emit bakeFailed(hash, path, errors);
+        }
+    }
+}
+
+bool BakeFarm::startBake(Job& job, OvenWorker* worker, QString& errors) {
+    // Make new temporary directories for the asset and the Oven's output. The output directory has to start out empty
+    // for the oven to fetch the bake from, or keep it in, its bake cache.
+    QString tempInputDir = PathUtils::generateTemporaryDir();
+    QString tempOutputDir = PathUtils::generateTemporaryDir();
+    if (!tempOutputDir.isEmpty() && tempOutputDir == tempInputDir) {
+        // both were named in the same clock tick
+        tempOutputDir = PathUtils::generateTemporaryDir();
+    }
+    if (tempInputDir.isEmpty() || tempOutputDir.isEmpty()) {
+        errors = "Could not create temporary working directory";
+        PathUtils::deleteMyTemporaryDir(QDir(tempInputDir).dirName());
+        PathUtils::deleteMyTemporaryDir(QDir(tempOutputDir).dirName());
+        return false;
+    }
+
+    // Copy file to bake the temporary dir and give a name the oven can work with
+    auto assetName = job.path.split("/").last();
+    auto tempAssetPath = tempInputDir + "/" + assetName;
+    if (!QFile::copy(job.filePath, tempAssetPath)) {
+        errors = "Couldn't copy file to bake to temporary directory";
+        PathUtils::deleteMyTemporaryDir(QDir(tempInputDir).dirName());
+        PathUtils::deleteMyTemporaryDir(QDir(tempOutputDir).dirName());
+        return false;
+    }
+
+    if (job.attempts == 0) {
+        _totalQueueMsecs += job.queuedTimer.elapsed();
+        ++_bakesStarted;
+    }
+    ++job.attempts;
+    job.worker = worker;
+    job.tempInputDir = tempInputDir;
+    job.tempOutputDir = tempOutputDir;
+    job.bakeTimer.start();
+    _baking.insert(worker, job.hash);
+
+    QString extension = job.path.mid(job.path.lastIndexOf('.') + 1);
+    qCDebug(asset_server) << "Baking" << job.path << "attempt" << job.attempts;
+    QJsonObject bakeJob;
+    bakeJob["input"] = tempAssetPath;
+    bakeJob["output"] = tempOutputDir;
+    bakeJob["type"] = extension;
+    // the copy is gone after the bake, so the oven caches it under the content hash instead of the file
+    bakeJob["contentHash"] = job.hash;
+    worker->bake(bakeJob, _bakeTimeoutMsecs);
+    return true;
+}
+
+BakeFarm::Job BakeFarm::takeJob(OvenWorker* worker) {
+    auto hash = _baking.take(worker);
+    auto job = _jobs.take(hash);
+    job.worker = nullptr;
+    PathUtils::deleteMyTemporaryDir(QDir(job.tempInputDir).dirName());
+    job.tempInputDir.clear();
+    return job;
+}
+
+void BakeFarm::recordBake(const Job& job) {
+    auto elapsed = (quint64)job.bakeTimer.elapsed();
+    _totalBakeMsecs += elapsed;
+    _maxBakeMsecs = std::max(_maxBakeMsecs, elapsed);
+    ++_bakesTimed;
+}
+
+void BakeFarm::handleBakeFinished(OvenWorker* worker, int statusCode, bool fromCache) {
+    if (!_baking.contains(worker)) {
+        return;
+    }
+
+    auto job = takeJob(worker);
+    auto tempOutputDirName = QDir(job.tempOutputDir).dirName();
+
+    if (statusCode == OVEN_STATUS_CODE_SUCCESS) {
+        recordBake(job);
+        ++_completed;
+        if (fromCache) {
+            ++_fromCache;
+        }
+        emit bakeComplete(job.hash, job.path, job.tempOutputDir);
+    } else if (statusCode == OVEN_STATUS_CODE_ABORT) {
+        PathUtils::deleteMyTemporaryDir(tempOutputDirName);
+        emit bakeAborted(job.hash, job.path);
+    } else {
+        QString errors;
+        if (statusCode == OVEN_STATUS_CODE_FAIL) {
+            QFile errorFile { QDir(job.tempOutputDir).absoluteFilePath(OVEN_ERROR_FILENAME) };
+            if (errorFile.open(QIODevice::ReadOnly)) {
+                errors = errorFile.readAll();
+            }
+        }
+        if (errors.isEmpty()) {
+            errors = "Unknown error occurred while baking";
+        }
+        PathUtils::deleteMyTemporaryDir(tempOutputDirName);
+        recordBake(job);
+        ++_failed;
+        emit bakeFailed(job.hash, job.path, errors);
+    }
+
+    startBakes();
+}
+
+void BakeFarm::handleBakeCrashed(OvenWorker* worker, QString reason, bool timedOut) {
+    if (!_baking.contains(worker)) {
+        return;
+    }
+
+    auto job = takeJob(worker);
+    PathUtils::deleteMyTemporaryDir(QDir(job.tempOutputDir).dirName());
+
+    if (timedOut) {
+        ++_timedOut;
+    } else {
+        ++_crashed;
+    }
+
+    if (job.attempts < _maxAttempts) {
+        // crashes can come from running out of memory next to other bakes, or from the state an earlier bake left
+        // the process in, so it gets another go on a new oven
+        qCWarning(asset_server) << "Retrying bake of" << job.path << "-" << reason;
+        ++_retried;
+        enqueue(job);
+        _jobs.insert(job.hash, job);
+    } else {
+        recordBake(job);
+        ++_failed;
+        emit bakeFailed(job.hash, job.path, reason + " (" + QString::number(job.attempts) + " attempts)");
+    }
+
+    startBakes();
+}
+
+void BakeFarm::abortAll() {
+    for (const auto& hash : _queue) {
+        _jobs.remove(hash.second);
+    }
+    _queue.clear();
+
+    for (auto worker : _workers) {
+        worker->abort();
+    }
+}
+
+QJsonObject BakeFarm::getStats() const {
+    QJsonObject durationStats;
+    durationStats["1. averageBakeMs"] = _bakesTimed > 0 ? (double)(_totalBakeMsecs / _bakesTimed) : 0.0;
+    durationStats["2. maxBakeMs"] = (double)_maxBakeMsecs;
+    durationStats["3. averageQueueMs"] = _bakesStarted > 0 ? (double)(_totalQueueMsecs / _bakesStarted) : 0.0;
+
+    QJsonObject crashStats;
+    crashStats["1. crashed"] = (double)_crashed;
+    crashStats["2. timedOut"] = (double)_timedOut;
+
+    QJsonObject statsObject;
+    statsObject["1. queued"] = (int)_queue.size();
+    statsObject["2. baking"] = _baking.size();
+    statsObject["3. workers"] = (int)_workers.size();
+    statsObject["4. completed"] = (double)_completed;
+    // completed bakes whose output the oven found in its bake cache
+    statsObject["5. fromCache"] = (double)_fromCache;
+    statsObject["6. failed"] = (double)_failed;
+    statsObject["7. retried"] = (double)_retried;
+    statsObject["8. Crashes"] = crashStats;
+    statsObject["9. Durations"] = durationStats;
+    return statsObject;
+}
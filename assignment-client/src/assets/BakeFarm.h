@@ -0,0 +1,124 @@
+//
+//  BakeFarm.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeFarm_h
+#define hifi_BakeFarm_h
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+#include <AssetUtils.h>
+
+class OvenWorker;
+
+/// Schedules the asset server's bakes over a pool of oven worker processes. Bakes wait in a queue where the assets
+/// someone has most recently asked for go first, a bake whose oven crashes or times out is retried on a fresh process,
+/// and a crash only ever takes down the one bake it happened in.
+class BakeFarm : public QObject {
+    Q_OBJECT
+public:
+    BakeFarm(QObject* parent = nullptr);
+
+    /// Set before the first bake, ovens that are already running keep the settings they were started with
+    void setWorkerCount(int workerCount) { _workerCount = std::max(1, workerCount); }
+    void setBakeTimeout(int timeoutMsecs) { _bakeTimeoutMsecs = timeoutMsecs; }
+    void setMemoryLimit(qint64 memoryLimit) { _memoryLimit = memoryLimit; }
+    void setMaxAttempts(int maxAttempts) { _maxAttempts = std::max(1, maxAttempts); }
+
+    /// Queues a bake of the asset, returns false if it is queued or baking already
+    bool queueBake(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+
+    /// Moves a queued bake ahead of everything that was asked for less recently, call when a client wants the asset
+    void prioritize(const AssetUtils::AssetHash& assetHash);
+
+    bool isQueued(const AssetUtils::AssetHash& assetHash) const;
+    bool isBaking(const AssetUtils::AssetHash& assetHash) const;
+
+    /// Drops the queued bakes and kills the ovens, the running bakes are reported as aborted before this returns
+    void abortAll();
+
+    QJsonObject getStats() const;
+
+signals:
+    void bakeComplete(QString assetHash, QString assetPath, QString tempOutputDir);
+    void bakeFailed(QString assetHash, QString assetPath, QString errors);
+    void bakeAborted(QString assetHash, QString assetPath);
+
+private:
+    struct QueueKey {
+        qint64 priority;
+        quint64 sequence;
+
+        // higher priority first, then first come first served
+        bool operator<(const QueueKey& other) const {
+            return priority != other.priority ? priority > other.priority : sequence < other.sequence;
+        }
+    };
+
+    struct Job {
+        AssetUtils::AssetHash hash;
+        AssetUtils::AssetPath path;
+        QString filePath;
+        QueueKey key;
+        int attempts { 0 };
+        OvenWorker* worker { nullptr };
+        QString tempInputDir;
+        QString tempOutputDir;
+        QElapsedTimer queuedTimer;
+        QElapsedTimer bakeTimer;
+    };
+
+    void enqueue(Job& job);
+    void startBakes();
+    /// Copies the asset to a working directory for the oven and hands it to the worker, false if that didn't work out.
+    /// The oven keeps the bake in its bake cache under the asset's hash.
+    bool startBake(Job& job, OvenWorker* worker, QString& errors);
+    OvenWorker* getIdleWorker();
+
+    void handleBakeFinished(OvenWorker* worker, int statusCode, bool fromCache);
+    void handleBakeCrashed(OvenWorker* worker, QString reason, bool timedOut);
+    /// Removes the job of a finished bake and its copy of the asset, returning it
+    Job takeJob(OvenWorker* worker);
+    void recordBake(const Job& job);
+
+    int _workerCount { 1 };
+    int _bakeTimeoutMsecs { 0 };
+    qint64 _memoryLimit { 0 };
+    int _maxAttempts { 1 };
+
+    std::vector<OvenWorker*> _workers;
+
+    // every job, queued or baking
+    QHash<AssetUtils::AssetHash, Job> _jobs;
+    std::map<QueueKey, AssetUtils::AssetHash> _queue;
+    QHash<OvenWorker*, AssetUtils::AssetHash> _baking;
+    quint64 _nextSequence { 0 };
+    qint64 _nextPriority { 1 };
+
+    quint64 _completed { 0 };
+    quint64 _fromCache { 0 };
+    quint64 _failed { 0 };
+    quint64 _retried { 0 };
+    quint64 _crashed { 0 };
+    quint64 _timedOut { 0 };
+    quint64 _totalBakeMsecs { 0 };
+    quint64 _maxBakeMsecs { 0 };
+    quint64 _totalQueueMsecs { 0 };
+    quint64 _bakesStarted { 0 };
+    quint64 _bakesTimed { 0 };
+};
+
+#endif // hifi_BakeFarm_h
@@ -0,0 +1,178 @@
+//
+//  HotAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HotAssetCache.h"
+
+#include <algorithm>
+
+#include <QtCore/QFile>
+
+#include "AssetServerLogging.h"
+
+// an asset becomes hot on its second request, one-off fetches never displace anything
+static const int REQUESTS_TO_BECOME_HOT = 2;
+// bound on the assets we remember a first request for
+static const int MAX_TRACKED_REQUEST_COUNTS = 8192;
+
+HotAssetCache::HotAssetCache(qint64 maxBytes, qint64 maxAssetBytes) :
+    _maxBytes(maxBytes),
+    _maxAssetBytes(maxAssetBytes)
+{
+}
+
+void HotAssetCache::setMaxBytes(qint64 maxBytes) {
+    QMutexLocker locker(&_lock);
+    _maxBytes = std::max((qint64)0, maxBytes);
+    evictToFit();
+}
+
+bool HotAssetCache::get(const QString& filePath, QByteArray& data) {
+    std::promise<QByteArray> loaded;
+    qint64 maxSize;
+    {
+        QMutexLocker locker(&_lock);
+
+        auto it = _entriesByPath.find(filePath);
+        if (it != _entriesByPath.end()) {
+            // move it to the front of the LRU
+            _entries.splice(_entries.begin(), _entries, it.value());
+            ++_hits;
+            data = _entries.front().second;
+            return true;
+        }
+
+        auto loadingIt = _loading.find(filePath);
+        if (loadingIt != _loading.end()) {
+            // someone is reading it already, wait for them rather than reading it again
+            auto loading = loadingIt.value();
+            ++_coalesced;
+            locker.unlock();
+
+            data = loading.get();
+            return !data.isNull();
+        }
+
+        ++_misses;
+        if (_maxBytes <= 0) {
+            return false;
+        }
+
+        if (_requestCounts.size() >= MAX_TRACKED_REQUEST_COUNTS) {
+            _requestCounts.clear();
+        }
+        if (++_requestCounts[filePath] < REQUESTS_TO_BECOME_HOT) {
+            return false;
+        }
+        _requestCounts.remove(filePath);
+        _loading.insert(filePath, loaded.get_future().share());
+        maxSize = std::min(_maxAssetBytes, _maxBytes);
+    }
+
+    QByteArray loadedData;
+    bool success = load(filePath, maxSize, loadedData);
+    if (!success) {
+        loadedData = QByteArray();
+    }
+    loaded.set_value(loadedData);
+
+    QMutexLocker locker(&_lock);
+    _loading.remove(filePath);
+    if (success) {
+        insert(filePath, loadedData);
+        data = loadedData;
+    }
+    return success;
+}
+
+bool HotAssetCache::load(const QString& filePath, qint64 maxSize, QByteArray& data) {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    auto size = file.size();
+    if (size == 0 || size > maxSize) {
+        // not worth keeping, or too big to keep
+        return false;
+    }
+
+    data = file.readAll();
+    if (data.size() != size) {
+        qCWarning(asset_server) << "Failed to read" << filePath << "into the hot asset cache -" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void HotAssetCache::insert(const QString& filePath, const QByteArray& data) {
+    if (_entriesByPath.contains(filePath)) {
+        return;
+    }
+
+    _entries.emplace_front(filePath, data);
+    _entriesByPath.insert(filePath, _entries.begin());
+    _cachedBytes += data.size();
+    evictToFit();
+}
+
+void HotAssetCache::evictToFit() {
+    while (_cachedBytes > _maxBytes && !_entries.empty()) {
+        auto& entry = _entries.back();
+        _entriesByPath.remove(entry.first);
+        _cachedBytes -= entry.second.size();
+        ++_evictions;
+        _entries.pop_back();
+    }
+}
+
+void HotAssetCache::evict(const QString& filePath) {
+    QMutexLocker locker(&_lock);
+    _requestCounts.remove(filePath);
+
+    auto it = _entriesByPath.find(filePath);
+    if (it != _entriesByPath.end()) {
+        _cachedBytes -= it.value()->second.size();
+        _entries.erase(it.value());
+        _entriesByPath.erase(it);
+    }
+}
+
+void HotAssetCache::clear() {
+    QMutexLocker locker(&_lock);
+    _entries.clear();
+    _entriesByPath.clear();
+    _requestCounts.clear();
+    _cachedBytes = 0;
+}
+
+void HotAssetCache::recordBytesServed(qint64 bytes, bool fromCache) {
+    QMutexLocker locker(&_lock);
+    if (fromCache) {
+        _bytesServedFromCache += bytes;
+    } else {
+        _bytesServedFromDisk += bytes;
+    }
+}
+
+QJsonObject HotAssetCache::getStats() const {
+    QMutexLocker locker(&_lock);
+
+    QJsonObject statsObject;
+    statsObject["1. hits"] = (double)_hits;
+    statsObject["2. misses"] = (double)_misses;
+    statsObject["3. coalesced"] = (double)_coalesced;
+    statsObject["4. evictions"] = (double)_evictions;
+    statsObject["5. cachedAssets"] = (int)_entries.size();
+    statsObject["6. cachedBytes"] = (double)_cachedBytes;
+    statsObject["7. maxBytes"] = (double)_maxBytes;
+    statsObject["8. bytesServedFromCache"] = (double)_bytesServedFromCache;
+    statsObject["9. bytesServedFromDisk"] = (double)_bytesServedFromDisk;
+    return statsObject;
+}
@@ -0,0 +1,76 @@
+//
+//  HotAssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HotAssetCache_h
+#define hifi_HotAssetCache_h
+
+#include <future>
+#include <list>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+/// Bounded LRU of the bytes of assets that are being asked for repeatedly, e.g. the avatars and models everyone
+/// fetches when an event starts. An asset is loaded into memory on its second request; while it loads, any other
+/// SendAssetTask that wants it waits for that one read instead of going to disk itself.
+class HotAssetCache {
+public:
+    HotAssetCache(qint64 maxBytes, qint64 maxAssetBytes);
+
+    void setMaxBytes(qint64 maxBytes);
+
+    /// Fills data with the bytes of the asset at filePath and returns true if the asset is, or just became, hot. The
+    /// file is read at most once however many tasks ask for it at the same time. Returns false when the caller should
+    /// serve the asset from disk itself.
+    bool get(const QString& filePath, QByteArray& data);
+
+    /// Drops everything known about an asset. Call when its file is removed.
+    void evict(const QString& filePath);
+    void clear();
+
+    /// Counts bytes sent out by the transfer tasks, split by whether they came from memory.
+    void recordBytesServed(qint64 bytes, bool fromCache);
+
+    QJsonObject getStats() const;
+
+private:
+    using Entry = std::pair<QString, QByteArray>;
+    using EntryList = std::list<Entry>;
+
+    static bool load(const QString& filePath, qint64 maxSize, QByteArray& data);
+    void insert(const QString& filePath, const QByteArray& data);
+    void evictToFit();
+
+    qint64 _maxBytes;
+    const qint64 _maxAssetBytes;
+
+    mutable QMutex _lock;
+    // most recently used first
+    EntryList _entries;
+    QHash<QString, EntryList::iterator> _entriesByPath;
+    qint64 _cachedBytes { 0 };
+
+    // assets that have been asked for once, the next request makes them hot
+    QHash<QString, int> _requestCounts;
+    // assets being read into memory right now, the tasks that want them wait on these
+    QHash<QString, std::shared_future<QByteArray>> _loading;
+
+    quint64 _hits { 0 };
+    quint64 _misses { 0 };
+    quint64 _coalesced { 0 };
+    quint64 _evictions { 0 };
+    quint64 _bytesServedFromCache { 0 };
+    quint64 _bytesServedFromDisk { 0 };
+};
+
+#endif // hifi_HotAssetCache_h
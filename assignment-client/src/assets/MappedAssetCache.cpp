@@ -0,0 +1,121 @@
+//
+//  MappedAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCache.h"
+
+#include "AssetServerLogging.h"
+
+MappedAsset::MappedAsset(const QString& filePath) : _file(filePath) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    _size = _file.size();
+    if (_size == 0) {
+        // there is nothing to map, but an empty asset is still a valid one
+        _isValid = true;
+        return;
+    }
+
+    _data = _file.map(0, _size);
+    _isValid = _data != nullptr;
+    if (!_isValid) {
+        qCWarning(asset_server) << "Failed to map" << filePath << "-" << _file.errorString();
+    }
+}
+
+MappedAsset::~MappedAsset() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+MappedAssetCache::MappedAssetCache(int maxMappings, qint64 maxMappedBytes) :
+    _maxMappings(maxMappings),
+    _maxMappedBytes(maxMappedBytes)
+{
+}
+
+MappedAssetPointer MappedAssetCache::map(const QString& filePath) {
+    {
+        QMutexLocker locker(&_lock);
+        auto it = _entriesByPath.find(filePath);
+        if (it != _entriesByPath.end()) {
+            // move it to the front of the LRU
+            _entries.splice(_entries.begin(), _entries, it.value());
+            ++_stats.hits;
+            return _entries.front().second;
+        }
+        ++_stats.misses;
+    }
+
+    // open and map outside the lock, a slow disk shouldn't hold up requests for assets we already have mapped
+    auto mapping = std::make_shared<const MappedAsset>(filePath);
+    if (!mapping->isValid()) {
+        return MappedAssetPointer();
+    }
+
+    if (mapping->getSize() > _maxMappedBytes) {
+        // too big to keep around, serve this request from it and let it go
+        return mapping;
+    }
+
+    QMutexLocker locker(&_lock);
+    auto it = _entriesByPath.find(filePath);
+    if (it != _entriesByPath.end()) {
+        // another task mapped it while we were, use theirs
+        _entries.splice(_entries.begin(), _entries, it.value());
+        return _entries.front().second;
+    }
+
+    _entries.emplace_front(filePath, mapping);
+    _entriesByPath.insert(filePath, _entries.begin());
+    ++_stats.openMappings;
+    _stats.mappedBytes += mapping->getSize();
+
+    while (_stats.openMappings > _maxMappings || _stats.mappedBytes > _maxMappedBytes) {
+        evictLeastRecentlyUsed();
+    }
+
+    return mapping;
+}
+
+void MappedAssetCache::evictLeastRecentlyUsed() {
+    auto& entry = _entries.back();
+    _entriesByPath.remove(entry.first);
+    --_stats.openMappings;
+    _stats.mappedBytes -= entry.second->getSize();
+    ++_stats.evictions;
+    _entries.pop_back();
+}
+
+void MappedAssetCache::evict(const QString& filePath) {
+    QMutexLocker locker(&_lock);
+    auto it = _entriesByPath.find(filePath);
+    if (it != _entriesByPath.end()) {
+        --_stats.openMappings;
+        _stats.mappedBytes -= it.value()->second->getSize();
+        _entries.erase(it.value());
+        _entriesByPath.erase(it);
+    }
+}
+
+void MappedAssetCache::clear() {
+    QMutexLocker locker(&_lock);
+    _entries.clear();
+    _entriesByPath.clear();
+    _stats.openMappings = 0;
+    _stats.mappedBytes = 0;
+}
+
+MappedAssetCache::Stats MappedAssetCache::getStats() const {
+    QMutexLocker locker(&_lock);
+    return _stats;
+}
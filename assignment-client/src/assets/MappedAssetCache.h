@@ -0,0 +1,82 @@
+//
+//  MappedAssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedAssetCache_h
+#define hifi_MappedAssetCache_h
+
+#include <list>
+#include <memory>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+/// A read-only memory mapping of an asset file. The mapping stays valid for as long as someone holds a pointer to it,
+/// even after it has been evicted from the cache.
+class MappedAsset {
+public:
+    MappedAsset(const QString& filePath);
+    ~MappedAsset();
+
+    bool isValid() const { return _isValid; }
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+using MappedAssetPointer = std::shared_ptr<const MappedAsset>;
+
+/// LRU of open asset file mappings shared by the SendAssetTasks, so hot assets are served straight from the page cache
+/// without re-opening the file or copying it into an intermediate buffer for every request.
+class MappedAssetCache {
+public:
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 evictions { 0 };
+        int openMappings { 0 };
+        qint64 mappedBytes { 0 };
+    };
+
+    MappedAssetCache(int maxMappings, qint64 maxMappedBytes);
+
+    /// Returns a mapping of the file at filePath, reusing the cached one if there is one. Returns nullptr if the file
+    /// could not be opened or mapped.
+    MappedAssetPointer map(const QString& filePath);
+
+    /// Drops the cached mapping for filePath. Call before removing the file.
+    void evict(const QString& filePath);
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    using Entry = std::pair<QString, MappedAssetPointer>;
+    using EntryList = std::list<Entry>;
+
+    void evictLeastRecentlyUsed();
+
+    const int _maxMappings;
+    const qint64 _maxMappedBytes;
+
+    mutable QMutex _lock;
+    // most recently used first
+    EntryList _entries;
+    QHash<QString, EntryList::iterator> _entriesByPath;
+    Stats _stats;
+};
+
+#endif // hifi_MappedAssetCache_h
@@ -0,0 +1,84 @@
+//
+//  SendAssetManifestTask.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendAssetManifestTask.h"
+
+#include <QtCore/QFile>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+#include <DependencyManager.h>
+#include <NLPacketList.h>
+#include <NodeList.h>
+
+#include "AssetServerLogging.h"
+
+SendAssetManifestTask::SendAssetManifestTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                                             const QDir& filesDirectory, const QDir& manifestsDirectory,
+                                             std::shared_ptr<MappedAssetCache> mappedAssets,
+                                             std::shared_ptr<StoredChunkIndex> storedChunks) :
+    QRunnable(),
+    _message(message),
+    _senderNode(sendToNode),
+    _filesDirectory(filesDirectory),
+    _manifestsDirectory(manifestsDirectory),
+    _mappedAssets(mappedAssets),
+    _storedChunks(storedChunks)
+{
+}
+
+void SendAssetManifestTask::run() {
+    MessageID messageID;
+    _message->readPrimitive(&messageID);
+    QString hexHash = _message->read(AssetUtils::SHA256_HASH_LENGTH).toHex();
+
+    // a big asset has a lot of chunks, its manifest takes more than one packet
+    auto replyPacketList = NLPacketList::create(PacketType::AssetGetManifestReply, QByteArray(), true, true);
+    replyPacketList->writePrimitive(messageID);
+
+    QByteArray manifest;
+    if (loadManifest(hexHash, manifest)) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacketList->write(manifest);
+    } else {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
+}
+
+bool SendAssetManifestTask::loadManifest(const QString& hexHash, QByteArray& manifest) {
+    auto manifestPath = _manifestsDirectory.filePath(hexHash);
+
+    QFile manifestFile { manifestPath };
+    if (manifestFile.open(QIODevice::ReadOnly)) {
+        manifest = manifestFile.readAll();
+        AssetChunking::Manifest parsed;
+        if (AssetChunking::deserializeManifest(manifest, parsed)) {
+            return true;
+        }
+        qCWarning(asset_server) << "Replacing the damaged chunk manifest of" << hexHash;
+        manifestFile.remove();
+    }
+
+    // first time anyone asked for it, chunk it straight out of a mapping of the file
+    auto mapping = _mappedAssets->map(_filesDirectory.filePath(hexHash));
+    if (!mapping) {
+        return false;
+    }
+
+    auto chunks = AssetChunking::createManifest(mapping->getData(), mapping->getSize());
+    manifest = AssetChunking::serializeManifest(chunks);
+
+    // keeps it for next time, and lets uploads of other versions of the asset skip the chunks they share with it
+    _storedChunks->addManifest(hexHash, chunks);
+    return true;
+}
@@ -0,0 +1,48 @@
+//
+//  SendAssetManifestTask.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendAssetManifestTask_h
+#define hifi_SendAssetManifestTask_h
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include "MappedAssetCache.h"
+#include "Node.h"
+#include "ReceivedMessage.h"
+#include "StoredChunkIndex.h"
+
+/// Replies with the manifest of content-defined chunks of an asset, so the client can skip the chunks it already has.
+/// Manifests are worked out when an asset is uploaded or first asked for, and kept next to the asset files.
+class SendAssetManifestTask : public QRunnable {
+public:
+    SendAssetManifestTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                          const QDir& filesDirectory, const QDir& manifestsDirectory,
+                          std::shared_ptr<MappedAssetCache> mappedAssets, std::shared_ptr<StoredChunkIndex> storedChunks);
+
+    void run() override;
+
+private:
+    /// Fills manifest with the serialized manifest of the asset, returns false if there is no such asset
+    bool loadManifest(const QString& hexHash, QByteArray& manifest);
+
+    QSharedPointer<ReceivedMessage> _message;
+    SharedNodePointer _senderNode;
+    QDir _filesDirectory;
+    QDir _manifestsDirectory;
+    std::shared_ptr<MappedAssetCache> _mappedAssets;
+    std::shared_ptr<StoredChunkIndex> _storedChunks;
+};
+
+#endif // hifi_SendAssetManifestTask_h
@@ -26,11 +26,14 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             std::shared_ptr<MappedAssetCache> mappedAssets, std::shared_ptr<HotAssetCache> hotAssets) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _mappedAssets(mappedAssets),
+    _hotAssets(hotAssets)
 {
     
 }
@@ -63,58 +66,112 @@ void SendAssetTask::run() {
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        writeAsset(hexHash, byteRange, *replyPacketList);
+    }
 
-        if (file.open(QIODevice::ReadOnly)) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+    }
 
-            // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+    if (_finishedCallback) {
+        _finishedCallback();
+    }
+}
 
-            // check if we're being asked to read data that we just don't have
-            // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
-                replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
-                qCDebug(networking) << "Bad byte range: " << hexHash << " "
-                    << byteRange.fromInclusive << ":" << byteRange.toExclusive;
-            } else {
-                // we have a valid byte range, handle it and send the asset
-                auto size = byteRange.size();
+void SendAssetTask::writeAsset(const QString& hexHash, ByteRange byteRange, NLPacketList& replyPacketList) {
+    QString filePath = _resourcesDir.filePath(hexHash);
 
-                if (byteRange.fromInclusive >= 0) {
+    // assets everyone is asking for are served from memory, and only read from disk once however many want them
+    QByteArray hotData;
+    if (_hotAssets && _hotAssets->get(filePath, hotData)) {
+        auto bytesWritten = writeRange(hotData.constData(), hotData.size(), hexHash, byteRange, replyPacketList);
+        _hotAssets->recordBytesServed(bytesWritten, true);
+        return;
+    }
 
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
+    // otherwise serve from a mapping of the file when we can, the packet list then copies straight out of the page cache
+    auto mapping = _mappedAssets ? _mappedAssets->map(filePath) : MappedAssetPointer();
+    if (mapping) {
+        auto bytesWritten = writeRange(mapping->getData(), mapping->getSize(), hexHash, byteRange, replyPacketList);
+        if (_hotAssets) {
+            _hotAssets->recordBytesServed(bytesWritten, false);
+        }
+        return;
+    }
 
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+    QFile file { filePath };
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+    if (file.open(QIODevice::ReadOnly)) {
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+        // first fixup the range based on the now known file size
+        byteRange.fixupRange(file.size());
 
-                qCDebug(networking) << "Sending asset: " << hexHash;
-            }
-            file.close();
+        // check if we're being asked to read data that we just don't have
+        // because of the file size
+        if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            replyPacketList.writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+            qCDebug(networking) << "Bad byte range: " << hexHash << " "
+                << byteRange.fromInclusive << ":" << byteRange.toExclusive;
         } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
-            replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+            // we have a valid byte range, handle it and send the asset
+            auto size = byteRange.size();
+
+            if (byteRange.fromInclusive >= 0) {
+
+                // this range is positive, meaning we just need to seek into the file and then read from there
+                file.seek(byteRange.fromInclusive);
+                replyPacketList.writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList.writePrimitive(size);
+                replyPacketList.write(file.read(size));
+            } else {
+                // this range is negative, at least the first part of the read will be back into the end of the file
+
+                // seek to the part of the file where the negative range begins
+                file.seek(file.size() + byteRange.fromInclusive);
+
+                replyPacketList.writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList.writePrimitive(size);
+
+                // first write everything from the negative range to the end of the file
+                replyPacketList.write(file.read(size));
+            }
+
+            qCDebug(networking) << "Sending asset: " << hexHash;
+            if (_hotAssets) {
+                _hotAssets->recordBytesServed(size, false);
+            }
         }
+        file.close();
+    } else {
+        qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
+        replyPacketList.writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
     }
+}
 
-    auto nodeList = DependencyManager::get<NodeList>();
-    if (_senderNode) {
-        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
-    } else {
-        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+qint64 SendAssetTask::writeRange(const char* data, qint64 fileSize, const QString& hexHash, ByteRange byteRange,
+                                 NLPacketList& replyPacketList) {
+    byteRange.fixupRange(fileSize);
+
+    if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
+        replyPacketList.writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+        qCDebug(networking) << "Bad byte range: " << hexHash << " "
+            << byteRange.fromInclusive << ":" << byteRange.toExclusive;
+        return 0;
     }
+
+    auto size = byteRange.size();
+    // a negative range starts that far back from the end of the file
+    auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
+
+    replyPacketList.writePrimitive(AssetUtils::AssetServerError::NoError);
+    replyPacketList.writePrimitive(size);
+    if (size > 0) {
+        replyPacketList.write(data + offset, size);
+    }
+
+    qCDebug(networking) << "Sending asset: " << hexHash;
+    return size;
 }
@@ -12,27 +12,48 @@
 #ifndef hifi_SendAssetTask_h
 #define hifi_SendAssetTask_h
 
+#include <functional>
+
 #include <QtCore/QByteArray>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
 #include <QtCore/QRunnable>
 
 #include "AssetUtils.h"
+#include "ByteRange.h"
 #include "AssetServer.h"
+#include "HotAssetCache.h"
+#include "MappedAssetCache.h"
 #include "Node.h"
 
 class NLPacket;
+class NLPacketList;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    using FinishedCallback = std::function<void()>;
+
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  std::shared_ptr<MappedAssetCache> mappedAssets = std::shared_ptr<MappedAssetCache>(),
+                  std::shared_ptr<HotAssetCache> hotAssets = std::shared_ptr<HotAssetCache>());
+
+    /// Called on the pool thread once the reply has been handed to the node list
+    void setFinishedCallback(FinishedCallback callback) { _finishedCallback = callback; }
 
     void run() override;
 
 private:
+    void writeAsset(const QString& hexHash, ByteRange byteRange, NLPacketList& replyPacketList);
+    /// Writes the requested range of an asset that is already in memory. Returns the number of asset bytes written.
+    qint64 writeRange(const char* data, qint64 fileSize, const QString& hexHash, ByteRange byteRange,
+                      NLPacketList& replyPacketList);
+
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    std::shared_ptr<MappedAssetCache> _mappedAssets;
+    std::shared_ptr<HotAssetCache> _hotAssets;
+    FinishedCallback _finishedCallback;
 };
 
 #endif
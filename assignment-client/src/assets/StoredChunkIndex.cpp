@@ -0,0 +1,101 @@
+//
+//  StoredChunkIndex.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StoredChunkIndex.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QRegExp>
+#include <QtCore/QSaveFile>
+
+#include <Sha256Hasher.h>
+
+#include "AssetServerLogging.h"
+
+StoredChunkIndex::StoredChunkIndex(const QDir& filesDirectory, const QDir& manifestsDirectory,
+                                   std::shared_ptr<MappedAssetCache> mappedAssets) :
+    _filesDirectory(filesDirectory),
+    _manifestsDirectory(manifestsDirectory),
+    _mappedAssets(mappedAssets)
+{
+}
+
+void StoredChunkIndex::load() {
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+
+    int indexedAssets = 0;
+    for (const auto& filename : _manifestsDirectory.entryList(QDir::Files)) {
+        if (!hashFileRegex.exactMatch(filename)) {
+            continue;
+        }
+
+        QFile manifestFile { _manifestsDirectory.filePath(filename) };
+        AssetChunking::Manifest manifest;
+        if (!manifestFile.open(QIODevice::ReadOnly) || !AssetChunking::deserializeManifest(manifestFile.readAll(), manifest)) {
+            // the next download of the asset replaces it
+            continue;
+        }
+
+        QMutexLocker lock { &_indexMutex };
+        _index.addManifest(filename, manifest);
+        ++indexedAssets;
+    }
+
+    qCInfo(asset_server) << "Indexed the chunks of" << indexedAssets << "asset files.";
+}
+
+void StoredChunkIndex::addManifest(const AssetUtils::AssetHash& assetHash, const AssetChunking::Manifest& manifest) {
+    auto manifestPath = _manifestsDirectory.filePath(assetHash);
+    if (!QFile::exists(manifestPath)) {
+        // whoever gets here first for an asset writes it, the contents are the same either way
+        auto serializedManifest = AssetChunking::serializeManifest(manifest);
+        QSaveFile saveFile { manifestPath };
+        if (!saveFile.open(QIODevice::WriteOnly) || saveFile.write(serializedManifest) != serializedManifest.size() ||
+            !saveFile.commit()) {
+            qCWarning(asset_server) << "Could not save the chunk manifest of" << assetHash;
+        }
+    }
+
+    QMutexLocker lock { &_indexMutex };
+    _index.addManifest(assetHash, manifest);
+}
+
+bool StoredChunkIndex::hasChunk(const QByteArray& chunkHash) const {
+    QMutexLocker lock { &_indexMutex };
+    AssetChunkIndex::Location location;
+    return _index.find(chunkHash, location);
+}
+
+bool StoredChunkIndex::readChunk(const QByteArray& chunkHash, qint64 size, QByteArray& data) const {
+    AssetChunkIndex::Location location;
+    {
+        QMutexLocker lock { &_indexMutex };
+        if (!_index.find(chunkHash, location)) {
+            return false;
+        }
+    }
+
+    if (location.size != size) {
+        return false;
+    }
+
+    auto mapping = _mappedAssets->map(_filesDirectory.filePath(location.assetHash));
+    if (!mapping || location.offset + size > mapping->getSize()) {
+        return false;
+    }
+
+    // don't hand out whatever a damaged asset file has there now
+    auto chunkData = mapping->getData() + location.offset;
+    if (Sha256Hasher::hash(chunkData, size) != chunkHash) {
+        return false;
+    }
+
+    data.append(chunkData, (int)size);
+    return true;
+}
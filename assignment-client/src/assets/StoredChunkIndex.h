@@ -0,0 +1,55 @@
+//
+//  StoredChunkIndex.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StoredChunkIndex_h
+#define hifi_StoredChunkIndex_h
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QMutex>
+
+#include <AssetChunkIndex.h>
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+
+#include "MappedAssetCache.h"
+
+/// Where the chunks of the asset files on this server can be found, so an upload of a new version of an asset only has
+/// to carry the chunks the server doesn't already hold in another one. Built from the chunk manifests kept next to the
+/// asset files, which covers the assets uploaded or downloaded since the manifests started being kept. Entries can
+/// outlive the asset files they point at, readChunk checks what they lead to. Safe to use from any thread.
+class StoredChunkIndex {
+public:
+    StoredChunkIndex(const QDir& filesDirectory, const QDir& manifestsDirectory,
+                     std::shared_ptr<MappedAssetCache> mappedAssets);
+
+    /// Indexes the manifests already saved in the manifests directory
+    void load();
+
+    /// Saves the manifest of an asset file next to it, unless it already is, and indexes its chunks
+    void addManifest(const AssetUtils::AssetHash& assetHash, const AssetChunking::Manifest& manifest);
+
+    bool hasChunk(const QByteArray& chunkHash) const;
+
+    /// Appends the chunk to data from whichever asset file has it, returns false if none of them still does
+    bool readChunk(const QByteArray& chunkHash, qint64 size, QByteArray& data) const;
+
+private:
+    QDir _filesDirectory;
+    QDir _manifestsDirectory;
+    std::shared_ptr<MappedAssetCache> _mappedAssets;
+
+    mutable QMutex _indexMutex;
+    AssetChunkIndex _index;
+};
+
+#endif // hifi_StoredChunkIndex_h
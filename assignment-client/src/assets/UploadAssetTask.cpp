@@ -11,21 +11,61 @@
 
 #include "UploadAssetTask.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QFile>
 
+#include <AssetChunking.h>
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
 
 #include "ClientServerUtils.h"
+#include "StoredChunkIndex.h"
+
+// the message ID and file size come ahead of the file data
+static const qint64 UPLOAD_HEADER_SIZE = sizeof(MessageID) + sizeof(uint64_t);
+
+void UploadAssetHasher::update(const ReceivedMessage& message) {
+    auto size = message.getSize();
+    if (!_hasFileSize) {
+        if (size < UPLOAD_HEADER_SIZE) {
+            return;
+        }
+        memcpy(&_fileSize, message.getRawMessage() + sizeof(MessageID), sizeof(_fileSize));
+        _hasFileSize = true;
+    }
+
+    if (_fileSize > _filesizeLimit) {
+        // this upload is going to be refused, don't bother
+        return;
+    }
+
+    uint64_t received = std::min((uint64_t)(size - UPLOAD_HEADER_SIZE), _fileSize);
+    if (received > _hashedBytes) {
+        _hasher.addData(message.getRawMessage() + UPLOAD_HEADER_SIZE + _hashedBytes, received - _hashedBytes);
+        _hashedBytes = received;
+    }
+}
+
+QByteArray UploadAssetHasher::result() {
+    if (!_hasFileSize || _fileSize > _filesizeLimit || _hashedBytes != _fileSize) {
+        return QByteArray();
+    }
+    return _hasher.result();
+}
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit,
+                                 std::shared_ptr<StoredChunkIndex> storedChunks, const QByteArray& hash) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _storedChunks(storedChunks),
+    _hash(hash)
 {
     
 }
@@ -51,13 +91,22 @@ void UploadAssetTask::run() {
     auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
     replyPacket->writePrimitive(messageID);
     
+    auto error = AssetUtils::AssetServerError::NoError;
+    QByteArray hexHash;
+
     if (fileSize > _filesizeLimit) {
-        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+        error = AssetUtils::AssetServerError::AssetTooLarge;
+        replyPacket->writePrimitive(error);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
-        auto hexHash = hash.toHex();
+        // refer to the file data where it sits in the message, a multi-hundred MB upload shouldn't be copied around
+        qint64 availableFileSize = std::min((qint64)fileSize, std::max((qint64)0, data.size() - UPLOAD_HEADER_SIZE));
+        const char* fileData = data.constData() + UPLOAD_HEADER_SIZE;
+
+        auto hash = _hash;
+        if (hash.isEmpty()) {
+            hash = Sha256Hasher::hash(fileData, availableFileSize);
+        }
+        hexHash = hash.toHex();
 
         if (_senderNode) {
             qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
@@ -65,47 +114,17 @@ void UploadAssetTask::run() {
             qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
         }
         
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
-
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
-
-                existingCorrectFile = true;
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
-            }
+        if (availableFileSize == (qint64)fileSize) {
+            error = writeFile(_resourcesDir, hash, fileData, availableFileSize);
+        } else {
+            qWarning() << "Upload of" << hexHash << "is missing" << (qint64)fileSize - availableFileSize << "bytes - upload failed.";
+            error = AssetUtils::AssetServerError::FileOperationFailed;
         }
 
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
-                qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
-                
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
-            }
+        replyPacket->writePrimitive(error);
+        if (error == AssetUtils::AssetServerError::NoError) {
+            replyPacket->write(hash);
         }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
@@ -114,4 +133,47 @@ void UploadAssetTask::run() {
     } else {
         nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
     }
+
+    // once the uploader has its answer, so later uploads of other versions of this asset can skip what it shares with them
+    if (error == AssetUtils::AssetServerError::NoError && _storedChunks) {
+        _storedChunks->addManifest(QString(hexHash), AssetChunking::createManifest(data.constData() + UPLOAD_HEADER_SIZE, fileSize));
+    }
+}
+
+bool UploadAssetTask::hasVerifiedFile(const QDir& resourcesDir, const QByteArray& hash) {
+    auto filePath = resourcesDir.filePath(QString(hash.toHex()));
+    QByteArray existingHash;
+    return QFile::exists(filePath) && AssetUtils::hashFile(filePath, existingHash) && existingHash == hash;
+}
+
+AssetUtils::AssetServerError UploadAssetTask::writeFile(const QDir& resourcesDir, const QByteArray& hash,
+                                                        const char* data, qint64 size) {
+    auto hexHash = hash.toHex();
+    QFile file { resourcesDir.filePath(QString(hexHash)) };
+
+    if (file.exists()) {
+        // check if the local file has the correct contents, otherwise we overwrite
+        if (hasVerifiedFile(resourcesDir, hash)) {
+            qDebug() << "Not overwriting existing verified file: " << hexHash;
+            return AssetUtils::AssetServerError::NoError;
+        }
+        qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+    }
+
+    if (file.open(QIODevice::WriteOnly) && file.write(data, size) == size) {
+        qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+        file.close();
+        return AssetUtils::AssetServerError::NoError;
+    }
+
+    qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+
+    // upload has failed - remove the file and return an error
+    auto removed = file.remove();
+
+    if (!removed) {
+        qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+    }
+
+    return AssetUtils::AssetServerError::FileOperationFailed;
 }
@@ -14,28 +14,70 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <atomic>
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include <Sha256Hasher.h>
+
+#include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
 class NLPacketList;
+class StoredChunkIndex;
 class Node;
 
+/// Hashes the file data of an upload as its packets arrive, so the hash is ready as soon as the last one is in.
+class UploadAssetHasher {
+public:
+    UploadAssetHasher(uint64_t filesizeLimit) : _filesizeLimit(filesizeLimit) {}
+
+    /// Hashes whatever file data has arrived since the last call. Must be called on the thread appending to the
+    /// message, or once the message is complete.
+    void update(const ReceivedMessage& message);
+
+    /// Only the first caller gets to finish the upload
+    bool claim() { return !_claimed.exchange(true); }
+
+    /// The hash of the complete file, or an empty array if it wasn't all hashed
+    QByteArray result();
+
+private:
+    Sha256Hasher _hasher;
+    uint64_t _filesizeLimit;
+    uint64_t _fileSize { 0 };
+    bool _hasFileSize { false };
+    uint64_t _hashedBytes { 0 };
+    std::atomic<bool> _claimed { false };
+};
+
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, std::shared_ptr<StoredChunkIndex> storedChunks,
+                    const QByteArray& hash = QByteArray());
 
     void run() override;
 
+    /// Returns true if there is an asset file with that hash that has the right contents
+    static bool hasVerifiedFile(const QDir& resourcesDir, const QByteArray& hash);
+
+    /// Writes the asset file for data of the given hash, unless there already is a verified one
+    static AssetUtils::AssetServerError writeFile(const QDir& resourcesDir, const QByteArray& hash,
+                                                  const char* data, qint64 size);
+
 private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    std::shared_ptr<StoredChunkIndex> _storedChunks;
+    // computed while the upload arrived, if it was
+    QByteArray _hash;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -0,0 +1,151 @@
+//
+//  UploadChunkedAssetTask.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadChunkedAssetTask.h"
+
+#include <QtCore/QHash>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <Sha256Hasher.h>
+
+#include "AssetServerLogging.h"
+#include "ClientServerUtils.h"
+#include "UploadAssetTask.h"
+
+UploadChunkedAssetTask::UploadChunkedAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& senderNode,
+                                               const QDir& resourcesDir, uint64_t filesizeLimit,
+                                               std::shared_ptr<StoredChunkIndex> storedChunks) :
+    QRunnable(),
+    _receivedMessage(message),
+    _senderNode(senderNode),
+    _resourcesDir(resourcesDir),
+    _filesizeLimit(filesizeLimit),
+    _storedChunks(storedChunks)
+{
+}
+
+// Puts the asset together from the chunks in the message and the ones we already have, in the order of the manifest.
+// Returns false if the message is malformed, a chunk in it isn't what the manifest says, or a chunk that was left out
+// isn't anywhere anymore.
+static bool assembleAsset(ReceivedMessage& message, const AssetChunking::Manifest& manifest,
+                          const StoredChunkIndex& storedChunks, QByteArray& data) {
+    uint32_t sentCount;
+    if (message.readPrimitive(&sentCount) != sizeof(sentCount) || sentCount > manifest.size() ||
+        message.getBytesLeftToRead() < (qint64)(sentCount * sizeof(uint32_t))) {
+        return false;
+    }
+
+    std::vector<uint32_t> sentIndices(sentCount);
+    message.read(reinterpret_cast<char*>(sentIndices.data()), sentCount * sizeof(uint32_t));
+
+    // the chunks this asset repeats are only sent once, the copies come from earlier in the asset
+    QHash<QByteArray, qint64> assembledChunks;
+    auto nextSent = sentIndices.cbegin();
+
+    for (uint32_t i = 0; i < manifest.size(); ++i) {
+        const auto& chunk = manifest[i];
+
+        if (nextSent != sentIndices.cend() && *nextSent == i) {
+            ++nextSent;
+            if (message.getBytesLeftToRead() < chunk.size) {
+                return false;
+            }
+            auto chunkData = message.getRawMessage() + message.getPosition();
+            message.seek(message.getPosition() + chunk.size);
+            if (Sha256Hasher::hash(chunkData, chunk.size) != chunk.hash) {
+                return false;
+            }
+            data.append(chunkData, (int)chunk.size);
+        } else if (assembledChunks.contains(chunk.hash)) {
+            data.append(data.mid(assembledChunks[chunk.hash], chunk.size));
+        } else if (!storedChunks.readChunk(chunk.hash, chunk.size, data)) {
+            qCDebug(asset_server) << "Chunk" << chunk.hash.toHex() << "of a chunked upload is not here anymore";
+            return false;
+        }
+
+        assembledChunks.insert(chunk.hash, chunk.offset);
+    }
+
+    // the sent indices have to be in order and all used up, and all of the chunk data read
+    return nextSent == sentIndices.cend() && message.getBytesLeftToRead() == 0;
+}
+
+void UploadChunkedAssetTask::run() {
+    MessageID messageID;
+    _receivedMessage->readPrimitive(&messageID);
+
+    auto hash = _receivedMessage->read(AssetUtils::SHA256_HASH_LENGTH);
+    auto hexHash = QString(hash.toHex());
+
+    uint64_t fileSize;
+    _receivedMessage->readPrimitive(&fileSize);
+
+    uint32_t manifestSize;
+    _receivedMessage->readPrimitive(&manifestSize);
+
+    AssetChunking::Manifest manifest;
+    bool validManifest = _receivedMessage->getBytesLeftToRead() >= manifestSize &&
+        AssetChunking::deserializeManifest(_receivedMessage->read(manifestSize), manifest) &&
+        AssetChunking::getAssetSize(manifest) == (qint64)fileSize;
+
+    if (_senderNode) {
+        qDebug() << "UploadChunkedAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+    } else {
+        qDebug() << "UploadChunkedAssetTask reading a file of " << fileSize << "bytes from" << _receivedMessage->getSenderSockAddr();
+    }
+
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
+    replyPacket->writePrimitive(messageID);
+
+    auto error = AssetUtils::AssetServerError::NoError;
+    bool assembled = false;
+
+    if (fileSize > _filesizeLimit) {
+        error = AssetUtils::AssetServerError::AssetTooLarge;
+    } else if (hash.size() != AssetUtils::SHA256_HASH_LENGTH || !validManifest) {
+        error = AssetUtils::AssetServerError::FileOperationFailed;
+    } else if (UploadAssetTask::hasVerifiedFile(_resourcesDir, hash)) {
+        qDebug() << "Not overwriting existing verified file: " << hexHash;
+    } else {
+        QByteArray data;
+        data.reserve((int)fileSize);
+
+        if (!assembleAsset(*_receivedMessage, manifest, *_storedChunks, data)) {
+            qWarning() << "Could not put together the chunked upload of" << hexHash << " - upload failed.";
+            error = AssetUtils::AssetServerError::FileOperationFailed;
+        } else if (Sha256Hasher::hash(data.constData(), data.size()) != hash) {
+            qWarning() << "Chunked upload of" << hexHash << "does not match its hash - upload failed.";
+            error = AssetUtils::AssetServerError::FileOperationFailed;
+        } else {
+            assembled = true;
+            error = UploadAssetTask::writeFile(_resourcesDir, hash, data.constData(), data.size());
+        }
+    }
+
+    replyPacket->writePrimitive(error);
+    if (error == AssetUtils::AssetServerError::NoError) {
+        replyPacket->write(hash);
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+    } else {
+        nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
+    }
+
+    // every chunk in the manifest was checked against its hash on the way in
+    if (assembled && error == AssetUtils::AssetServerError::NoError) {
+        _storedChunks->addManifest(hexHash, manifest);
+    }
+}
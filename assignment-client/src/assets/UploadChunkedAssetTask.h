@@ -0,0 +1,43 @@
+//
+//  UploadChunkedAssetTask.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UploadChunkedAssetTask_h
+#define hifi_UploadChunkedAssetTask_h
+
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include "Node.h"
+#include "ReceivedMessage.h"
+#include "StoredChunkIndex.h"
+
+/// Puts together an asset uploaded as its manifest and the chunks of it the server didn't have, taking the rest from
+/// the asset files that have them, and stores it like any other upload. Replies with FileOperationFailed if one of the
+/// chunks the client left out can't be found anymore, the client sends the whole asset then.
+class UploadChunkedAssetTask : public QRunnable {
+public:
+    UploadChunkedAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& senderNode,
+                           const QDir& resourcesDir, uint64_t filesizeLimit,
+                           std::shared_ptr<StoredChunkIndex> storedChunks);
+
+    void run() override;
+
+private:
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    SharedNodePointer _senderNode;
+    QDir _resourcesDir;
+    uint64_t _filesizeLimit;
+    std::shared_ptr<StoredChunkIndex> _storedChunks;
+};
+
+#endif // hifi_UploadChunkedAssetTask_h
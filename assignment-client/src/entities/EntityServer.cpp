@@ -11,6 +11,8 @@
 
 #include "EntityServer.h"
 
+#include <limits>
+
 #include <QtCore/QEventLoop>
 #include <QTimer>
 #include <QJsonArray>
@@ -59,6 +61,7 @@ EntityServer::EntityServer(ReceivedMessage& message) :
         PacketType::ChallengeOwnershipReply },
         this,
         "handleEntityPacket");
+    packetReceiver.registerListener(PacketType::EntityCacheManifest, this, "handleEntityCacheManifest");
 
     connect(&_dynamicDomainVerificationTimer, &QTimer::timeout, this, &EntityServer::startDynamicDomainVerification);
     _dynamicDomainVerificationTimer.setSingleShot(true);
@@ -88,6 +91,30 @@ void EntityServer::handleEntityPacket(QSharedPointer<ReceivedMessage> message, S
     }
 }
 
+void EntityServer::handleEntityCacheManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    EntityNodeData* nodeData = static_cast<EntityNodeData*>(senderNode->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    QUuid resumeToken = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    quint32 numEntities { 0 };
+    message->readPrimitive(&numEntities);
+
+    const qint64 BYTES_PER_ENTITY = NUM_BYTES_RFC4122_UUID + sizeof(quint64);
+    QHash<QUuid, quint64> versions;
+    versions.reserve((int)std::min((qint64)numEntities, message->getBytesLeftToRead() / BYTES_PER_ENTITY));
+    for (quint32 i = 0; i < numEntities && message->getBytesLeftToRead() >= BYTES_PER_ENTITY; ++i) {
+        QUuid entityID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        quint64 lastEdited { 0 };
+        message->readPrimitive(&lastEdited);
+        versions.insert(entityID, lastEdited);
+    }
+
+    // the node's send thread picks these up once it is serving the query they were sent alongside
+    nodeData->setCachedEntityVersions(resumeToken, std::move(versions));
+}
+
 std::unique_ptr<OctreeQueryNode> EntityServer::createOctreeQueryNode() {
     return std::unique_ptr<OctreeQueryNode> { new EntityNodeData() };
 }
@@ -136,7 +163,7 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
     if (nodeData) {
         quint64 deletedEntitiesSentAt = nodeData->getLastDeletedEntitiesSentAt();
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
-        shouldSendDeletedEntities = tree->hasEntitiesDeletedSince(deletedEntitiesSentAt);
+        shouldSendDeletedEntities = tree->hasEntitiesDeletedSince(deletedEntitiesSentAt) || nodeData->hasStaleCachedEntities();
 
         #ifdef EXTRA_ERASE_DEBUGGING
             if (shouldSendDeletedEntities) {
@@ -188,69 +215,72 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
         qint64 numberOfIDsPos = deletesPacket->pos();
         deletesPacket->writePrimitive(numberOfIDs);
 
-        // we keep a multi map of entity IDs to timestamps, we only want to include the entity IDs that have been
-        // deleted since we last sent to this node
-        auto it = recentlyDeleted.constBegin();
-        while (it != recentlyDeleted.constEnd()) {
+        auto appendEntityID = [&](const QUuid& entityID) {
+            // check to make sure we have room for one more ID, if we don't have more
+            // room, then send out this packet and create another one
+            if (NUM_BYTES_RFC4122_UUID > deletesPacket->bytesAvailableForWrite()) {
 
-            // if the timestamp is more recent then out last sent time, include it
-            if (it.key() > considerEntitiesSince) {
+                // replace the count for the number of included IDs
+                deletesPacket->seek(numberOfIDsPos);
+                deletesPacket->writePrimitive(numberOfIDs);
 
-                // get all the IDs for this timestamp
-                const auto& entityIDsFromTime = recentlyDeleted.values(it.key());
+                // Send the current packet
+                queryNode->packetSent(*deletesPacket);
+                auto thisPacketSize = deletesPacket->getDataSize();
+                totalBytes += thisPacketSize;
+                packetsSent++;
+                DependencyManager::get<NodeList>()->sendPacket(std::move(deletesPacket), *node);
 
-                for (const auto& entityID : entityIDsFromTime) {
+                #ifdef EXTRA_ERASE_DEBUGGING
+                    qDebug() << "EntityServer::sendSpecialPackets() sending packet packetsSent[" << packetsSent << "] size:" << thisPacketSize;
+                #endif
 
-                    // check to make sure we have room for one more ID, if we don't have more
-                    // room, then send out this packet and create another one
-                    if (NUM_BYTES_RFC4122_UUID > deletesPacket->bytesAvailableForWrite()) {
 
-                        // replace the count for the number of included IDs
-                        deletesPacket->seek(numberOfIDsPos);
-                        deletesPacket->writePrimitive(numberOfIDs);
+                // create another packet
+                deletesPacket = NLPacket::create(PacketType::EntityErase);
 
-                        // Send the current packet
-                        queryNode->packetSent(*deletesPacket);
-                        auto thisPacketSize = deletesPacket->getDataSize();
-                        totalBytes += thisPacketSize;
-                        packetsSent++;
-                        DependencyManager::get<NodeList>()->sendPacket(std::move(deletesPacket), *node);
+                // pack in flags
+                deletesPacket->writePrimitive(flags);
 
-                        #ifdef EXTRA_ERASE_DEBUGGING
-                            qDebug() << "EntityServer::sendSpecialPackets() sending packet packetsSent[" << packetsSent << "] size:" << thisPacketSize;
-                        #endif
+                // pack in sequence number
+                sequenceNumber = queryNode->getSequenceNumber();
+                deletesPacket->writePrimitive(sequenceNumber);
 
+                // pack in timestamp
+                deletesPacket->writePrimitive(now);
 
-                        // create another packet
-                        deletesPacket = NLPacket::create(PacketType::EntityErase);
+                // figure out where we are now and pack a temporary number of IDs
+                numberOfIDs = 0;
+                numberOfIDsPos = deletesPacket->pos();
+                deletesPacket->writePrimitive(numberOfIDs);
+            }
 
-                        // pack in flags
-                        deletesPacket->writePrimitive(flags);
+            // FIXME - we still seem to see cases where incorrect EntityIDs get sent from the server
+            // to the client. These were causing "lost" entities like flashlights and laser pointers
+            // now that we keep around some additional history of the erased entities and resend that
+            // history for a longer time window, these entities are not "lost". But we haven't yet
+            // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
+            deletesPacket->write(entityID.toRfc4122());
+            ++numberOfIDs;
 
-                        // pack in sequence number
-                        sequenceNumber = queryNode->getSequenceNumber();
-                        deletesPacket->writePrimitive(sequenceNumber);
+            #ifdef EXTRA_ERASE_DEBUGGING
+                qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
+            #endif
+        };
 
-                        // pack in timestamp
-                        deletesPacket->writePrimitive(now);
+        // we keep a multi map of entity IDs to timestamps, we only want to include the entity IDs that have been
+        // deleted since we last sent to this node
+        auto it = recentlyDeleted.constBegin();
+        while (it != recentlyDeleted.constEnd()) {
 
-                        // figure out where we are now and pack a temporary number of IDs
-                        numberOfIDs = 0;
-                        numberOfIDsPos = deletesPacket->pos();
-                        deletesPacket->writePrimitive(numberOfIDs);
-                    }
+            // if the timestamp is more recent then out last sent time, include it
+            if (it.key() > considerEntitiesSince) {
 
-                    // FIXME - we still seem to see cases where incorrect EntityIDs get sent from the server
-                    // to the client. These were causing "lost" entities like flashlights and laser pointers
-                    // now that we keep around some additional history of the erased entities and resend that
-                    // history for a longer time window, these entities are not "lost". But we haven't yet
-                    // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
-                    deletesPacket->write(entityID.toRfc4122());
-                    ++numberOfIDs;
+                // get all the IDs for this timestamp
+                const auto& entityIDsFromTime = recentlyDeleted.values(it.key());
 
-                    #ifdef EXTRA_ERASE_DEBUGGING
-                        qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
-                    #endif
+                for (const auto& entityID : entityIDsFromTime) {
+                    appendEntityID(entityID);
                 } // end for (ids)
 
             } // end if (it.val > sinceLast)
@@ -259,6 +289,11 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
             ++it;
         } // end while
 
+        // the client restored these from its entity cache, but they were deleted longer ago than we remember deletes for
+        for (const auto& entityID : nodeData->takeStaleCachedEntities()) {
+            appendEntityID(entityID);
+        }
+
         // replace the count for the number of included IDs
         deletesPacket->seek(numberOfIDsPos);
         deletesPacket->writePrimitive(numberOfIDs);
@@ -289,9 +324,27 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
 
 void EntityServer::pruneDeletedEntities() {
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+
+    // forget retained send state that nobody came back for, but otherwise hold on to the deletes
+    // those clients haven't heard about yet
+    quint64 earliestRetainedDeletedEntitiesSent = std::numeric_limits<quint64>::max();
+    {
+        QMutexLocker locker(&_retainedSendStatesLock);
+        quint64 expiry = usecTimestampNow() - RETAINED_SEND_STATE_LIFETIME_USECS;
+        for (auto itr = _retainedSendStates.begin(); itr != _retainedSendStates.end();) {
+            if (itr->retainedAt < expiry) {
+                itr = _retainedSendStates.erase(itr);
+            } else {
+                earliestRetainedDeletedEntitiesSent = std::min(earliestRetainedDeletedEntitiesSent, itr->lastDeletedEntitiesSentAt);
+                ++itr;
+            }
+        }
+    }
+
     if (tree->hasAnyDeletedEntities()) {
 
-        quint64 earliestLastDeletedEntitiesSent = usecTimestampNow() + 1; // in the future
+        quint64 earliestLastDeletedEntitiesSent = std::min(usecTimestampNow() + 1, // in the future
+                                                           earliestRetainedDeletedEntitiesSent);
         DependencyManager::get<NodeList>()->eachNode([&earliestLastDeletedEntitiesSent](const SharedNodePointer& node) {
             if (node->getLinkedData()) {
                 EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
@@ -403,6 +456,45 @@ void EntityServer::trackViewerGone(const QUuid& sessionID) {
     }
 }
 
+void EntityServer::retainSendState(const QUuid& resumeToken, RetainedSendState state) {
+    if (resumeToken.isNull() || state.knownState.isEmpty()) {
+        return;
+    }
+    state.retainedAt = usecTimestampNow();
+
+    QMutexLocker locker(&_retainedSendStatesLock);
+    if (_retainedSendStates.size() >= MAX_RETAINED_SEND_STATES && !_retainedSendStates.contains(resumeToken)) {
+        // make room by dropping the oldest
+        auto oldest = _retainedSendStates.begin();
+        for (auto itr = _retainedSendStates.begin(); itr != _retainedSendStates.end(); ++itr) {
+            if (itr->retainedAt < oldest->retainedAt) {
+                oldest = itr;
+            }
+        }
+        _retainedSendStates.erase(oldest);
+    }
+    _retainedSendStates[resumeToken] = std::move(state);
+    ++_sendStatesRetained;
+}
+
+// The resume token is what proves a client holds what we sent: it is a random UUID the client only ever sends to
+// its entity servers, and a retained state can only be taken once.
+bool EntityServer::takeRetainedSendState(const QUuid& resumeToken, RetainedSendState& state) {
+    if (resumeToken.isNull()) {
+        return false;
+    }
+
+    QMutexLocker locker(&_retainedSendStatesLock);
+    auto itr = _retainedSendStates.find(resumeToken);
+    if (itr == _retainedSendStates.end()) {
+        return false;
+    }
+    state = std::move(itr.value());
+    _retainedSendStates.erase(itr);
+    ++_sendStatesResumed;
+    return true;
+}
+
 QString EntityServer::serverSubclassStats() {
     QLocale locale(QLocale::English);
     QString statsString;
@@ -454,9 +546,40 @@ QString EntityServer::serverSubclassStats() {
     }
     statsString += "\r\n\r\n";
 
+    auto filterStats = DependencyManager::get<EntityEditFilters>()->getFilterStats();
+    if (!filterStats.isEmpty()) {
+        statsString += "<b>Entity Edit Filter Statistics</b>\r\n";
+        for (auto itr = filterStats.constBegin(); itr != filterStats.constEnd(); ++itr) {
+            auto stats = itr.value().toObject();
+            statsString += QString("%1 %2\r\n").arg(itr.key()).arg(stats["url"].toString());
+            statsString += QString("    calls: %1  skipped: %2  rejected: %3  avg: %4 usecs  max: %5 usecs\r\n")
+                .arg(locale.toString((qulonglong)stats["calls"].toDouble()))
+                .arg(locale.toString((qulonglong)stats["skipped"].toDouble()))
+                .arg(locale.toString((qulonglong)stats["rejected"].toDouble()))
+                .arg(stats["avgCallUsecs"].toDouble(), 0, 'f', 1)
+                .arg(stats["maxCallUsecs"].toDouble(), 0, 'f', 0);
+        }
+        statsString += "\r\n\r\n";
+    }
+
     return statsString;
 }
 
+void EntityServer::addServerSubclassStats(QJsonObject& statsObject) {
+    if (DependencyManager::isSet<EntityEditFilters>()) {
+        statsObject["6. editFilters"] = DependencyManager::get<EntityEditFilters>()->getFilterStats();
+    }
+
+    QJsonObject retainedSendStates;
+    {
+        QMutexLocker locker(&_retainedSendStatesLock);
+        retainedSendStates["1. current"] = _retainedSendStates.size();
+        retainedSendStates["2. totalRetained"] = (double)_sendStatesRetained;
+        retainedSendStates["3. totalResumed"] = (double)_sendStatesResumed;
+    }
+    statsObject["7. retainedSendStates"] = retainedSendStates;
+}
+
 void EntityServer::domainSettingsRequestFailed() {
     auto nodeList = DependencyManager::get<NodeList>();
     qCDebug(entities) << "The EntityServer couldn't get the Domain Settings. Starting dynamic domain verification with default values...";
@@ -27,6 +27,16 @@ struct ViewerSendingStats {
     quint64 lastEdited;
 };
 
+// What an EntityTreeSendThread knew it had sent to a client, kept around after the client's connection
+// or session goes away so that a client still holding those entities can pick up where it left off.
+// It is keyed on the client's resume token alone, since the domain hands out a new session UUID on every connect.
+struct RetainedSendState {
+    QHash<EntityItemID, quint64> knownState;
+    QSet<QUuid> sentFilteredEntities;
+    quint64 lastDeletedEntitiesSentAt { 0 };
+    quint64 retainedAt { 0 };
+};
+
 class SimpleEntitySimulation;
 using SimpleEntitySimulationPointer = std::shared_ptr<SimpleEntitySimulation>;
 
@@ -54,10 +64,15 @@ public:
     virtual void entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) override;
     virtual void readAdditionalConfiguration(const QJsonObject& settingsSectionObject) override;
     virtual QString serverSubclassStats() override;
+    virtual void addServerSubclassStats(QJsonObject& statsObject) override;
 
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& sessionID) override;
     virtual void trackViewerGone(const QUuid& sessionID) override;
 
+    // called by EntityTreeSendThreads, keyed by the resume token of the client's query
+    void retainSendState(const QUuid& resumeToken, RetainedSendState state);
+    bool takeRetainedSendState(const QUuid& resumeToken, RetainedSendState& state);
+
     virtual void aboutToFinish() override;
 
 public slots:
@@ -72,6 +87,7 @@ protected:
 
 private slots:
     void handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleEntityCacheManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestFailed();
 
 private:
@@ -81,6 +97,13 @@ private:
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
+    static const quint64 RETAINED_SEND_STATE_LIFETIME_USECS = 2 * 60 * USECS_PER_SECOND;
+    static const int MAX_RETAINED_SEND_STATES = 256;
+    QMutex _retainedSendStatesLock;
+    QHash<QUuid, RetainedSendState> _retainedSendStates;
+    quint64 _sendStatesRetained { 0 };
+    quint64 _sendStatesResumed { 0 };
+
     static const int DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = 45 * 60 * 1000;                    // 45m
     static const int DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = 60 * 60 * 1000;                    // 1h
     int _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 45m
@@ -28,11 +28,111 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
     connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
 }
 
+EntityTreeSendThread::~EntityTreeSendThread() {
+    retainState();
+}
+
 void EntityTreeSendThread::resetState() {
     qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
 
+    // the client may have kept its entities through the new connection, in which case its resume token
+    // will be unchanged and the next traversal picks this state back up
+    retainState();
+    _resumeToken = QUuid();
+
     _knownState.clear();
     _traversal.reset();
+    _hasSentInitialScene = false;
+}
+
+void EntityTreeSendThread::retainState() {
+    if (_resumeToken.isNull() || _knownState.empty()) {
+        return;
+    }
+
+    RetainedSendState state;
+    state.knownState.reserve((int)_knownState.size());
+    for (const auto& known : _knownState) {
+        state.knownState.insert(known.second.entityID, known.second.sentAt);
+    }
+    state.sentFilteredEntities = _sentFilteredEntities;
+    state.lastDeletedEntitiesSentAt = _lastDeletedEntitiesSentAt;
+    static_cast<EntityServer*>(_myServer)->retainSendState(_resumeToken, std::move(state));
+}
+
+void EntityTreeSendThread::resumeStateIfRetained(EntityNodeData& nodeData) {
+    RetainedSendState state;
+    if (!static_cast<EntityServer*>(_myServer)->takeRetainedSendState(_resumeToken, state)) {
+        return;
+    }
+
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+    entityTree->withReadLock([&] {
+        for (auto itr = state.knownState.cbegin(); itr != state.knownState.cend(); ++itr) {
+            auto entity = entityTree->findEntityByEntityItemID(itr.key());
+            if (entity) {
+                _knownState[entity.get()] = { itr.value(), itr.key() };
+            }
+        }
+    });
+
+    // deletes that happened while the client was away are still pending for it
+    nodeData.setLastDeletedEntitiesSentAt(std::min(nodeData.getLastDeletedEntitiesSentAt(), state.lastDeletedEntitiesSentAt));
+    nodeData.setSentFilteredEntities(state.sentFilteredEntities);
+
+    qCDebug(entities) << "Resumed EntityTreeSendThread state for" << _nodeUuid << "with"
+                      << _knownState.size() << "of" << state.knownState.size() << "known entities";
+}
+
+void EntityTreeSendThread::seedKnownStateFromCache(EntityNodeData& nodeData) {
+    QHash<QUuid, quint64> versions;
+    if (_resumeToken.isNull() || !nodeData.takeCachedEntityVersions(_resumeToken, versions)) {
+        return;
+    }
+
+    // we're called from traverseTreeAndSendContents, which already holds the tree's read lock
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+    int numCurrent = 0;
+    int numChanged = 0;
+    for (auto itr = versions.cbegin(); itr != versions.cend(); ++itr) {
+        auto entity = entityTree->findEntityByEntityItemID(itr.key());
+        if (!entity) {
+            nodeData.addStaleCachedEntity(itr.key());
+        } else if (entity->getLastEdited() == itr.value()) {
+            _knownState[entity.get()] = { itr.value(), entity->getEntityItemID() };
+            ++numCurrent;
+        } else {
+            // send the current version even if it's out of view, rather than leave the client's cached copy stale
+            _knownState.erase(entity.get());
+            if (!_sendQueue.contains(entity.get())) {
+                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY);
+            }
+            ++numChanged;
+        }
+    }
+
+    // a traversal may already have queued entities the client turns out to have
+    if (numCurrent > 0 && !_sendQueue.empty()) {
+        EntityPriorityQueue prevSendQueue;
+        std::swap(_sendQueue, prevSendQueue);
+        while (!prevSendQueue.empty()) {
+            const auto& queued = prevSendQueue.top();
+            EntityItemPointer entity = queued.getEntity();
+            if (entity) {
+                auto known = _knownState.find(entity.get());
+                bool isCurrent = known != _knownState.end() && !queued.shouldForceRemove() &&
+                    entity->getLastEdited() <= known->second.sentAt &&
+                    entity->getLastChangedOnServer() <= known->second.sentAt;
+                if (!isCurrent) {
+                    _sendQueue.emplace(entity, queued.getPriority(), queued.shouldForceRemove());
+                }
+            }
+            prevSendQueue.pop();
+        }
+    }
+
+    qCDebug(entities) << "Client" << _nodeUuid << "restored" << versions.size() << "cached entities:"
+                      << numCurrent << "current," << numChanged << "changed," << versions.size() - numCurrent - numChanged << "gone";
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,6 +201,19 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    auto entityNodeData = static_cast<EntityNodeData*>(nodeData);
+    QUuid resumeToken = entityNodeData->getResumeToken();
+    if (resumeToken != _resumeToken) {
+        // the client has either thrown away what we sent it (new token) or is returning to us with it (retained token)
+        retainState();
+        _knownState.clear();
+        _traversal.reset();
+        _resumeToken = resumeToken;
+        resumeStateIfRetained(*entityNodeData);
+    }
+    seedKnownStateFromCache(*entityNodeData);
+    _lastDeletedEntitiesSentAt = entityNodeData->getLastDeletedEntitiesSentAt();
+
     if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
@@ -234,20 +347,14 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
 
     switch (type) {
         case DiffTraversal::First:
-            // When we get to a First traversal, clear the _knownState
-            _knownState.clear();
+            // A forced First traversal must reconsider everything in view.  Otherwise (a new connection or a jump
+            // between views) we keep _knownState, so entities the client already holds unchanged aren't resent.
+            if (forceFirstPass) {
+                _knownState.clear();
+            }
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_sendQueue.contains(entity.get())) {
-                        return;
-                    }
-                    const auto& view = _traversal.getCurrentView();
-                    float priority = view.computePriority(entity);
-
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
-                    }
+                    queueIfUnknownOrChanged(entity);
                 });
             });
             break;
@@ -256,27 +363,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                 uint64_t startOfCompletedTraversal = _traversal.getStartOfCompletedTraversal();
                 if (next.element->getLastChangedContent() > startOfCompletedTraversal) {
                     next.element->forEachEntity([&](EntityItemPointer entity) {
-                        // Bail early if we've already checked this entity this frame
-                        if (_sendQueue.contains(entity.get())) {
-                            return;
-                        }
-                        float priority = PrioritizedEntity::DO_NOT_SEND;
-
-                        auto knownTimestamp = _knownState.find(entity.get());
-                        if (knownTimestamp == _knownState.end()) {
-                            const auto& view = _traversal.getCurrentView();
-                            priority = view.computePriority(entity);
-
-                        } else if (entity->getLastEdited() > knownTimestamp->second ||
-                                   entity->getLastChangedOnServer() > knownTimestamp->second) {
-                            // it is known and it changed --> put it on the queue with any priority
-                            // TODO: sort these correctly
-                            priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
-                        }
-
-                        if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                            _sendQueue.emplace(entity, priority);
-                        }
+                        queueIfUnknownOrChanged(entity);
                     });
                 }
             });
@@ -285,33 +372,37 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
             assert(view.usesViewFrustums());
             _traversal.setScanCallback([this] (DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_sendQueue.contains(entity.get())) {
-                        return;
-                    }
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
-
-                    auto knownTimestamp = _knownState.find(entity.get());
-                    if (knownTimestamp == _knownState.end()) {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
-
-                    } else if (entity->getLastEdited() > knownTimestamp->second ||
-                               entity->getLastChangedOnServer() > knownTimestamp->second) {
-                        // it is known and it changed --> put it on the queue with any priority
-                        // TODO: sort these correctly
-                        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
-                    }
-
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
-                    }
+                    queueIfUnknownOrChanged(entity);
                 });
             });
             break;
     }
 }
 
+void EntityTreeSendThread::queueIfUnknownOrChanged(const EntityItemPointer& entity) {
+    // Bail early if we've already checked this entity this frame
+    if (_sendQueue.contains(entity.get())) {
+        return;
+    }
+    float priority = PrioritizedEntity::DO_NOT_SEND;
+
+    auto knownTimestamp = _knownState.find(entity.get());
+    if (knownTimestamp == _knownState.end()) {
+        const auto& view = _traversal.getCurrentView();
+        priority = view.computePriority(entity);
+
+    } else if (entity->getLastEdited() > knownTimestamp->second.sentAt ||
+               entity->getLastChangedOnServer() > knownTimestamp->second.sentAt) {
+        // it is known and it changed --> put it on the queue with any priority
+        // TODO: sort these correctly
+        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+    }
+
+    if (priority != PrioritizedEntity::DO_NOT_SEND) {
+        _sendQueue.emplace(entity, priority);
+    }
+}
+
 bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) {
     if (_sendQueue.empty()) {
         params.stopReason = EncodeBitstreamParams::FINISHED;
@@ -371,6 +462,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                 if (!jsonFilters.isEmpty() && entityMatchesFilters) {
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
+                    _sentFilteredEntities.insert(entityID);
                 }
                 OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
 
@@ -384,13 +476,14 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 
                 if (entityPreviouslyMatchedFilter && !entityMatchesFilters) {
                     entityNodeData->removeSentFilteredEntity(entityID);
+                    _sentFilteredEntities.remove(entityID);
                 }
                 ++_numEntities;
             }
             if (queuedItem.shouldForceRemove()) {
                 _knownState.erase(entity.get());
             } else {
-                _knownState[entity.get()] = sendTime;
+                _knownState[entity.get()] = { sendTime, entity->getEntityItemID() };
             }
         }
         _sendQueue.pop();
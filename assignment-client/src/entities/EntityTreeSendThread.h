@@ -14,9 +14,13 @@
 
 #include <unordered_set>
 
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
 #include "../octree/OctreeSendThread.h"
 
 #include <DiffTraversal.h>
+#include <EntityItemID.h>
 #include <EntityPriorityQueue.h>
 #include <shared/ConicalViewFrustum.h>
 
@@ -29,6 +33,7 @@ class EntityTreeSendThread : public OctreeSendThread {
 
 public:
     EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
+    ~EntityTreeSendThread();
 
 protected:
     bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
@@ -42,16 +47,33 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    // hand our known state to the server when the client moves on, and take it back if the client returns still holding it
+    void retainState();
+    void resumeStateIfRetained(EntityNodeData& nodeData);
+    // mark what the client restored from its entity cache as known, so only entities that changed get sent
+    void seedKnownStateFromCache(EntityNodeData& nodeData);
+
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
+    void queueIfUnknownOrChanged(const EntityItemPointer& entity);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
     void preDistributionProcessing() override;
     bool hasSomethingToSend(OctreeQueryNode* nodeData) override { return !_sendQueue.empty(); }
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
 
+    struct KnownEntity {
+        uint64_t sentAt;
+        EntityItemID entityID;
+    };
+
     DiffTraversal _traversal;
     EntityPriorityQueue _sendQueue;
-    std::unordered_map<EntityItem*, uint64_t> _knownState;
+    std::unordered_map<EntityItem*, KnownEntity> _knownState;
+
+    // resume token of the client query our _knownState belongs to
+    QUuid _resumeToken;
+    quint64 _lastDeletedEntitiesSentAt { 0 };
+    QSet<QUuid> _sentFilteredEntities;
 
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
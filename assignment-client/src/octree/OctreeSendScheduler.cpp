@@ -0,0 +1,253 @@
+//
+//  OctreeSendScheduler.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QLocale>
+#include <QtCore/QThread>
+
+#include <SharedUtil.h>
+
+#include "OctreeServerConsts.h"
+
+// a pass that was granted packets always gets enough time to encode at least one of them
+static const quint64 MIN_ENCODE_USECS_PER_GRANT = 500;
+
+OctreeSendScheduler::OctreeSendScheduler() {
+    setPolicy(Policy());
+}
+
+const char* OctreeSendScheduler::getSendClassName(SendClass sendClass) {
+    switch (sendClass) {
+        case Incremental:
+            return "incremental";
+        case ViewChange:
+            return "viewChange";
+        case InitialFlood:
+            return "initialFlood";
+        default:
+            return "unknown";
+    }
+}
+
+void OctreeSendScheduler::setPolicy(const Policy& policy) {
+    QMutexLocker locker(&_lock);
+    _policy = policy;
+    for (auto& percent : _policy.reservedPercent) {
+        percent = std::max(0, std::min(percent, 100));
+    }
+    _policy.encodeBudgetPercent = std::max(1, std::min(_policy.encodeBudgetPercent, 100));
+    _encodeUsecsPerInterval = (quint64)OCTREE_SEND_INTERVAL_USECS * std::max(1, QThread::idealThreadCount())
+        * _policy.encodeBudgetPercent / 100;
+}
+
+OctreeSendScheduler::Policy OctreeSendScheduler::getPolicy() const {
+    QMutexLocker locker(&_lock);
+    return _policy;
+}
+
+void OctreeSendScheduler::setPacketsPerInterval(int packetsPerInterval) {
+    QMutexLocker locker(&_lock);
+    _packetsPerInterval = std::max(1, packetsPerInterval);
+}
+
+void OctreeSendScheduler::rollIntervalIfNeeded(quint64 now) {
+    if (now - _intervalStart < (quint64)OCTREE_SEND_INTERVAL_USECS) {
+        return;
+    }
+    _intervalStart = now;
+    ++_intervals;
+
+    for (auto& state : _classes) {
+        state.lastDemand = state.demand;
+        state.lastAgents = state.agents;
+        state.demand = 0;
+        state.agents = 0;
+    }
+
+    // each class first gets as much of its reserve as it wanted last interval...
+    int spare = _packetsPerInterval;
+    for (int i = 0; i < NumSendClasses; ++i) {
+        auto& state = _classes[i];
+        int reserved = _packetsPerInterval * _policy.reservedPercent[i] / 100;
+        state.packetsAllocated = std::min(reserved, state.lastDemand);
+        spare -= state.packetsAllocated;
+    }
+    spare = std::max(0, spare);
+
+    // ...then whatever nobody reserved goes to unmet demand, highest priority first
+    for (auto& state : _classes) {
+        int extra = std::min(spare, state.lastDemand - state.packetsAllocated);
+        state.packetsAllocated += extra;
+        spare -= extra;
+    }
+
+    for (auto& state : _classes) {
+        state.packetsRemaining = state.packetsAllocated;
+        state.encodeUsecsRemaining = (qint64)(_encodeUsecsPerInterval * state.packetsAllocated / _packetsPerInterval);
+    }
+    _sharedPacketsRemaining = spare;
+    _sharedEncodeUsecsRemaining = (qint64)(_encodeUsecsPerInterval * spare / _packetsPerInterval);
+}
+
+OctreeSendScheduler::Grant OctreeSendScheduler::acquire(SendClass sendClass, int wantedPackets) {
+    QMutexLocker locker(&_lock);
+    rollIntervalIfNeeded(usecTimestampNow());
+
+    Grant grant;
+    grant.sendClass = sendClass;
+    grant.interval = _intervals;
+    ++_classes[sendClass].totalGrants;
+
+    addToGrant(grant, wantedPackets);
+    return grant;
+}
+
+void OctreeSendScheduler::extend(Grant& grant, int morePackets) {
+    QMutexLocker locker(&_lock);
+    rollIntervalIfNeeded(usecTimestampNow());
+
+    if (grant.interval != _intervals) {
+        // the budget this grant came out of is gone, so don't let the pass draw on the new interval's
+        return;
+    }
+    addToGrant(grant, morePackets);
+}
+
+void OctreeSendScheduler::addToGrant(Grant& grant, int wantedPackets) {
+    auto& state = _classes[grant.sendClass];
+    wantedPackets = std::max(0, wantedPackets);
+    if (wantedPackets == 0) {
+        return;
+    }
+
+    // agents with nothing queued don't count towards the demand or the split of their class
+    if (grant.requestedPackets == 0) {
+        ++state.agents;
+    }
+    grant.requestedPackets += wantedPackets;
+    state.demand += wantedPackets;
+    state.totalRequestedPackets += wantedPackets;
+
+    if (!_policy.enabled) {
+        grant.packets += wantedPackets;
+        state.totalGrantedPackets += wantedPackets;
+        return;
+    }
+
+    // an even split of the class budget between the agents that wanted some of it
+    int fairShare = std::max(1, state.packetsAllocated / std::max(1, std::max(state.lastAgents, state.agents)));
+    int fromClass = std::min({ wantedPackets, std::max(0, fairShare - grant.packets), state.packetsRemaining });
+    qint64 classUsecs = 0;
+    if (fromClass > 0) {
+        classUsecs = state.encodeUsecsRemaining * fromClass / state.packetsRemaining;
+        state.packetsRemaining -= fromClass;
+        state.encodeUsecsRemaining -= classUsecs;
+    }
+
+    int fromShared = std::min(wantedPackets - fromClass, _sharedPacketsRemaining);
+    qint64 sharedUsecs = 0;
+    if (fromShared > 0) {
+        sharedUsecs = _sharedEncodeUsecsRemaining * fromShared / _sharedPacketsRemaining;
+        _sharedPacketsRemaining -= fromShared;
+        _sharedEncodeUsecsRemaining -= sharedUsecs;
+    }
+
+    int grantedPackets = fromClass + fromShared;
+    if (grantedPackets > 0) {
+        grant.packets += grantedPackets;
+        grant.encodeUsecs = std::max(MIN_ENCODE_USECS_PER_GRANT,
+                                     grant.encodeUsecs + (quint64)std::max((qint64)0, classUsecs + sharedUsecs));
+    }
+
+    state.totalGrantedPackets += grantedPackets;
+    if (grantedPackets < wantedPackets) {
+        ++state.totalThrottledGrants;
+    }
+}
+
+void OctreeSendScheduler::release(const Grant& grant, int packetsSent, quint64 encodeUsecs) {
+    QMutexLocker locker(&_lock);
+
+    auto& state = _classes[grant.sendClass];
+    state.totalSentPackets += std::max(0, packetsSent);
+    state.totalEncodeUsecs += encodeUsecs;
+
+    // budget left over from an earlier interval has already been reset
+    if (!_policy.enabled || grant.interval != _intervals) {
+        return;
+    }
+
+    // what the pass didn't use goes to whichever class wants it next, so it isn't stuck with a class that's idle
+    int unusedPackets = grant.packets - packetsSent;
+    if (unusedPackets > 0) {
+        _sharedPacketsRemaining += unusedPackets;
+    }
+    if (grant.encodeUsecs > 0) {
+        qint64 unusedEncodeUsecs = (qint64)grant.encodeUsecs - (qint64)encodeUsecs;
+        if (unusedEncodeUsecs > 0) {
+            _sharedEncodeUsecsRemaining += unusedEncodeUsecs;
+        } else {
+            // charge overruns to the class, so a pass that blew through its time slows its class down for the rest of the interval
+            state.encodeUsecsRemaining += unusedEncodeUsecs;
+        }
+    }
+}
+
+QJsonObject OctreeSendScheduler::getStats() const {
+    QMutexLocker locker(&_lock);
+
+    QJsonObject statsObject;
+    statsObject["1. enabled"] = _policy.enabled;
+    statsObject["2. packetsPerInterval"] = _packetsPerInterval;
+    statsObject["3. encodeUsecsPerInterval"] = (double)_encodeUsecsPerInterval;
+
+    QJsonObject classesObject;
+    for (int i = 0; i < NumSendClasses; ++i) {
+        const auto& state = _classes[i];
+        QJsonObject classObject;
+        classObject["1. reservedPercent"] = _policy.reservedPercent[i];
+        classObject["2. requestedPackets"] = (double)state.totalRequestedPackets;
+        classObject["3. grantedPackets"] = (double)state.totalGrantedPackets;
+        classObject["4. sentPackets"] = (double)state.totalSentPackets;
+        classObject["5. throttledPasses"] = (double)state.totalThrottledGrants;
+        classObject["6. avgEncodeUsecsPerPacket"] = state.totalSentPackets > 0 ?
+            (double)state.totalEncodeUsecs / state.totalSentPackets : 0.0;
+        classObject["7. lastIntervalDemand"] = state.lastDemand;
+        classObject["8. lastIntervalAgents"] = state.lastAgents;
+        classesObject[QString("%1. %2").arg(i + 1).arg(getSendClassName((SendClass)i))] = classObject;
+    }
+    statsObject["4. classes"] = classesObject;
+    return statsObject;
+}
+
+QString OctreeSendScheduler::getStatsHTML() const {
+    QMutexLocker locker(&_lock);
+
+    const int COLUMN_WIDTH = 12;
+    QLocale locale(QLocale::English);
+
+    QString statsString = QString("Send Scheduler: %1 (%2 packets and %3 encode usecs per interval)\r\n")
+        .arg(_policy.enabled ? "enabled" : "disabled")
+        .arg(locale.toString(_packetsPerInterval))
+        .arg(locale.toString(_encodeUsecsPerInterval));
+    for (int i = 0; i < NumSendClasses; ++i) {
+        const auto& state = _classes[i];
+        statsString += QString("    %1 reserved %2%  requested %3  sent %4  throttled passes %5\r\n")
+            .arg(QString(getSendClassName((SendClass)i)).leftJustified(COLUMN_WIDTH, ' '))
+            .arg(_policy.reservedPercent[i], 3)
+            .arg(locale.toString(state.totalRequestedPackets).rightJustified(COLUMN_WIDTH, ' '))
+            .arg(locale.toString(state.totalSentPackets).rightJustified(COLUMN_WIDTH, ' '))
+            .arg(locale.toString(state.totalThrottledGrants).rightJustified(COLUMN_WIDTH, ' '));
+    }
+    return statsString;
+}
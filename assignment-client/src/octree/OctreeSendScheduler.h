@@ -0,0 +1,113 @@
+//
+//  OctreeSendScheduler.h
+//  assignment-client/src/octree
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Server-wide scheduler that shares the octree server's packet and encode time budget between send threads
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendScheduler_h
+#define hifi_OctreeSendScheduler_h
+
+#include <array>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+
+/// Hands out per-interval packet and encode time grants to OctreeSendThreads. Each interval the server-wide budget is
+/// split between send classes by priority: incremental updates first, then view change fills, then initial floods.
+/// Every class is guaranteed its reserved share when it wants it; reserve a class didn't use last interval goes to
+/// the other classes in priority order. Within a class, agents get an even share of the class budget. Packets and
+/// encode time a pass didn't use go back to a pool any class can draw from for the rest of the interval.
+class OctreeSendScheduler {
+public:
+    enum SendClass {
+        Incremental = 0,
+        ViewChange,
+        InitialFlood,
+        NumSendClasses
+    };
+
+    struct Policy {
+        bool enabled { true };
+        // percent of the server-wide packet and encode budget reserved for each class
+        std::array<int, NumSendClasses> reservedPercent { { 50, 30, 20 } };
+        // percent of the server's CPU time (send interval x cores) that send threads may spend encoding
+        int encodeBudgetPercent { 75 };
+    };
+
+    struct Grant {
+        SendClass sendClass { Incremental };
+        int requestedPackets { 0 };
+        int packets { 0 };
+        // 0 when the scheduler isn't limiting encode time
+        quint64 encodeUsecs { 0 };
+        quint64 interval { 0 };
+    };
+
+    OctreeSendScheduler();
+
+    static const char* getSendClassName(SendClass sendClass);
+
+    void setPolicy(const Policy& policy);
+    Policy getPolicy() const;
+    bool isEnabled() const { QMutexLocker locker(&_lock); return _policy.enabled; }
+
+    void setPacketsPerInterval(int packetsPerInterval);
+
+    /// Asks for up to wantedPackets for this interval, which should only cover work the pass already has queued.
+    /// Call once per send pass and hand the grant back with release.
+    Grant acquire(SendClass sendClass, int wantedPackets);
+    /// Asks for morePackets on top of an existing grant, for when a pass turns up more work than it asked for.
+    void extend(Grant& grant, int morePackets);
+    /// Returns what a pass didn't use to the shared pool and records what it did use.
+    void release(const Grant& grant, int packetsSent, quint64 encodeUsecs);
+
+    QJsonObject getStats() const;
+    QString getStatsHTML() const;
+
+private:
+    struct ClassState {
+        // this interval
+        int packetsRemaining { 0 };
+        qint64 encodeUsecsRemaining { 0 };
+        int packetsAllocated { 0 };
+        int demand { 0 };
+        int agents { 0 };
+
+        // previous interval, used to size the next allocation
+        int lastDemand { 0 };
+        int lastAgents { 0 };
+
+        // totals for stats
+        quint64 totalRequestedPackets { 0 };
+        quint64 totalGrantedPackets { 0 };
+        quint64 totalSentPackets { 0 };
+        quint64 totalEncodeUsecs { 0 };
+        quint64 totalGrants { 0 };
+        quint64 totalThrottledGrants { 0 };
+    };
+
+    void rollIntervalIfNeeded(quint64 now);
+    void addToGrant(Grant& grant, int wantedPackets);
+
+    mutable QMutex _lock;
+    Policy _policy;
+    int _packetsPerInterval { 1 };
+    quint64 _encodeUsecsPerInterval { 0 };
+
+    quint64 _intervalStart { 0 };
+    quint64 _intervals { 0 };
+    std::array<ClassState, NumSendClasses> _classes;
+
+    // whatever was reserved but not wanted by any class last interval, plus whatever passes handed back unused,
+    // first come first served
+    int _sharedPacketsRemaining { 0 };
+    qint64 _sharedEncodeUsecsRemaining { 0 };
+};
+
+#endif // hifi_OctreeSendScheduler_h
@@ -324,8 +324,28 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     if (isFullScene) {
         // we're forcing a full scene, clear the force in OctreeQueryNode so we don't force it next time again
         nodeData->setShouldForceFullScene(false);
+        _hasSentInitialScene = false;
+    }
+    if (viewFrustumChanged) {
+        _isFillingViewChange = true;
     }
 
+    // ask the server's send scheduler for this interval's share of packets and encode time, but only for the work we
+    // already have queued; a traversal that turns up more asks for the rest in hasPacketBudget
+    auto& sendScheduler = _myServer->getSendScheduler();
+    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
+    int serverMaxPacketsPerInterval = sendScheduler.isEnabled() ?
+        _myServer->getMaxPacketsPerClientPerInterval() : _myServer->getPacketsPerClientPerInterval();
+    _maxPacketsWanted = std::min(clientMaxPacketsPerInterval, serverMaxPacketsPerInterval);
+    int queuedPackets = 0;
+    if (hasSomethingToSend(nodeData)) {
+        queuedPackets = _maxPacketsWanted;
+    } else if (nodeData->isPacketWaiting() || nodeData->hasNextNackedPacket()) {
+        queuedPackets = 1;
+    }
+    _sendGrant = sendScheduler.acquire(getSendClass(), queuedPackets);
+    _passStart = usecTimestampNow();
+
     if (nodeData->isPacketWaiting()) {
         // send the waiting packet
         _packetsSentThisInterval += handlePacketSend(node, nodeData);
@@ -384,12 +404,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         _totalSpecialBytes += specialBytesSent;
     }
 
-    // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
-
     // Re-send packets that were nacked by the client
-    while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < maxPacketsPerInterval) {
+    while (nodeData->hasNextNackedPacket() && hasPacketBudget()) {
         const NLPacket* packet = nodeData->getNextNackedPacket();
         if (packet) {
             DependencyManager::get<NodeList>()->sendUnreliablePacket(*packet, *node);
@@ -412,6 +428,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     // the octree elements from the current view frustum
     if (!hasSomethingToSend(nodeData)) {
         nodeData->setViewSent(true);
+        _hasSentInitialScene = true;
+        _isFillingViewChange = false;
 
         // If this was a full scene then make sure we really send out a stats packet at this point so that
         // the clients will know the scene is stable
@@ -421,14 +439,35 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         }
     }
 
+    sendScheduler.release(_sendGrant, _packetsSentThisInterval, usecTimestampNow() - _passStart);
+
     return _truePacketsSent;
 }
 
-bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
-    // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
+bool OctreeSendThread::hasPacketBudget() {
+    if (_packetsSentThisInterval >= _sendGrant.packets && _sendGrant.requestedPackets < _maxPacketsWanted) {
+        // we have more to send than we asked for at the start of the pass
+        _myServer->getSendScheduler().extend(_sendGrant, _maxPacketsWanted - _sendGrant.requestedPackets);
+    }
+    return _packetsSentThisInterval < _sendGrant.packets;
+}
 
+bool OctreeSendThread::hasEncodeBudget() const {
+    // an encode time of 0 means the send scheduler isn't limiting it
+    return _sendGrant.encodeUsecs == 0 || usecTimestampNow() < _passStart + _sendGrant.encodeUsecs;
+}
+
+OctreeSendScheduler::SendClass OctreeSendThread::getSendClass() const {
+    if (!_hasSentInitialScene) {
+        return OctreeSendScheduler::InitialFlood;
+    } else if (_isFillingViewChange) {
+        return OctreeSendScheduler::ViewChange;
+    } else {
+        return OctreeSendScheduler::Incremental;
+    }
+}
+
+bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
     int extraPackingAttempts = 0;
 
     // init params once outside the while loop
@@ -438,9 +477,9 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
         _myServer->trackSend(dataID, dataEdited, _nodeUuid);
     };
 
-    bool somethingToSend = true; // assume we have something
     bool hadSomething = hasSomethingToSend(nodeData);
-    while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
+    bool somethingToSend = hadSomething; // don't ask the send scheduler for packets we have nothing to fill with
+    while (somethingToSend && !nodeData->isShuttingDown() && hasPacketBudget() && hasEncodeBudget()) {
         float compressAndWriteElapsedUsec = OctreeServer::SKIP_TIME;
         float packetSendingElapsedUsec = OctreeServer::SKIP_TIME;
 
@@ -503,9 +542,9 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
     }
 
     if (somethingToSend && _myServer->wantsVerboseDebug()) {
-        qCDebug(octree) << "Hit PPS Limit, packetsSentThisInterval =" << _packetsSentThisInterval
-                        << "  maxPacketsPerInterval = " << maxPacketsPerInterval
-                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval;
+        qCDebug(octree) << "Hit send budget, packetsSentThisInterval =" << _packetsSentThisInterval
+                        << "  grantedPackets = " << _sendGrant.packets
+                        << "  grantedEncodeUsecs = " << _sendGrant.encodeUsecs;
     }
 
     return params.stopReason == EncodeBitstreamParams::FINISHED;
@@ -20,6 +20,7 @@
 #include <Node.h>
 #include <OctreePacketData.h>
 #include "OctreeQueryNode.h"
+#include "OctreeSendScheduler.h"
 
 class OctreeQueryNode;
 class OctreeServer;
@@ -60,7 +61,10 @@ protected:
     QWeakPointer<Node> _node;
     OctreeServer* _myServer { nullptr };
     QUuid _nodeUuid;
-    
+
+    // false until a complete scene has gone out to this client, so that passes are scheduled as an initial flood
+    bool _hasSentInitialScene { false };
+
 private:
     /// Called before a packetDistributor pass to allow for pre-distribution processing
     virtual void preDistributionProcessing() = 0;
@@ -70,9 +74,17 @@ private:
     virtual bool hasSomethingToSend(OctreeQueryNode* nodeData) = 0;
     virtual bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) = 0;
 
+    OctreeSendScheduler::SendClass getSendClass() const;
+    bool hasPacketBudget();
+    bool hasEncodeBudget() const;
+
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
+    int _maxPacketsWanted { 0 }; // most packets this pass may ask the server's send scheduler for
+    OctreeSendScheduler::Grant _sendGrant;
+    quint64 _passStart { 0 };
+    bool _isFillingViewChange { false };
     bool _isShuttingDown { false };
 };
 
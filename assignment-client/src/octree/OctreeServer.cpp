@@ -391,6 +391,7 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)getPacketsPerClientPerSecond()).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("        Configured Max PPS/Server: %1 pps/server\r\n\r\n")
             .arg(locale.toString((uint)getPacketsTotalPerSecond()).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += _sendScheduler.getStatsHTML() + "\r\n";
 
 
         // display scene stats
@@ -1096,6 +1097,25 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    OctreeSendScheduler::Policy sendPolicy;
+    bool disableSendScheduler;
+    readOptionBool(QString("disableSendScheduler"), settingsSectionObject, disableSendScheduler);
+    sendPolicy.enabled = !disableSendScheduler;
+    readOptionInt(QString("sendSchedulerIncrementalPercent"), settingsSectionObject,
+                  sendPolicy.reservedPercent[OctreeSendScheduler::Incremental]);
+    readOptionInt(QString("sendSchedulerViewChangePercent"), settingsSectionObject,
+                  sendPolicy.reservedPercent[OctreeSendScheduler::ViewChange]);
+    readOptionInt(QString("sendSchedulerInitialFloodPercent"), settingsSectionObject,
+                  sendPolicy.reservedPercent[OctreeSendScheduler::InitialFlood]);
+    readOptionInt(QString("sendSchedulerEncodeBudgetPercent"), settingsSectionObject, sendPolicy.encodeBudgetPercent);
+    _sendScheduler.setPolicy(sendPolicy);
+    _sendScheduler.setPacketsPerInterval(_packetsTotalPerInterval);
+    qDebug() << "sendScheduler enabled=" << sendPolicy.enabled
+             << "reservedPercent=" << sendPolicy.reservedPercent[OctreeSendScheduler::Incremental]
+             << sendPolicy.reservedPercent[OctreeSendScheduler::ViewChange]
+             << sendPolicy.reservedPercent[OctreeSendScheduler::InitialFlood]
+             << "encodeBudgetPercent=" << sendPolicy.encodeBudgetPercent;
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1475,6 +1495,8 @@ void OctreeServer::sendStatsPacket() {
     jsonArray["2. octree"] = octreeStats;
     jsonArray["3. outbound"] = statsObject2;
     jsonArray["4. inbound"] = statsObject3;
+    jsonArray["5. sendScheduler"] = _sendScheduler.getStats();
+    addServerSubclassStats(jsonArray);
 
     QJsonObject statsObject;
     statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
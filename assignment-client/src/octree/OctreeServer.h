@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendScheduler.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -56,6 +57,10 @@ public:
     int getPacketsTotalPerInterval() const { return _packetsTotalPerInterval; }
     int getPacketsTotalPerSecond() const { return getPacketsTotalPerInterval() * INTERVALS_PER_SECOND; }
 
+    // per-client cap before the send scheduler shares out the server-wide budget
+    int getMaxPacketsPerClientPerInterval() const { return _packetsPerClientPerInterval; }
+    OctreeSendScheduler& getSendScheduler() { return _sendScheduler; }
+
     static int getCurrentClientCount() { return _clientCount; }
     static void clientConnected() { _clientCount++; }
     static void clientDisconnected() { _clientCount--; }
@@ -82,6 +87,7 @@ public:
     virtual bool hasSpecialPacketsToSend(const SharedNodePointer& node) { return false; }
     virtual int sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) { return 0; }
     virtual QString serverSubclassStats() { return QString(); }
+    virtual void addServerSubclassStats(QJsonObject& statsObject) { }
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& viewerNode) { }
     virtual void trackViewerGone(const QUuid& viewerNode) { }
 
@@ -183,6 +189,7 @@ protected:
     QString _persistAsFileType;
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
+    OctreeSendScheduler _sendScheduler;
     OctreePointer _tree; // this IS a reaveraging tree
     bool _wantPersist;
     bool _debugSending;
@@ -13,6 +13,8 @@
 
 #include <mutex>
 
+#include <QtCore/QThread>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -127,7 +129,7 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        if (_entitiesScriptEngines && _entitiesScriptEngines->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -169,10 +171,36 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    static const QString SCRIPT_ENGINE_THREADS_OPTION = "script_engine_threads";
+    static const int MAX_SCRIPT_ENGINE_THREADS = 64;
+
+    int numEngines = 1;
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINE_THREADS_OPTION)) {
+        numEngines = entityScriptServerSettings[SCRIPT_ENGINE_THREADS_OPTION].toInt();
+        if (numEngines <= 0) {
+            numEngines = QThread::idealThreadCount();
+        }
+        numEngines = glm::clamp(numEngines, 1, MAX_SCRIPT_ENGINE_THREADS);
+    }
+
+    if (numEngines != _numEntityScriptEngines) {
+        qDebug() << "Running entity scripts on" << numEngines << "script engine threads";
+        _numEntityScriptEngines = numEngines;
+
+        // scripts that were already loaded have to move to whichever engine now owns their entity
+        if (_entitiesScriptEngines && !_shuttingDown) {
+            _entitiesScriptEngines->unloadAllEntityScripts();
+            _entitiesScriptEngines->stop();
+            _entitiesScriptEngines->waitTillDoneRunning();
+            resetEntitiesScriptEngine();
+            reloadAllEntityScripts();
+        }
+    }
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -233,7 +261,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entitiesScriptEngines && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -247,7 +275,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -433,7 +461,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(bool isPrimary) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
@@ -449,34 +477,72 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+    // only one engine needs to drive the entity viewer
+    if (isPrimary) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->update();
+        });
+    }
 
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+            this, &EntityScriptServer::updateEntityPPS);
 
     newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
+    return newEngine;
+}
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+void EntityScriptServer::resetEntitiesScriptEngine() {
+    auto newEngines = QSharedPointer<EntityScriptServerEngines>::create();
+    for (int i = 0; i < _numEntityScriptEngines; i++) {
+        newEngines->addEngine(createEntitiesScriptEngine(i == 0));
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    // calls from other scripts into an entity's script are routed to the engine that owns the entity
+    auto newEnginesSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngines);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEnginesSP);
+
+    if (_entitiesScriptEngines) {
+        for (int i = 0; i < _entitiesScriptEngines->getNumEngines(); i++) {
+            disconnect(_entitiesScriptEngines->getEngine(i).data(), &ScriptEngine::entityScriptDetailsUpdated,
+                       this, &EntityScriptServer::updateEntityPPS);
+        }
+    }
+
+    _entitiesScriptEngines.swap(newEngines);
+}
+
+void EntityScriptServer::reloadAllEntityScripts() {
+    auto tree = _entityViewer.getTree();
+    if (!tree) {
+        return;
+    }
+
+    QVector<EntityItemID> entityIDs;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                if (!entity->getServerScripts().isEmpty()) {
+                    entityIDs << entity->getEntityItemID();
+                }
+            });
+            return true;
+        }, nullptr);
+    });
+
+    for (auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    // unload and stop the engines
+    if (_entitiesScriptEngines) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        _entitiesScriptEngines->unloadAllEntityScripts();
+        _entitiesScriptEngines->stop();
+        _entitiesScriptEngines->waitTillDoneRunning();
     }
 
     _entityViewer.clear();
@@ -488,8 +554,8 @@ void EntityScriptServer::clear() {
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entitiesScriptEngines) {
+        _entitiesScriptEngines->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engines, except essential
     }
     _shuttingDown = true;
 
@@ -498,7 +564,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -516,8 +582,8 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
+        _entitiesScriptEngines->unloadEntityScript(entityID, true);
     }
 }
 
@@ -528,27 +594,33 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool isRunning = _entitiesScriptEngines->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                _entitiesScriptEngines->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                _entitiesScriptEngines->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
 }
 
 void EntityScriptServer::sendStatsPacket() {
-
+    QJsonObject statsObject;
+    if (_entitiesScriptEngines) {
+        QJsonObject scriptEngineStats = _entitiesScriptEngines->getStats();
+        scriptEngineStats["running_scripts"] = _entitiesScriptEngines->getNumRunningEntityScripts();
+        statsObject["script_engines"] = scriptEngineStats;
+    }
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
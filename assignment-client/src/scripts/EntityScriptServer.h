@@ -23,6 +23,7 @@
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptServerEngines.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -61,6 +62,8 @@ private:
     void selectAudioFormat(const QString& selectedCodecName);
 
     void resetEntitiesScriptEngine();
+    ScriptEnginePointer createEntitiesScriptEngine(bool isPrimary);
+    void reloadAllEntityScripts();
     void clear();
     void shutdownScriptEngine();
 
@@ -74,7 +77,8 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    QSharedPointer<EntityScriptServerEngines> _entitiesScriptEngines;
+    int _numEntityScriptEngines { 1 };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
@@ -0,0 +1,161 @@
+//
+//  EntityScriptServerEngines.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptServerEngines.h"
+
+#include <QtCore/QJsonArray>
+
+#include <SharedUtil.h>
+
+void EntityScriptServerEngines::addEngine(ScriptEnginePointer engine) {
+    auto shard = std::make_shared<Shard>();
+    shard->engine = engine;
+    shard->lastStatsTime = usecTimestampNow();
+    _shards.push_back(shard);
+}
+
+const EntityScriptServerEngines::ShardPointer& EntityScriptServerEngines::getShardForEntity(const EntityItemID& entityID) const {
+    // qHash of a QUuid doesn't depend on a per-process seed, so an entity maps to the same engine across restarts
+    return _shards[qHash(entityID) % _shards.size()];
+}
+
+ScriptEnginePointer EntityScriptServerEngines::getEngineForEntity(const EntityItemID& entityID) const {
+    if (_shards.empty()) {
+        return ScriptEnginePointer();
+    }
+    return getShardForEntity(entityID)->engine;
+}
+
+void EntityScriptServerEngines::dispatch(const ShardPointer& shard, std::function<void(ScriptEngine&)> call) {
+    shard->queuedCalls++;
+    shard->engine->executeOnScriptThread([shard, call] {
+        shard->queuedCalls--;
+        quint64 start = usecTimestampNow();
+        call(*shard->engine);
+        shard->dispatchedUsecs += usecTimestampNow() - start;
+    });
+}
+
+void EntityScriptServerEngines::loadEntityScript(const EntityItemID& entityID, const QString& scriptUrl, bool forceRedownload) {
+    if (_shards.empty()) {
+        return;
+    }
+    dispatch(getShardForEntity(entityID), [entityID, scriptUrl, forceRedownload](ScriptEngine& engine) {
+        engine.loadEntityScript(entityID, scriptUrl, forceRedownload);
+    });
+}
+
+void EntityScriptServerEngines::unloadEntityScript(const EntityItemID& entityID, bool shouldRemoveFromMap) {
+    if (_shards.empty()) {
+        return;
+    }
+    dispatch(getShardForEntity(entityID), [entityID, shouldRemoveFromMap](ScriptEngine& engine) {
+        engine.unloadEntityScript(entityID, shouldRemoveFromMap);
+    });
+}
+
+void EntityScriptServerEngines::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                       const QStringList& params, const QUuid& remoteCallerID) {
+    if (_shards.empty()) {
+        return;
+    }
+    dispatch(getShardForEntity(entityID), [entityID, methodName, params, remoteCallerID](ScriptEngine& engine) {
+        engine.callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    });
+}
+
+QFuture<QVariant> EntityScriptServerEngines::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngineForEntity(entityID);
+    if (!engine) {
+        return QFuture<QVariant>();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
+}
+
+bool EntityScriptServerEngines::getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails& details) const {
+    auto engine = getEngineForEntity(entityID);
+    return engine && engine->getEntityScriptDetails(entityID, details);
+}
+
+int EntityScriptServerEngines::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (auto& shard : _shards) {
+        numRunningScripts += shard->engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+void EntityScriptServerEngines::disconnectNonEssentialSignals() {
+    for (auto& shard : _shards) {
+        shard->engine->disconnectNonEssentialSignals();
+    }
+}
+
+void EntityScriptServerEngines::unloadAllEntityScripts() {
+    for (auto& shard : _shards) {
+        shard->engine->unloadAllEntityScripts();
+    }
+}
+
+void EntityScriptServerEngines::stop() {
+    for (auto& shard : _shards) {
+        shard->engine->stop();
+    }
+}
+
+void EntityScriptServerEngines::waitTillDoneRunning() {
+    for (auto& shard : _shards) {
+        shard->engine->waitTillDoneRunning();
+    }
+}
+
+QJsonObject EntityScriptServerEngines::getStats() {
+    QJsonObject stats;
+    QJsonArray engines;
+    int totalQueuedCalls = 0;
+    quint64 now = usecTimestampNow();
+    for (auto& shard : _shards) {
+        auto& engine = *shard->engine;
+        quint64 elapsed = std::max<quint64>(1, now - shard->lastStatsTime);
+
+        // timer and update handlers are counted by the engine; loads, unloads and method calls by dispatch()
+        quint64 executionUsecs = engine.getTotalExecutionUsecs();
+        quint64 dispatchedUsecs = shard->dispatchedUsecs;
+        quint64 busyUsecs = (executionUsecs - shard->lastExecutionUsecs) + (dispatchedUsecs - shard->lastDispatchedUsecs);
+
+        quint64 timersFired = engine.getTimersFired();
+        quint64 timerLagUsecs = engine.getTotalTimerLagUsecs();
+        quint64 intervalTimersFired = timersFired - shard->lastTimersFired;
+        quint64 intervalTimerLagUsecs = timerLagUsecs - shard->lastTimerLagUsecs;
+
+        int queuedCalls = shard->queuedCalls;
+        totalQueuedCalls += queuedCalls;
+
+        QJsonObject engineStats;
+        engineStats["name"] = engine.getFilename();
+        engineStats["entity_scripts"] = engine.getNumRunningEntityScripts();
+        engineStats["cpu_percent"] = 100.0 * (double)busyUsecs / (double)elapsed;
+        engineStats["avg_timer_lag_usecs"] = intervalTimersFired > 0 ? (double)intervalTimerLagUsecs / intervalTimersFired : 0.0;
+        engineStats["max_timer_lag_usecs"] = (double)engine.getMaxTimerLagUsecs();
+        engineStats["queued_calls"] = queuedCalls;
+        engines.push_back(engineStats);
+
+        engine.resetMaxTimerLag();
+        shard->lastStatsTime = now;
+        shard->lastExecutionUsecs = executionUsecs;
+        shard->lastDispatchedUsecs = dispatchedUsecs;
+        shard->lastTimersFired = timersFired;
+        shard->lastTimerLagUsecs = timerLagUsecs;
+    }
+    stats["num_engines"] = getNumEngines();
+    stats["queued_calls"] = totalQueuedCalls;
+    stats["engines"] = engines;
+    return stats;
+}
@@ -0,0 +1,80 @@
+//
+//  EntityScriptServerEngines.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptServerEngines_h
+#define hifi_EntityScriptServerEngines_h
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// Spreads server entity scripts across several script engines, each running on its own thread.
+// An entity always maps to the same engine (by hashing its ID), so every call for that entity's
+// script lands on the engine that loaded it.
+class EntityScriptServerEngines : public EntitiesScriptEngineProvider {
+public:
+    void addEngine(ScriptEnginePointer engine);
+
+    int getNumEngines() const { return (int)_shards.size(); }
+    ScriptEnginePointer getEngine(int index) const { return _shards[index]->engine; }
+    ScriptEnginePointer getEngineForEntity(const EntityItemID& entityID) const;
+
+    void loadEntityScript(const EntityItemID& entityID, const QString& scriptUrl, bool forceRedownload);
+    void unloadEntityScript(const EntityItemID& entityID, bool shouldRemoveFromMap = false);
+    bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails& details) const;
+    int getNumRunningEntityScripts() const;
+
+    void disconnectNonEssentialSignals();
+    void unloadAllEntityScripts();
+    void stop();
+    void waitTillDoneRunning();
+
+    // EntitiesScriptEngineProvider
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+    // per-engine CPU time, timer lag and queue length since the last call; must be called from a single thread.
+    // CPU time covers timers, update handlers and every call dispatched to the engine: entity method calls, script
+    // loads and unloads.  A script that has to be downloaded is evaluated once the download completes, outside of its
+    // load call, so that part isn't counted.  Timer lag is
+    // approximate: a timer's due time is estimated as one interval after it was started or last handled, which
+    // also picks up Qt's timer coarseness.
+    QJsonObject getStats();
+
+private:
+    struct Shard {
+        ScriptEnginePointer engine;
+
+        // work handed to this engine that hasn't started running on its thread yet
+        std::atomic<int> queuedCalls { 0 };
+        std::atomic<quint64> dispatchedUsecs { 0 };
+
+        quint64 lastStatsTime { 0 };
+        quint64 lastExecutionUsecs { 0 };
+        quint64 lastDispatchedUsecs { 0 };
+        quint64 lastTimersFired { 0 };
+        quint64 lastTimerLagUsecs { 0 };
+    };
+    using ShardPointer = std::shared_ptr<Shard>;
+
+    const ShardPointer& getShardForEntity(const EntityItemID& entityID) const;
+    void dispatch(const ShardPointer& shard, std::function<void(ScriptEngine&)> call);
+
+    std::vector<ShardPointer> _shards;
+};
+
+#endif // hifi_EntityScriptServerEngines_h
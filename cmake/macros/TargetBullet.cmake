@@ -17,6 +17,12 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # our Bullet is always built with BULLET2_MULTITHREADING, which doesn't export the define its headers depend on
+        target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+        if (USE_BULLET_MULTITHREADING)
+            # without it physics only ever uses the single threaded world
+            target_compile_definitions(${TARGET_NAME} PRIVATE USE_BULLET_MULTITHREADING)
+        endif()
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
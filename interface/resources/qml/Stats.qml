@@ -71,6 +71,10 @@ Item {
                     StatText {
                         text: "Physics Object Count: " + root.physicsObjectCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "    Frozen: " + root.frozenPhysicsObjectCount
+                    }
                     StatText {
                         visible: root.expanded
                         text: root.gameUpdateStats
@@ -29,6 +29,7 @@
 #include <QtCore/QMimeData>
 #include <QtCore/QThreadPool>
 #include <QtCore/QFileSelector>
+#include <QtCore/QFutureWatcher>
 #include <QtConcurrent/QtConcurrentRun>
 
 #include <QtGui/QClipboard>
@@ -306,6 +307,9 @@ static const QString WEB_VIEW_TAG = "noDownload=true";
 static const QString ZIP_EXTENSION = ".zip";
 static const QString CONTENT_ZIP_EXTENSION = ".content.zip";
 
+static const std::string ENTITY_CACHE_DIRNAME { "entity_cache" };
+static const std::string ENTITY_CACHE_EXT { "json.gz" };
+
 static const float MIRROR_FULLSCREEN_DISTANCE = 0.789f;
 
 static const quint64 TOO_LONG_SINCE_LAST_SEND_DOWNSTREAM_AUDIO_STATS = 1 * USECS_PER_SECOND;
@@ -317,6 +321,8 @@ static const unsigned int THROTTLED_SIM_FRAMERATE = 15;
 static const int THROTTLED_SIM_FRAME_PERIOD_MS = MSECS_PER_SECOND / THROTTLED_SIM_FRAMERATE;
 static const int ENTITY_SERVER_ADDED_TIMEOUT = 5000;
 static const int ENTITY_SERVER_CONNECTION_TIMEOUT = 5000;
+// entity servers only retain what they sent a client for two minutes, so there's no point holding on longer
+static const int LOST_ENTITY_SERVER_TIMEOUT = 2 * 60 * MSECS_PER_SECOND;
 static const int WATCHDOG_TIMER_TIMEOUT = 100;
 
 static const float INITIAL_QUERY_RADIUS = 10.0f;  // priority radius for entities before physics enabled
@@ -327,6 +333,9 @@ Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTRE
 
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
 
+// more than one steps Bullet's multithreaded world on the TBB worker threads
+Setting::Handle<int> physicsThreads{"physicsThreads", 1};
+
 static const QUrl AVATAR_INPUTS_BAR_QML = PathUtils::qmlUrl("AvatarInputsBar.qml");
 static const QUrl MIC_BAR_APPLICATION_QML = PathUtils::qmlUrl("hifi/audio/MicBarApplication.qml");
 static const QUrl BUBBLE_ICON_QML = PathUtils::qmlUrl("BubbleIcon.qml");
@@ -1123,6 +1132,9 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
 
     _entityClipboard->createRootElement();
 
+    _entityCache = std::make_shared<EntityCache>(ENTITY_CACHE_DIRNAME, ENTITY_CACHE_EXT);
+    _entityCache->initialize();
+
 #ifdef Q_OS_WIN
     installNativeEventFilter(&MyNativeEventFilter::getInstance());
 #endif
@@ -1288,6 +1300,15 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     _entityServerConnectionTimer.setSingleShot(true);
     connect(&_entityServerConnectionTimer, &QTimer::timeout, this, &Application::setFailedToConnectToEntityServer);
 
+    _lostEntityServerTimer.setSingleShot(true);
+    _lostEntityServerTimer.setInterval(LOST_ENTITY_SERVER_TIMEOUT);
+    connect(&_lostEntityServerTimer, &QTimer::timeout, this, [this] {
+        if (!_lostEntityServerID.isNull()) {
+            // the entity server didn't come back, stop holding on to its entities
+            clearDomainOctreeDetails(false);
+        }
+    });
+
     connect(&domainHandler, &DomainHandler::connectedToDomain, this, [this]() {
         if (!isServerlessMode()) {
             _entityServerConnectionTimer.setInterval(ENTITY_SERVER_ADDED_TIMEOUT);
@@ -2697,6 +2718,9 @@ void Application::onAboutToQuit() {
     getOffscreenUI()->hide("RunningScripts");
 #endif
 
+    saveEntityCache();
+    _entityCache->waitForDone();
+
     _aboutToQuit = true;
 
     cleanupBeforeQuit();
@@ -5552,7 +5576,9 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    _shapeManager.setCache(std::make_shared<CollisionShapeCache>(PathUtils::getAppLocalDataFilePath("collisionShapes")));
     ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->setNumThreads(physicsThreads.get());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
@@ -5984,6 +6010,7 @@ void Application::reloadResourceCaches() {
     // Query the octree to refresh everything in view
     _queryExpiry = SteadyClock::now();
     _octreeQuery.incrementConnectionID();
+    _octreeQuery.regenerateResumeToken(); // we're about to throw away all of our entities
 
     queryOctree(NodeType::EntityServer, PacketType::EntityQuery);
 
@@ -7026,6 +7053,10 @@ float Application::getNumCollisionObjects() const {
     return _physicsEngine ? _physicsEngine->getNumCollisionObjects() : 0;
 }
 
+int Application::getNumFrozenPhysicsObjects() const {
+    return _entitySimulation ? _entitySimulation->getNumFrozenObjects() : 0;
+}
+
 float Application::getTargetRenderFrameRate() const { return getActiveDisplayPlugin()->getTargetFrameRate(); }
 
 QRect Application::getDesirableApplicationGeometry() const {
@@ -7171,12 +7202,18 @@ void Application::clearDomainOctreeDetails(bool clearAll) {
     resetPhysicsReadyInformation();
     setIsInterstitialMode(true);
 
+    saveEntityCache();
+
     _octreeServerSceneStats.withWriteLock([&] {
         _octreeServerSceneStats.clear();
     });
 
     // reset the model renderer
     clearAll ? getEntities()->clear() : getEntities()->clearDomainAndNonOwnedEntities();
+    // we no longer hold what the entity server sent us, so it mustn't resume from its earlier state
+    _octreeQuery.regenerateResumeToken();
+    _lostEntityServerID = QUuid();
+    _lostEntityServerTimer.stop();
 
     auto skyStage = DependencyManager::get<SceneScriptingInterface>()->getSkyStage();
 
@@ -7191,6 +7228,13 @@ void Application::clearDomainOctreeDetails(bool clearAll) {
     DependencyManager::get<recording::ClipCache>()->clearUnusedResources();
 }
 
+void Application::saveEntityCache() {
+    if (!_entityCacheDomainID.isNull()) {
+        _entityCache->saveDomain(_entityCacheDomainID, getEntities()->getTree());
+        _entityCacheDomainID = QUuid();
+    }
+}
+
 void Application::domainURLChanged(QUrl domainURL) {
     // disable physics until we have enough information about our new location to not cause craziness.
     resetPhysicsReadyInformation();
@@ -7219,6 +7263,13 @@ void Application::resettingDomain() {
 
 void Application::nodeAdded(SharedNodePointer node) {
     if (node->getType() == NodeType::EntityServer) {
+        if (!_lostEntityServerID.isNull() && node->getUUID() != _lostEntityServerID) {
+            // this is a different entity server than the one we lost, so it can't resume what we're holding
+            clearDomainOctreeDetails(false);
+        }
+        _lostEntityServerID = QUuid();
+        _lostEntityServerTimer.stop();
+
         if (_failedToConnectToEntityServer && !_entityServerConnectionTimer.isActive()) {
             _failedToConnectToEntityServer = false;
             _octreeProcessor.stopSafeLanding();
@@ -7260,6 +7311,34 @@ void Application::nodeActivated(SharedNodePointer node) {
         _queryExpiry = SteadyClock::now();
         _octreeQuery.incrementConnectionID();
 
+        // restore what we cached on our last visit and tell the entity server which versions we already hold
+        QUuid domainID = DependencyManager::get<NodeList>()->getDomainHandler().getUUID();
+        if (!isServerlessMode() && !domainID.isNull()) {
+            if (_entityCacheDomainID != domainID) {
+                _entityCacheDomainID = domainID;
+                // the cache is read and parsed off the main thread, only the finished entities come back to it
+                auto watcher = new QFutureWatcher<EntityCache::CachedEntities>(this);
+                connect(watcher, &QFutureWatcher<EntityCache::CachedEntities>::finished, this, [this, watcher, domainID] {
+                    watcher->deleteLater();
+                    if (_entityCacheDomainID != domainID) {
+                        // we left the domain while its cache was being read
+                        return;
+                    }
+                    auto entityTree = getEntities()->getTree();
+                    EntityCache::restoreEntities(watcher->result(), entityTree);
+                    auto entityServer = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::EntityServer);
+                    if (entityServer && entityServer->getActiveSocket()) {
+                        EntityCache::sendManifest(EntityCache::buildManifest(entityTree), _octreeQuery.getResumeToken(),
+                                                  entityServer);
+                    }
+                });
+                watcher->setFuture(_entityCache->loadDomain(domainID));
+            } else {
+                EntityCache::sendManifest(EntityCache::buildManifest(getEntities()->getTree()),
+                                          _octreeQuery.getResumeToken(), node);
+            }
+        }
+
         if  (!_failedToConnectToEntityServer) {
             _entityServerConnectionTimer.stop();
         }
@@ -7304,8 +7383,11 @@ void Application::nodeKilled(SharedNodePointer node) {
     if (node->getType() == NodeType::AudioMixer) {
         QMetaObject::invokeMethod(DependencyManager::get<AudioClient>().data(), "audioMixerKilled");
     } else if (node->getType() == NodeType::EntityServer) {
-        // we lost an entity server, clear all of the domain octree details
-        clearDomainOctreeDetails(false);
+        // We lost an entity server.  Keep its entities and our resume token for now: if the same server comes
+        // back it picks up where it left off.  A different server clears the domain octree details in nodeAdded,
+        // and so does the server not coming back in time.
+        _lostEntityServerID = node->getUUID();
+        _lostEntityServerTimer.start();
     } else if (node->getType() == NodeType::AssetServer) {
         // asset server going away - check if we have the asset browser showing
 
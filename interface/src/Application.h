@@ -27,6 +27,7 @@
 #include <ThreadHelpers.h>
 #include <AbstractScriptingServicesInterface.h>
 #include <AbstractViewStateInterface.h>
+#include <EntityCache.h>
 #include <EntityEditPacketSender.h>
 #include <EntityTreeRenderer.h>
 #include <FileScriptingInterface.h>
@@ -211,6 +212,7 @@ public:
     size_t getRenderFrameCount() const { return _graphicsEngine.getRenderFrameCount(); }
     float getRenderLoopRate() const { return _graphicsEngine.getRenderLoopRate(); }
     float getNumCollisionObjects() const;
+    int getNumFrozenPhysicsObjects() const;
     float getTargetRenderFrameRate() const; // frames/second
 
     static void setupQmlSurface(QQmlContext* surfaceContext, bool setAdditionalContextProperties);
@@ -498,6 +500,7 @@ private slots:
     void onDesktopRootContextCreated(QQmlContext* qmlContext);
     void showDesktop();
     void clearDomainOctreeDetails(bool clearAll = true);
+    void saveEntityCache();
     void onAboutToQuit();
     void onPresent(quint32 frameCount);
 
@@ -665,6 +668,9 @@ private:
 
     OctreeQuery _octreeQuery { true }; // NodeData derived class for querying octee cells from octree servers
 
+    EntityCachePointer _entityCache;
+    QUuid _entityCacheDomainID; // the domain whose entities the tree holds, to be cached when we leave it
+
     std::shared_ptr<controller::StateController> _applicationStateDevice; // Default ApplicationDevice reflecting the state of different properties of the session
     std::shared_ptr<KeyboardMouseDevice> _keyboardMouseDevice;   // Default input device, the good old keyboard mouse and maybe touchpad
     std::shared_ptr<TouchscreenDevice> _touchscreenDevice;   // the good old touchscreen
@@ -805,6 +811,9 @@ private:
     QTimer _addAssetToWorldInfoTimer;
     QTimer _addAssetToWorldErrorTimer;
     mutable QTimer _entityServerConnectionTimer;
+    // the entity server we lost but whose entities we're holding on to, in case it comes back and resumes sending
+    QUuid _lostEntityServerID;
+    QTimer _lostEntityServerTimer;
 
     FileScriptingInterface* _fileDownload;
     AudioInjectorPointer _snapshotSoundInjector;
@@ -35,6 +35,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -55,6 +56,10 @@
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
+// enough avatars for each thread that a slow one doesn't hold up the batch, few enough that the time budget is still
+// checked often
+const size_t AVATARS_PER_THREAD_PER_BATCH = 4;
+
 AvatarManager::AvatarManager(QObject* parent) :
     _myAvatar(new MyAvatar(qApp->thread()), [](MyAvatar* ptr) { ptr->deleteLater(); })
 {
@@ -296,6 +301,13 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    // The avatars are simulated a batch at a time. The joint poses and skinning of a batch only touch each avatar's own
+    // rig and model, so they are computed in parallel, everything that touches the scene, physics or other avatars stays
+    // on this thread. The time budget is checked between batches.
+    const size_t SIMULATION_BATCH_SIZE = (size_t)std::max(1, QThread::idealThreadCount()) * AVATARS_PER_THREAD_PER_BATCH;
+    std::vector<std::pair<std::shared_ptr<OtherAvatar>, bool>> batch;
+    batch.reserve(SIMULATION_BATCH_SIZE);
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -303,33 +315,61 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
-        for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
-            const SortableAvatar& sortData = *it;
-            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
-            if (!avatar->_isClientAvatar) {
-                avatar->setIsClientAvatar(true);
-            }
-            // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
-            if (avatar->getSkeletonModel()->isLoaded()) {
-                // remove the orb if it is there
-                avatar->removeOrb();
-                if (avatar->needsPhysicsUpdate()) {
-                    _otherAvatarsToChangeInPhysics.insert(avatar);
+        auto it = sortedAvatarVector.begin();
+        while (it != sortedAvatarVector.end()) {
+            if (usecTimestampNow() >= passExpiry) {
+                // we've spent our time budget for this priority bucket
+                // let's deal with the reminding avatars if this pass and BREAK from the loop
+
+                if (p == kHero) {
+                    // Hero,
+                    // --> put them back in the non hero queue
+
+                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
+                    while (it != sortedAvatarVector.end()) {
+                        crowdQueue.push(SortableAvatar((*it).getAvatar()));
+                        ++it;
+                    }
+                } else {
+                    // Non Hero
+                    // --> bail on the rest of the avatar updates
+                    // --> more avatars may freeze until their priority trickles up
+                    // --> some scale animations may glitch
+                    // --> some avatar velocity measurements may be a little off
+
+                    // no time to simulate, but we take the time to count how many were tragically missed
+                    numAvatarsNotUpdated = sortedAvatarVector.end() - it;
                 }
-            } else {
-                avatar->updateOrbPosition();
-            }
 
-            // for ALL avatars...
-            if (_shouldRender) {
-                avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                // We had to cut short this pass, we must break out of the loop here
+                break;
             }
 
-            avatar->animateScaleChanges(deltaTime);
+            batch.clear();
+            for (; it != sortedAvatarVector.end() && batch.size() < SIMULATION_BATCH_SIZE; ++it) {
+                const SortableAvatar& sortData = *it;
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                if (!avatar->_isClientAvatar) {
+                    avatar->setIsClientAvatar(true);
+                }
+                // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
+                if (avatar->getSkeletonModel()->isLoaded()) {
+                    // remove the orb if it is there
+                    avatar->removeOrb();
+                    if (avatar->needsPhysicsUpdate()) {
+                        _otherAvatarsToChangeInPhysics.insert(avatar);
+                    }
+                } else {
+                    avatar->updateOrbPosition();
+                }
+
+                // for ALL avatars...
+                if (_shouldRender) {
+                    avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                }
+
+                avatar->animateScaleChanges(deltaTime);
 
-            uint64_t now = usecTimestampNow();
-            if (now < passExpiry) {
-                // we're within budget
                 bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
                 if (inView && avatar->hasNewJointData()) {
                     numAvatarsUpdated++;
@@ -340,7 +380,35 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
+
+                // the fraction of the view the avatar covers in the view it is biggest in
+                float screenCoverage = views.empty() ? 1.0f : 0.0f;
+                for (const auto& view : views) {
+                    float distance = glm::distance(view.getPosition(), avatar->getWorldPosition());
+                    screenCoverage = std::max(screenCoverage, view.getAngularSize(distance, avatar->getBoundingRadius()) /
+                                                                  tanf(view.getAngle()));
+                }
+                auto& rig = avatar->getSkeletonModel()->getRig();
+                rig.setAnimationLOD(Rig::computeAnimationLOD(screenCoverage, rig.getAnimationLOD()));
+
+                batch.push_back({ avatar, inView });
+            }
+
+            {
+                PROFILE_RANGE(simulation, "jointPoses");
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size()), [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i != range.end(); ++i) {
+                        const auto& avatar = batch[i].first;
+                        if (avatar->needsJointPoses(batch[i].second)) {
+                            avatar->computeJointPoses();
+                        }
+                    }
+                });
+            }
+
+            for (const auto& entry : batch) {
+                const auto& avatar = entry.first;
+                avatar->simulate(deltaTime, entry.second);
                 if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
@@ -351,33 +419,25 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                 avatar->updateRenderItem(renderTransaction);
                 avatar->updateSpaceProxy(workloadTransaction);
                 avatar->setLastRenderUpdateTime(startTime);
+            }
 
-            } else {
-                // we've spent our time budget for this priority bucket
-                // let's deal with the reminding avatars if this pass and BREAK from the for loop
-
-                if (p == kHero) {
-                    // Hero,
-                    // --> put them back in the non hero queue
-
-                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
-                    while (it != sortedAvatarVector.end()) {
-                        crowdQueue.push(SortableAvatar((*it).getAvatar()));
-                        ++it;
+            {
+                // the render item update at the end of the frame finds these up to date and skips them
+                PROFILE_RANGE(simulation, "clusterMatrices");
+                // the blender touches other models too, so it is only posted from here
+                std::vector<uint8_t> requiresBlend(batch.size(), false);
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size()), [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i != range.end(); ++i) {
+                        requiresBlend[i] = batch[i].first->getSkeletonModel()->updateClusterMatricesDeferringBlend();
                     }
-                } else {
-                    // Non Hero
-                    // --> bail on the rest of the avatar updates
-                    // --> more avatars may freeze until their priority trickles up
-                    // --> some scale animations may glitch
-                    // --> some avatar velocity measurements may be a little off
+                });
 
-                    // no time to simulate, but we take the time to count how many were tragically missed
-                    numAvatarsNotUpdated = sortedAvatarVector.end() - it;
+                auto modelBlender = DependencyManager::get<ModelBlender>();
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    if (requiresBlend[i]) {
+                        modelBlender->noteRequiresBlend(batch[i].first->getSkeletonModel());
+                    }
                 }
-
-                // We had to cut short this pass, we must break out of the for loop here
-                break;
             }
         }
 
@@ -259,10 +259,12 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            if ((_hasNewJointData || _transit.isActive()) && isJointUpdateDue()) {
+                _framesSinceJointUpdate = 0;
+                if (!_jointPosesComputed) {
+                    computeJointPoses();
+                }
+                _jointPosesComputed = false;
                 _jointDataSimulationRate.increment();
 
                 _skeletonModel->simulate(deltaTime, true);
@@ -275,6 +277,8 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
                     headPosition = getWorldPosition();
                 }
                 head->setPosition(headPosition);
+            } else if (_framesSinceJointUpdate < _skeletonModel->getRig().getAnimationLODInterval()) {
+                ++_framesSinceJointUpdate;
             }
             head->setScale(getModelScale());
             head->simulate(deltaTime);
@@ -321,6 +325,21 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+bool OtherAvatar::isJointUpdateDue() const {
+    return _framesSinceJointUpdate + 1 >= _skeletonModel->getRig().getAnimationLODInterval();
+}
+
+void OtherAvatar::computeJointPoses() {
+    PROFILE_RANGE(simulation, "computeJointPoses");
+    {
+        QReadLocker readLock(&_jointDataLock);
+        _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    }
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _jointPosesComputed = true;
+}
+
 void OtherAvatar::debugJointData() const {
     // Get a copy of the joint data
     auto jointData = getJointData();
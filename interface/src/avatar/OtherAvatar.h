@@ -64,10 +64,19 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+    // The part of simulate() that only touches this avatar's own rig, so AvatarManager can run it for many avatars
+    // in parallel first. simulate() does it itself when it wasn't.
+    bool needsJointPoses(bool inView) const {
+        return inView && (_hasNewJointData || _transit.isActive()) && isJointUpdateDue();
+    }
+    void computeJointPoses();
     void debugJointData() const;
     friend AvatarManager;
 
 protected:
+    // far avatars take the joint data at the lower rate of their rig's animation LOD
+    bool isJointUpdateDue() const;
+
     void handleChangedAvatarEntityData();
     void updateAttachedAvatarEntities();
     void onAddAttachedAvatarEntity(const QUuid& id);
@@ -91,6 +100,8 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointPosesComputed { false };
+    int _framesSinceJointUpdate { 0 };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
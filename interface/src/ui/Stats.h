@@ -52,6 +52,7 @@ private: \
  * @property {number} avatarCount - <em>Read-only.</em>
  * @property {number} heroAvatarCount - <em>Read-only.</em>
  * @property {number} physicsObjectCount - <em>Read-only.</em>
+ * @property {number} frozenPhysicsObjectCount - <em>Read-only.</em>
  * @property {number} updatedAvatarCount - <em>Read-only.</em>
  * @property {number} updatedHeroAvatarCount - <em>Read-only.</em>
  * @property {number} notUpdatedAvatarCount - <em>Read-only.</em>
@@ -216,6 +217,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, frozenPhysicsObjectCount, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
@@ -454,6 +456,13 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>frozenPhysicsObjectCount</code> property changes.
+     * @function Stats.frozenPhysicsObjectCountChanged
+     * @returns {Signal}
+     */
+    void frozenPhysicsObjectCountChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>avatarCount</code> property changes.
      * @function Stats.avatarCountChanged
@@ -52,10 +52,10 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_clip && _clip->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorClip) {
             buildMirrorAnim();
         }
 
@@ -69,15 +69,20 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _clip->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
+        const auto& clip = _mirrorFlag ? _mirrorClip : _clip;
+        if (prevIndex == nextIndex) {
+            clip->decode(prevIndex, _poses);
+        } else {
+            clip->decode(prevIndex, _prevPoses);
+            clip->decode(nextIndex, _nextPoses);
+            float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+            ::blend(_poses.size(), &_prevPoses[0], &_nextPoses[0], alpha, &_poses[0]);
+        }
     }
 
     processOutputJoints(triggersOut);
@@ -123,12 +128,10 @@ static std::vector<int> buildJointIndexMap(const AnimSkeleton& dstSkeleton, cons
 #define ASSERT assert
 #endif
 
-void AnimClip::copyFromNetworkAnim() {
-    assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
+// the frames of the animation, retargeted to the avatar's skeleton
+static std::vector<AnimPoseVec> retargetAnimation(const HFMModel& animModel, const AnimSkeleton::ConstPointer& avatarSkeleton) {
+    std::vector<AnimPoseVec> anim;
 
-    auto avatarSkeleton = getSkeleton();
-    const HFMModel& animModel = _networkAnim->getHFMModel();
     AnimSkeleton animSkeleton(animModel);
     const int animJointCount = animSkeleton.getNumJoints();
     const int avatarJointCount = avatarSkeleton->getNumJoints();
@@ -137,7 +140,7 @@ void AnimClip::copyFromNetworkAnim() {
     std::vector<int> avatarToAnimJointIndexMap = buildJointIndexMap(animSkeleton, *avatarSkeleton);
 
     const int animFrameCount = animModel.animationFrames.size();
-    _anim.resize(animFrameCount);
+    anim.resize(animFrameCount);
 
     // find the size scale factor for translation in the animation.
     float boneLengthScale = 1.0f;
@@ -223,8 +226,8 @@ void AnimClip::copyFromNetworkAnim() {
         // convert avatar rotations into relative frame
         avatarSkeleton->convertAbsoluteRotationsToRelative(avatarRotations);
 
-        ASSERT(frame >= 0 && frame < (int)_anim.size());
-        _anim[frame].reserve(avatarJointCount);
+        ASSERT(frame >= 0 && frame < (int)anim.size());
+        anim[frame].reserve(avatarJointCount);
         for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
             const AnimPose& avatarDefaultPose = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex);
 
@@ -251,25 +254,42 @@ void AnimClip::copyFromNetworkAnim() {
 
             // build the final pose
             ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarRotations.size());
-            _anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
+            anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
         }
     }
 
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
+    return anim;
+}
 
-    _poses.resize(avatarJointCount);
+void AnimClip::copyFromNetworkAnim() {
+    assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
+
+    auto networkAnim = _networkAnim;
+    auto avatarSkeleton = getSkeleton();
+    _clipKey = _url.toUtf8() + '\0' + avatarSkeleton->getHash();
+    _clip = DependencyManager::get<AnimationCache>()->getCompressedClip(_clipKey, [&] {
+        return std::make_shared<const AnimCompressedClip>(retargetAnimation(networkAnim->getHFMModel(), avatarSkeleton));
+    });
+
+    // mirrorClip will be found on demand, if needed.
+    _mirrorClip.reset();
+
+    _poses.resize(avatarSkeleton->getNumJoints());
 }
 
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
-
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
+    assert(_skeleton && _clip);
+
+    auto clip = _clip;
+    auto skeleton = _skeleton;
+    _mirrorClip = DependencyManager::get<AnimationCache>()->getCompressedClip(_clipKey + '\0' + "mirror", [&] {
+        std::vector<AnimPoseVec> mirrorAnim(clip->getNumFrames());
+        for (int frame = 0; frame < clip->getNumFrames(); frame++) {
+            clip->decode(frame, mirrorAnim[frame]);
+            skeleton->mirrorRelativePoses(mirrorAnim[frame]);
+        }
+        return std::make_shared<const AnimCompressedClip>(mirrorAnim);
+    });
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
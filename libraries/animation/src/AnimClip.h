@@ -67,9 +67,12 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // the frames retargeted to the skeleton, shared with the other clips playing the same animation on the same skeleton
+    AnimCompressedClip::Pointer _clip;
+    AnimCompressedClip::Pointer _mirrorClip;
+    QByteArray _clipKey;
+    AnimPoseVec _prevPoses;
+    AnimPoseVec _nextPoses;
 
     QString _url;
     float _startFrame;
@@ -0,0 +1,271 @@
+//
+//  AnimCompressedClip.cpp
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimCompressedClip.h"
+
+#include <algorithm>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+#include "AnimUtil.h"
+
+const float AnimCompressedClip::ROTATION_TOLERANCE = 0.001f;
+const float AnimCompressedClip::TRANSLATION_TOLERANCE = 0.001f;
+const float AnimCompressedClip::SCALE_TOLERANCE = 0.0001f;
+
+// the most frames between two keys, bounds the time it takes to find the keys to drop
+static const uint32_t MAX_KEY_SPAN = 64;
+static const float MAX_QUANTIZED_VEC3 = 65535.0f;
+static const float MAX_QUANTIZED_ROTATION = 32767.0f;
+
+// the frames to keep keys at, so that interpolating between them gets within the tolerance of every frame in between
+template <typename T, typename Interpolate, typename IsClose>
+static std::vector<uint32_t> findKeyFrames(const std::vector<T>& keys, Interpolate interpolate, IsClose isClose) {
+    std::vector<uint32_t> keyFrames { 0 };
+    uint32_t numFrames = (uint32_t)keys.size();
+
+    bool isConstant = true;
+    for (uint32_t i = 1; i < numFrames && isConstant; i++) {
+        isConstant = isClose(i, keys[0]);
+    }
+    if (isConstant) {
+        return keyFrames;
+    }
+
+    auto spans = [&](uint32_t start, uint32_t end) {
+        for (uint32_t i = start + 1; i < end; i++) {
+            if (!isClose(i, interpolate(keys[start], keys[end], (float)(i - start) / (float)(end - start)))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    uint32_t start = 0;
+    while (start + 1 < numFrames) {
+        uint32_t end = start + 1;
+        while (end + 1 < numFrames && end + 1 - start <= MAX_KEY_SPAN && spans(start, end + 1)) {
+            end++;
+        }
+        keyFrames.push_back(end);
+        start = end;
+    }
+    return keyFrames;
+}
+
+// the keys of a track around frame, and how far frame is between them
+static void findKeys(const std::vector<uint32_t>& keyFrames, uint32_t firstKey, uint32_t numKeys, int frame,
+                     uint32_t& key, uint32_t& nextKey, float& alpha) {
+    auto begin = keyFrames.begin() + firstKey;
+    auto end = begin + numKeys;
+    auto next = std::upper_bound(begin, end, (uint32_t)frame);
+    if (next == end) {
+        key = nextKey = firstKey + numKeys - 1;
+        alpha = 0.0f;
+        return;
+    }
+    nextKey = (uint32_t)(next - keyFrames.begin());
+    key = nextKey - 1;
+    alpha = (float)(frame - (int)keyFrames[key]) / (float)(keyFrames[nextKey] - keyFrames[key]);
+}
+
+AnimCompressedClip::AnimCompressedClip(const std::vector<AnimPoseVec>& frames) :
+    _numFrames((int)frames.size())
+{
+    int numJoints = frames.empty() ? 0 : (int)frames[0].size();
+    _scaleTracks.resize(numJoints);
+    _rotationTracks.resize(numJoints);
+    _translationTracks.resize(numJoints);
+
+    std::vector<glm::vec3> scales(_numFrames);
+    std::vector<glm::quat> rotations(_numFrames);
+    std::vector<glm::vec3> translations(_numFrames);
+    for (int joint = 0; joint < numJoints; joint++) {
+        float scaleLength = 0.0f;
+        float boneLength = 0.0f;
+        for (int frame = 0; frame < _numFrames; frame++) {
+            const AnimPose& pose = frames[frame][joint];
+            scales[frame] = pose.scale();
+            rotations[frame] = pose.rot();
+            translations[frame] = pose.trans();
+            scaleLength = std::max(scaleLength, glm::length(pose.scale()));
+            boneLength = std::max(boneLength, glm::length(pose.trans()));
+        }
+
+        compressVec3Track(scales, SCALE_TOLERANCE * scaleLength, _scaleTracks[joint], _scaleKeyFrames, _scaleKeys);
+        compressRotationTrack(rotations, _rotationTracks[joint]);
+        compressVec3Track(translations, TRANSLATION_TOLERANCE * boneLength, _translationTracks[joint],
+                          _translationKeyFrames, _translationKeys);
+    }
+
+    _scaleKeyFrames.shrink_to_fit();
+    _scaleKeys.shrink_to_fit();
+    _rotationKeyFrames.shrink_to_fit();
+    _rotationKeys.shrink_to_fit();
+    _translationKeyFrames.shrink_to_fit();
+    _translationKeys.shrink_to_fit();
+}
+
+void AnimCompressedClip::compressVec3Track(const std::vector<glm::vec3>& values, float tolerance, Vec3Track& track,
+                                           std::vector<uint32_t>& keyFrames, std::vector<QuantizedVec3>& keys) {
+    glm::vec3 minValue = values[0];
+    glm::vec3 maxValue = values[0];
+    for (const auto& value : values) {
+        minValue = glm::min(minValue, value);
+        maxValue = glm::max(maxValue, value);
+    }
+    track.min = minValue;
+    track.scale = (maxValue - minValue) / MAX_QUANTIZED_VEC3;
+
+    std::vector<QuantizedVec3> quantized;
+    std::vector<glm::vec3> dequantized;
+    quantized.reserve(values.size());
+    dequantized.reserve(values.size());
+    for (const auto& value : values) {
+        glm::vec3 steps;
+        for (int i = 0; i < 3; i++) {
+            steps[i] = track.scale[i] > 0.0f ? glm::round((value[i] - track.min[i]) / track.scale[i]) : 0.0f;
+        }
+        steps = glm::clamp(steps, glm::vec3(0.0f), glm::vec3(MAX_QUANTIZED_VEC3));
+        quantized.push_back({ (uint16_t)steps.x, (uint16_t)steps.y, (uint16_t)steps.z });
+        dequantized.push_back(dequantizeVec3(track, quantized.back()));
+    }
+
+    // the keys can't get any closer than a step
+    tolerance = std::max(tolerance, glm::length(track.scale));
+    auto trackKeyFrames = findKeyFrames(dequantized,
+        [](const glm::vec3& a, const glm::vec3& b, float alpha) {
+            return lerp(a, b, alpha);
+        },
+        [&](uint32_t frame, const glm::vec3& value) {
+            return glm::distance(values[frame], value) <= tolerance;
+        });
+
+    track.firstKey = (uint32_t)keys.size();
+    track.numKeys = (uint32_t)trackKeyFrames.size();
+    for (auto frame : trackKeyFrames) {
+        keyFrames.push_back(frame);
+        keys.push_back(quantized[frame]);
+    }
+}
+
+void AnimCompressedClip::compressRotationTrack(const std::vector<glm::quat>& values, RotationTrack& track) {
+    std::vector<QuantizedRotation> quantized;
+    std::vector<glm::quat> dequantized;
+    quantized.reserve(values.size());
+    dequantized.reserve(values.size());
+    for (const auto& value : values) {
+        quantized.push_back(quantizeRotation(value));
+        dequantized.push_back(dequantizeRotation(quantized.back()));
+    }
+
+    // the rotation between two quaternions is twice the angle between them
+    const float MIN_ABS_DOT = cosf(0.5f * ROTATION_TOLERANCE);
+    auto trackKeyFrames = findKeyFrames(dequantized,
+        [](const glm::quat& a, const glm::quat& b, float alpha) {
+            return safeLerp(a, b, alpha);
+        },
+        [&](uint32_t frame, const glm::quat& value) {
+            return fabsf(glm::dot(glm::normalize(values[frame]), value)) >= MIN_ABS_DOT;
+        });
+
+    track.firstKey = (uint32_t)_rotationKeys.size();
+    track.numKeys = (uint32_t)trackKeyFrames.size();
+    for (auto frame : trackKeyFrames) {
+        _rotationKeyFrames.push_back(frame);
+        _rotationKeys.push_back(quantized[frame]);
+    }
+}
+
+AnimCompressedClip::QuantizedRotation AnimCompressedClip::quantizeRotation(const glm::quat& rotation) {
+    glm::quat q = glm::normalize(rotation);
+    float components[4] = { q.x, q.y, q.z, q.w };
+    int largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(components[i]) > fabsf(components[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, pick the one with the largest component positive, so it can be left out
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    uint16_t smallest[3];
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != largest) {
+            // the others are within +-1/sqrt(2)
+            float unit = glm::clamp(0.5f * sign * components[i] * SQUARE_ROOT_OF_2 + 0.5f, 0.0f, 1.0f);
+            smallest[j++] = (uint16_t)(unit * MAX_QUANTIZED_ROTATION + 0.5f);
+        }
+    }
+    return { (uint16_t)(smallest[0] | ((largest & 1) << 15)), (uint16_t)(smallest[1] | ((largest >> 1) << 15)), smallest[2] };
+}
+
+glm::quat AnimCompressedClip::dequantizeRotation(const QuantizedRotation& key) {
+    int largest = (key.a >> 15) | ((key.b >> 15) << 1);
+    uint16_t smallest[3] = { (uint16_t)(key.a & 0x7fff), (uint16_t)(key.b & 0x7fff), key.c };
+
+    float components[4];
+    float lengthSquared = 0.0f;
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != largest) {
+            float unit = (float)smallest[j++] / MAX_QUANTIZED_ROTATION;
+            components[i] = (2.0f * unit - 1.0f) / SQUARE_ROOT_OF_2;
+            lengthSquared += components[i] * components[i];
+        }
+    }
+    components[largest] = sqrtf(std::max(0.0f, 1.0f - lengthSquared));
+    return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+glm::vec3 AnimCompressedClip::dequantizeVec3(const Vec3Track& track, const QuantizedVec3& key) {
+    return track.min + track.scale * glm::vec3(key.x, key.y, key.z);
+}
+
+glm::vec3 AnimCompressedClip::sampleVec3Track(const Vec3Track& track, const std::vector<uint32_t>& keyFrames,
+                                              const std::vector<QuantizedVec3>& keys, int frame) {
+    if (track.numKeys == 1) {
+        return dequantizeVec3(track, keys[track.firstKey]);
+    }
+    uint32_t key, nextKey;
+    float alpha;
+    findKeys(keyFrames, track.firstKey, track.numKeys, frame, key, nextKey, alpha);
+    return lerp(dequantizeVec3(track, keys[key]), dequantizeVec3(track, keys[nextKey]), alpha);
+}
+
+glm::quat AnimCompressedClip::sampleRotationTrack(const RotationTrack& track, int frame) const {
+    if (track.numKeys == 1) {
+        return dequantizeRotation(_rotationKeys[track.firstKey]);
+    }
+    uint32_t key, nextKey;
+    float alpha;
+    findKeys(_rotationKeyFrames, track.firstKey, track.numKeys, frame, key, nextKey, alpha);
+    return safeLerp(dequantizeRotation(_rotationKeys[key]), dequantizeRotation(_rotationKeys[nextKey]), alpha);
+}
+
+void AnimCompressedClip::decode(int frame, AnimPoseVec& poses) const {
+    frame = glm::clamp(frame, 0, std::max(0, _numFrames - 1));
+    int numJoints = getNumJoints();
+    poses.resize(numJoints);
+    for (int joint = 0; joint < numJoints; joint++) {
+        poses[joint] = AnimPose(sampleVec3Track(_scaleTracks[joint], _scaleKeyFrames, _scaleKeys, frame),
+                                sampleRotationTrack(_rotationTracks[joint], frame),
+                                sampleVec3Track(_translationTracks[joint], _translationKeyFrames, _translationKeys, frame));
+    }
+}
+
+size_t AnimCompressedClip::getMemorySize() const {
+    return sizeof(AnimCompressedClip) +
+        _scaleTracks.capacity() * sizeof(Vec3Track) +
+        _rotationTracks.capacity() * sizeof(RotationTrack) +
+        _translationTracks.capacity() * sizeof(Vec3Track) +
+        (_scaleKeyFrames.capacity() + _rotationKeyFrames.capacity() + _translationKeyFrames.capacity()) * sizeof(uint32_t) +
+        (_scaleKeys.capacity() + _translationKeys.capacity()) * sizeof(QuantizedVec3) +
+        _rotationKeys.capacity() * sizeof(QuantizedRotation);
+}
@@ -0,0 +1,86 @@
+//
+//  AnimCompressedClip.h
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimCompressedClip_h
+#define hifi_AnimCompressedClip_h
+
+#include <memory>
+#include <vector>
+
+#include "AnimPose.h"
+
+// The frames of an animation, retargeted to a skeleton, compressed. Each joint's scale, rotation and translation is
+// a track of quantized keys, and keys that the keys around them interpolate to within a tolerance are dropped.
+// Immutable once built, so every AnimClip playing the animation on the same skeleton can share it.
+class AnimCompressedClip {
+public:
+    using Pointer = std::shared_ptr<const AnimCompressedClip>;
+
+    static const float ROTATION_TOLERANCE;     // radians
+    static const float TRANSLATION_TOLERANCE;  // fraction of the length of the bone
+    static const float SCALE_TOLERANCE;        // fraction of the scale
+
+    // frames[frame][joint], all the frames need the same number of joints
+    explicit AnimCompressedClip(const std::vector<AnimPoseVec>& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_rotationTracks.size(); }
+
+    // resizes poses to the number of joints
+    void decode(int frame, AnimPoseVec& poses) const;
+
+    size_t getMemorySize() const;
+
+private:
+    // a key per component, 16 bits each, in the range of the track
+    struct Vec3Track {
+        glm::vec3 min;
+        glm::vec3 scale;  // of a step
+        uint32_t firstKey;
+        uint32_t numKeys;
+    };
+    struct RotationTrack {
+        uint32_t firstKey;
+        uint32_t numKeys;
+    };
+    // the smallest three components, 15 bits each, and the index of the largest spread over the top bits
+    struct QuantizedRotation {
+        uint16_t a, b, c;
+    };
+    struct QuantizedVec3 {
+        uint16_t x, y, z;
+    };
+
+    void compressVec3Track(const std::vector<glm::vec3>& values, float tolerance, Vec3Track& track,
+                           std::vector<uint32_t>& keyFrames, std::vector<QuantizedVec3>& keys);
+    void compressRotationTrack(const std::vector<glm::quat>& values, RotationTrack& track);
+
+    static QuantizedRotation quantizeRotation(const glm::quat& rotation);
+    static glm::quat dequantizeRotation(const QuantizedRotation& key);
+    static glm::vec3 dequantizeVec3(const Vec3Track& track, const QuantizedVec3& key);
+    static glm::vec3 sampleVec3Track(const Vec3Track& track, const std::vector<uint32_t>& keyFrames,
+                                     const std::vector<QuantizedVec3>& keys, int frame);
+    glm::quat sampleRotationTrack(const RotationTrack& track, int frame) const;
+
+    int _numFrames { 0 };
+
+    std::vector<Vec3Track> _scaleTracks;
+    std::vector<RotationTrack> _rotationTracks;
+    std::vector<Vec3Track> _translationTracks;
+
+    // the keys of all the tracks of a kind, a track at a time, with the frame of each
+    std::vector<uint32_t> _scaleKeyFrames;
+    std::vector<QuantizedVec3> _scaleKeys;
+    std::vector<uint32_t> _rotationKeyFrames;
+    std::vector<QuantizedRotation> _rotationKeys;
+    std::vector<uint32_t> _translationKeyFrames;
+    std::vector<QuantizedVec3> _translationKeys;
+};
+
+#endif // hifi_AnimCompressedClip_h
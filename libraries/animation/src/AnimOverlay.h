@@ -92,6 +92,7 @@ public:
     BoneSet _boneSet;
     float _alpha;
     std::vector<float> _boneSetVec;
+    std::vector<float> _boneAlphas;  // _boneSetVec scaled by _alpha
 
     QString _boneSetVar;
     QString _alphaVar;
@@ -0,0 +1,132 @@
+//
+//  AnimPoseBuffer.cpp
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <xmmintrin.h>
+#endif
+
+void AnimPoseBuffer::resize(size_t size) {
+    // a multiple of 4, so a component array of 4 joints never runs into the next
+    size_t stride = (size + 3) & ~(size_t)3;
+    if (stride > _stride) {
+        _data.resize(stride * NumComponents);
+        _stride = stride;
+    }
+    _size = size;
+}
+
+void AnimPoseBuffer::setPose(size_t index, const AnimPose& pose) {
+    float* data = &_data[index];
+    data[ScaleX * _stride] = pose.scale().x;
+    data[ScaleY * _stride] = pose.scale().y;
+    data[ScaleZ * _stride] = pose.scale().z;
+    data[RotX * _stride] = pose.rot().x;
+    data[RotY * _stride] = pose.rot().y;
+    data[RotZ * _stride] = pose.rot().z;
+    data[RotW * _stride] = pose.rot().w;
+    data[TransX * _stride] = pose.trans().x;
+    data[TransY * _stride] = pose.trans().y;
+    data[TransZ * _stride] = pose.trans().z;
+}
+
+AnimPose AnimPoseBuffer::getPose(size_t index) const {
+    const float* data = &_data[index];
+    return AnimPose(glm::vec3(data[ScaleX * _stride], data[ScaleY * _stride], data[ScaleZ * _stride]),
+                    glm::quat(data[RotW * _stride], data[RotX * _stride], data[RotY * _stride], data[RotZ * _stride]),
+                    glm::vec3(data[TransX * _stride], data[TransY * _stride], data[TransZ * _stride]));
+}
+
+void AnimPoseBuffer::multiplyByParents(const int* parents, size_t begin, size_t end) {
+    size_t i = begin;
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    float* sx = get(ScaleX);
+    float* sy = get(ScaleY);
+    float* sz = get(ScaleZ);
+    float* rx = get(RotX);
+    float* ry = get(RotY);
+    float* rz = get(RotZ);
+    float* rw = get(RotW);
+    float* tx = get(TransX);
+    float* ty = get(TransY);
+    float* tz = get(TransZ);
+
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    for (; i + 4 <= end; i += 4) {
+        // the parents can be anywhere in the depths before, gather them
+        const int* p = &parents[i];
+        __m128 psx = _mm_setr_ps(sx[p[0]], sx[p[1]], sx[p[2]], sx[p[3]]);
+        __m128 psy = _mm_setr_ps(sy[p[0]], sy[p[1]], sy[p[2]], sy[p[3]]);
+        __m128 psz = _mm_setr_ps(sz[p[0]], sz[p[1]], sz[p[2]], sz[p[3]]);
+        __m128 prx = _mm_setr_ps(rx[p[0]], rx[p[1]], rx[p[2]], rx[p[3]]);
+        __m128 pry = _mm_setr_ps(ry[p[0]], ry[p[1]], ry[p[2]], ry[p[3]]);
+        __m128 prz = _mm_setr_ps(rz[p[0]], rz[p[1]], rz[p[2]], rz[p[3]]);
+        __m128 prw = _mm_setr_ps(rw[p[0]], rw[p[1]], rw[p[2]], rw[p[3]]);
+        __m128 ptx = _mm_setr_ps(tx[p[0]], tx[p[1]], tx[p[2]], tx[p[3]]);
+        __m128 pty = _mm_setr_ps(ty[p[0]], ty[p[1]], ty[p[2]], ty[p[3]]);
+        __m128 ptz = _mm_setr_ps(tz[p[0]], tz[p[1]], tz[p[2]], tz[p[3]]);
+
+        __m128 csx = _mm_loadu_ps(&sx[i]);
+        __m128 csy = _mm_loadu_ps(&sy[i]);
+        __m128 csz = _mm_loadu_ps(&sz[i]);
+        __m128 crx = _mm_loadu_ps(&rx[i]);
+        __m128 cry = _mm_loadu_ps(&ry[i]);
+        __m128 crz = _mm_loadu_ps(&rz[i]);
+        __m128 crw = _mm_loadu_ps(&rw[i]);
+        __m128 ctx = _mm_loadu_ps(&tx[i]);
+        __m128 cty = _mm_loadu_ps(&ty[i]);
+        __m128 ctz = _mm_loadu_ps(&tz[i]);
+
+        // scale = parent scale * child scale
+        _mm_storeu_ps(&sx[i], _mm_mul_ps(psx, csx));
+        _mm_storeu_ps(&sy[i], _mm_mul_ps(psy, csy));
+        _mm_storeu_ps(&sz[i], _mm_mul_ps(psz, csz));
+
+        // rot = parent rot * child rot
+        __m128 qw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(prw, crw), _mm_mul_ps(prx, crx)),
+                               _mm_add_ps(_mm_mul_ps(pry, cry), _mm_mul_ps(prz, crz)));
+        __m128 qx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, crx), _mm_mul_ps(prx, crw)),
+                               _mm_sub_ps(_mm_mul_ps(pry, crz), _mm_mul_ps(prz, cry)));
+        __m128 qy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, cry), _mm_mul_ps(pry, crw)),
+                               _mm_sub_ps(_mm_mul_ps(prz, crx), _mm_mul_ps(prx, crz)));
+        __m128 qz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, crz), _mm_mul_ps(prz, crw)),
+                               _mm_sub_ps(_mm_mul_ps(prx, cry), _mm_mul_ps(pry, crx)));
+        _mm_storeu_ps(&rx[i], qx);
+        _mm_storeu_ps(&ry[i], qy);
+        _mm_storeu_ps(&rz[i], qz);
+        _mm_storeu_ps(&rw[i], qw);
+
+        // trans = parent trans + parent rot * (parent scale * child trans), rotating the way glm does
+        __m128 vx = _mm_mul_ps(psx, ctx);
+        __m128 vy = _mm_mul_ps(psy, cty);
+        __m128 vz = _mm_mul_ps(psz, ctz);
+        __m128 uvx = _mm_sub_ps(_mm_mul_ps(pry, vz), _mm_mul_ps(prz, vy));
+        __m128 uvy = _mm_sub_ps(_mm_mul_ps(prz, vx), _mm_mul_ps(prx, vz));
+        __m128 uvz = _mm_sub_ps(_mm_mul_ps(prx, vy), _mm_mul_ps(pry, vx));
+        __m128 uuvx = _mm_sub_ps(_mm_mul_ps(pry, uvz), _mm_mul_ps(prz, uvy));
+        __m128 uuvy = _mm_sub_ps(_mm_mul_ps(prz, uvx), _mm_mul_ps(prx, uvz));
+        __m128 uuvz = _mm_sub_ps(_mm_mul_ps(prx, uvy), _mm_mul_ps(pry, uvx));
+        vx = _mm_add_ps(vx, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvx, prw), uuvx), two));
+        vy = _mm_add_ps(vy, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvy, prw), uuvy), two));
+        vz = _mm_add_ps(vz, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvz, prw), uuvz), two));
+        _mm_storeu_ps(&tx[i], _mm_add_ps(ptx, vx));
+        _mm_storeu_ps(&ty[i], _mm_add_ps(pty, vy));
+        _mm_storeu_ps(&tz[i], _mm_add_ps(ptz, vz));
+    }
+#endif
+
+    for (; i < end; ++i) {
+        AnimPose parent = getPose(parents[i]);
+        AnimPose child = getPose(i);
+        setPose(i, AnimPose(parent.scale() * child.scale(), parent.rot() * child.rot(), parent.xformPoint(child.trans())));
+    }
+}
@@ -0,0 +1,54 @@
+//
+//  AnimPoseBuffer.h
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// AnimPoses stored an array per component (structure of arrays), so they can be worked on 4 joints at a time.
+// The joints are in whatever order the owner puts them in, AnimSkeleton puts them in order of depth.
+class AnimPoseBuffer {
+public:
+    enum Component {
+        ScaleX = 0,
+        ScaleY,
+        ScaleZ,
+        RotX,
+        RotY,
+        RotZ,
+        RotW,
+        TransX,
+        TransY,
+        TransZ,
+        NumComponents
+    };
+
+    void resize(size_t size);
+    size_t size() const { return _size; }
+
+    float* get(Component component) { return &_data[component * _stride]; }
+    const float* get(Component component) const { return &_data[component * _stride]; }
+
+    void setPose(size_t index, const AnimPose& pose);
+    AnimPose getPose(size_t index) const;
+
+    // pose[i] = pose[parents[i]] * pose[i] for i in [begin, end), all the parents have to be before begin.
+    // Takes the scales as uniform, the product of poses with non-uniform scales would have shear.
+    void multiplyByParents(const int* parents, size_t begin, size_t end);
+
+private:
+    size_t _size { 0 };
+    size_t _stride { 0 };
+    std::vector<float> _data;
+};
+
+#endif // hifi_AnimPoseBuffer_h
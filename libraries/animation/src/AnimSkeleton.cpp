@@ -10,6 +10,8 @@
 
 #include "AnimSkeleton.h"
 
+#include <QtCore/QCryptographicHash>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GLMHelpers.h>
@@ -133,6 +135,9 @@ AnimPose AnimSkeleton::getAbsolutePose(int jointIndex, const AnimPoseVec& relati
 void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     // poses start off relative and leave in absolute frame
     int lastIndex = std::min((int)poses.size(), _jointsSize);
+    if (lastIndex == _jointsSize && convertRelativePosesToAbsoluteByDepth(poses)) {
+        return;
+    }
     for (int i = 0; i < lastIndex; ++i) {
         int parentIndex = _parentIndices[i];
         if (parentIndex != -1) {
@@ -141,6 +146,36 @@ void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     }
 }
 
+static bool isUniformScale(const glm::vec3& scale) {
+    const float UNIFORM_SCALE_EPSILON = 0.0001f;
+    float tolerance = UNIFORM_SCALE_EPSILON * fabsf(scale.x);
+    return fabsf(scale.y - scale.x) <= tolerance && fabsf(scale.z - scale.x) <= tolerance;
+}
+
+bool AnimSkeleton::convertRelativePosesToAbsoluteByDepth(AnimPoseVec& poses) const {
+    // a skeleton can be shared by rigs being animated on different threads
+    static thread_local AnimPoseBuffer buffer;
+    buffer.resize(_jointsSize);
+    for (int i = 0; i < _jointsSize; ++i) {
+        const AnimPose& pose = poses[_depthOrder[i]];
+        if (!isUniformScale(pose.scale())) {
+            // the multiply by parent of AnimPose takes care of the shear
+            return false;
+        }
+        buffer.setPose(i, pose);
+    }
+
+    // the roots are already absolute, each depth after that only needs the depths before it
+    for (size_t depth = 1; depth + 1 < _depthOffsets.size(); ++depth) {
+        buffer.multiplyByParents(_depthOrderParents.data(), _depthOffsets[depth], _depthOffsets[depth + 1]);
+    }
+
+    for (int i = 0; i < _jointsSize; ++i) {
+        poses[_depthOrder[i]] = buffer.getPose(i);
+    }
+    return true;
+}
+
 void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
     // poses start off absolute and leave in relative frame
     int lastIndex = std::min((int)poses.size(), _jointsSize);
@@ -215,6 +250,7 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     }
 
     _jointsSize = (int)joints.size();
+    buildDepthOrder();
     // build a cache of bind poses
 
     // build a chache of default poses
@@ -294,6 +330,48 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
             _mirrorMap.push_back(i);
         }
     }
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int i = 0; i < _jointsSize; i++) {
+        hash.addData(_joints[i].name.toUtf8());
+        hash.addData("\0", 1);
+        hash.addData((const char*)&_parentIndices[i], sizeof(int));
+        hash.addData((const char*)&_relativeDefaultPoses[i], sizeof(AnimPose));
+    }
+    hash.addData((const char*)&_geometryOffset, sizeof(glm::mat4));
+    _hash = hash.result();
+}
+
+void AnimSkeleton::buildDepthOrder() {
+    std::vector<int> depths(_jointsSize, 0);
+    int maxDepth = 0;
+    for (int i = 0; i < _jointsSize; ++i) {
+        depths[i] = getChainDepth(i) - 1;
+        maxDepth = std::max(maxDepth, depths[i]);
+    }
+
+    // counting sort by depth, keeping the joints of a depth in index order
+    _depthOffsets.assign(maxDepth + 2, 0);
+    for (int i = 0; i < _jointsSize; ++i) {
+        ++_depthOffsets[depths[i] + 1];
+    }
+    for (int depth = 1; depth < (int)_depthOffsets.size(); ++depth) {
+        _depthOffsets[depth] += _depthOffsets[depth - 1];
+    }
+
+    std::vector<int> positions(_jointsSize);
+    std::vector<int> nextPositions(_depthOffsets.begin(), _depthOffsets.end() - 1);
+    _depthOrder.resize(_jointsSize);
+    for (int i = 0; i < _jointsSize; ++i) {
+        positions[i] = nextPositions[depths[i]]++;
+        _depthOrder[positions[i]] = i;
+    }
+
+    _depthOrderParents.resize(_jointsSize);
+    for (int i = 0; i < _jointsSize; ++i) {
+        int parentIndex = _parentIndices[_depthOrder[i]];
+        _depthOrderParents[i] = parentIndex == -1 ? -1 : positions[parentIndex];
+    }
 }
 
 void AnimSkeleton::dump(bool verbose) const {
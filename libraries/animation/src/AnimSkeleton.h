@@ -17,6 +17,7 @@
 
 #include <FBXSerializer.h>
 #include "AnimPose.h"
+#include "AnimPoseBuffer.h"
 
 class AnimSkeleton {
 public:
@@ -38,6 +39,9 @@ public:
     const AnimPoseVec& getAbsoluteDefaultPoses() const { return _absoluteDefaultPoses; }
     const glm::mat4& getGeometryOffset() const { return _geometryOffset; }
 
+    // the same for skeletons with the same joints and default poses, so what is built for one can be shared with the others
+    const QByteArray& getHash() const { return _hash; }
+
     // get pre transform which should include FBX pre potations
     const AnimPose& getPreRotationPose(int jointIndex) const;
 
@@ -72,10 +76,17 @@ public:
 
 protected:
     void buildSkeletonFromJoints(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets);
+    void buildDepthOrder();
+    bool convertRelativePosesToAbsoluteByDepth(AnimPoseVec& poses) const;
 
     std::vector<HFMJoint> _joints;
     std::vector<int> _parentIndices;
     int _jointsSize { 0 };
+    // the joints in order of depth in the hierarchy, so in an AnimPoseBuffer the joints of a depth are next to each
+    // other and can be made absolute 4 at a time
+    std::vector<int> _depthOrder;          // the joint at each position
+    std::vector<int> _depthOrderParents;   // the position of the parent of each position, -1 for the roots
+    std::vector<int> _depthOffsets;        // the first position of each depth, then the number of joints
     AnimPoseVec _relativeDefaultPoses;
     AnimPoseVec _absoluteDefaultPoses;
     AnimPoseVec _relativePreRotationPoses;
@@ -86,6 +97,7 @@ protected:
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
     glm::mat4 _geometryOffset;
+    QByteArray _hash;
 
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
@@ -13,17 +13,131 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <xmmintrin.h>
+
+// the kernel below treats 4 AnimPoses as 40 packed floats
+static_assert(sizeof(AnimPose) == 10 * sizeof(float), "AnimPose is not 10 packed floats");
+
+// transposes 4 poses into a register per component, 4 floats at a time, so the scale and translation
+// transposes each pick up a rotation component as well
+static inline void loadPoses(const AnimPose* poses, __m128& sx, __m128& sy, __m128& sz, __m128& rx, __m128& ry, __m128& rz,
+                             __m128& rw, __m128& tx, __m128& ty, __m128& tz) {
+    const float* p = (const float*)poses;
+    __m128 unused;
+
+    sx = _mm_loadu_ps(p + 0);
+    sy = _mm_loadu_ps(p + 10);
+    sz = _mm_loadu_ps(p + 20);
+    unused = _mm_loadu_ps(p + 30);
+    _MM_TRANSPOSE4_PS(sx, sy, sz, unused);
+
+    rx = _mm_loadu_ps(p + 3);
+    ry = _mm_loadu_ps(p + 13);
+    rz = _mm_loadu_ps(p + 23);
+    rw = _mm_loadu_ps(p + 33);
+    _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+
+    unused = _mm_loadu_ps(p + 6);
+    tx = _mm_loadu_ps(p + 16);
+    ty = _mm_loadu_ps(p + 26);
+    tz = _mm_loadu_ps(p + 36);
+    _MM_TRANSPOSE4_PS(unused, tx, ty, tz);
+}
+
+// the inverse of loadPoses, the overlapping stores put the rotation components back where they were
+static inline void storePoses(AnimPose* poses, __m128 sx, __m128 sy, __m128 sz, __m128 rx, __m128 ry, __m128 rz,
+                              __m128 rw, __m128 tx, __m128 ty, __m128 tz) {
+    float* p = (float*)poses;
+    __m128 r0 = sx, r1 = sy, r2 = sz, r3 = rx;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(p + 0, r0);
+    _mm_storeu_ps(p + 10, r1);
+    _mm_storeu_ps(p + 20, r2);
+    _mm_storeu_ps(p + 30, r3);
+
+    r0 = rw, r1 = tx, r2 = ty, r3 = tz;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(p + 6, r0);
+    _mm_storeu_ps(p + 16, r1);
+    _mm_storeu_ps(p + 26, r2);
+    _mm_storeu_ps(p + 36, r3);
+
+    r0 = rx, r1 = ry, r2 = rz, r3 = rw;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(p + 3, r0);
+    _mm_storeu_ps(p + 13, r1);
+    _mm_storeu_ps(p + 23, r2);
+    _mm_storeu_ps(p + 33, r3);
+}
+
+static inline __m128 lerp4(__m128 a, __m128 b, __m128 alpha, __m128 oneMinusAlpha) {
+    return _mm_add_ps(_mm_mul_ps(a, oneMinusAlpha), _mm_mul_ps(b, alpha));
+}
+
+// the same as blendPose below, for 4 poses, result can be a or b
+static inline void blend4(const AnimPose* a, const AnimPose* b, __m128 alpha, AnimPose* result) {
+    __m128 asx, asy, asz, arx, ary, arz, arw, atx, aty, atz;
+    __m128 bsx, bsy, bsz, brx, bry, brz, brw, btx, bty, btz;
+    loadPoses(a, asx, asy, asz, arx, ary, arz, arw, atx, aty, atz);
+    loadPoses(b, bsx, bsy, bsz, brx, bry, brz, brw, btx, bty, btz);
+
+    __m128 oneMinusAlpha = _mm_sub_ps(_mm_set1_ps(1.0f), alpha);
+
+    // safeLerp, flip b onto the same hemisphere as a
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(arx, brx), _mm_mul_ps(ary, bry)),
+                            _mm_add_ps(_mm_mul_ps(arz, brz), _mm_mul_ps(arw, brw)));
+    __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+    __m128 rx = lerp4(arx, _mm_xor_ps(brx, flip), alpha, oneMinusAlpha);
+    __m128 ry = lerp4(ary, _mm_xor_ps(bry, flip), alpha, oneMinusAlpha);
+    __m128 rz = lerp4(arz, _mm_xor_ps(brz, flip), alpha, oneMinusAlpha);
+    __m128 rw = lerp4(arw, _mm_xor_ps(brw, flip), alpha, oneMinusAlpha);
+
+    // glm::normalize, which gives the identity for zero length
+    __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                           _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw))));
+    __m128 isZero = _mm_cmple_ps(length, _mm_setzero_ps());
+    __m128 oneOverLength = _mm_andnot_ps(isZero, _mm_div_ps(_mm_set1_ps(1.0f), length));
+    rx = _mm_mul_ps(rx, oneOverLength);
+    ry = _mm_mul_ps(ry, oneOverLength);
+    rz = _mm_mul_ps(rz, oneOverLength);
+    rw = _mm_or_ps(_mm_mul_ps(rw, oneOverLength), _mm_and_ps(isZero, _mm_set1_ps(1.0f)));
+
+    storePoses(result,
+               lerp4(asx, bsx, alpha, oneMinusAlpha), lerp4(asy, bsy, alpha, oneMinusAlpha), lerp4(asz, bsz, alpha, oneMinusAlpha),
+               rx, ry, rz, rw,
+               lerp4(atx, btx, alpha, oneMinusAlpha), lerp4(aty, bty, alpha, oneMinusAlpha), lerp4(atz, btz, alpha, oneMinusAlpha));
+}
+#endif
+
+static inline void blendPose(const AnimPose& a, const AnimPose& b, float alpha, AnimPose& result) {
+    result.scale() = lerp(a.scale(), b.scale(), alpha);
+    result.rot() = safeLerp(a.rot(), b.rot(), alpha);
+    result.trans() = lerp(a.trans(), b.trans(), alpha);
+}
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
-    for (size_t i = 0; i < numPoses; i++) {
-        const AnimPose& aPose = a[i];
-        const AnimPose& bPose = b[i];
+    size_t i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    __m128 alpha4 = _mm_set1_ps(alpha);
+    for (; i + 4 <= numPoses; i += 4) {
+        blend4(&a[i], &b[i], alpha4, &result[i]);
+    }
+#endif
+    for (; i < numPoses; i++) {
+        blendPose(a[i], b[i], alpha, result[i]);
+    }
+}
 
-        result[i].scale() = lerp(aPose.scale(), bPose.scale(), alpha);
-        result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
-        result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, AnimPose* result) {
+    size_t i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    for (; i + 4 <= numPoses; i += 4) {
+        blend4(&a[i], &b[i], _mm_loadu_ps(&alphas[i]), &result[i]);
+    }
+#endif
+    for (; i < numPoses; i++) {
+        blendPose(a[i], b[i], alphas[i], result[i]);
     }
 }
 
@@ -15,6 +15,8 @@
 
 // this is where the magic happens
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
+// the same with an alpha for each pose
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, AnimPose* result);
 
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats);
 
@@ -36,6 +36,36 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+AnimCompressedClip::Pointer AnimationCache::getCompressedClip(const QByteArray& key,
+                                                              const std::function<AnimCompressedClip::Pointer()>& build) {
+    {
+        std::lock_guard<std::mutex> lock(_compressedClipsMutex);
+        auto clip = _compressedClips.value(key).lock();
+        if (clip) {
+            return clip;
+        }
+    }
+
+    // building takes a while, don't hold up the other clips
+    auto builtClip = build();
+
+    std::lock_guard<std::mutex> lock(_compressedClipsMutex);
+    auto clip = _compressedClips.value(key).lock();
+    if (clip) {
+        // built by another clip in the meantime
+        return clip;
+    }
+    for (auto it = _compressedClips.begin(); it != _compressedClips.end();) {
+        if (it.value().expired()) {
+            it = _compressedClips.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _compressedClips.insert(key, builtClip);
+    return builtClip;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
 }
@@ -12,6 +12,11 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QHash>
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -20,6 +25,8 @@
 #include <hfm/HFM.h>
 #include <ResourceCache.h>
 
+#include "AnimCompressedClip.h"
+
 class Animation;
 
 using AnimationPointer = QSharedPointer<Animation>;
@@ -33,6 +40,10 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // Animations retargeted to a skeleton and compressed, by a key naming the animation and the skeleton. Calls build
+    // to make the one for key when no clip is holding on to it. Can be called from any thread.
+    AnimCompressedClip::Pointer getCompressedClip(const QByteArray& key, const std::function<AnimCompressedClip::Pointer()>& build);
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -41,6 +52,9 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    std::mutex _compressedClipsMutex;
+    QHash<QByteArray, std::weak_ptr<const AnimCompressedClip>> _compressedClips;
+
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
@@ -59,6 +59,14 @@ const glm::vec3 DEFAULT_RIGHT_EYE_POS(-0.3f, 0.9f, 0.0f);
 const glm::vec3 DEFAULT_LEFT_EYE_POS(0.3f, 0.9f, 0.0f);
 const glm::vec3 DEFAULT_HEAD_POS(0.0f, 0.75f, 0.0f);
 
+// rigs covering less than these go down to the next animation LOD
+static const float REDUCED_ANIMATION_LOD_SCREEN_COVERAGE = 0.1f;
+static const float MINIMAL_ANIMATION_LOD_SCREEN_COVERAGE = 0.03f;
+// and only go back up once they cover this much more than that, so rigs near a threshold don't switch every frame
+static const float ANIMATION_LOD_HYSTERESIS = 1.25f;
+// frames between updates of the joints, by animation LOD
+static const int ANIMATION_LOD_INTERVALS[] = { 1, 2, 4 };
+
 static const QString LEFT_FOOT_POSITION("leftFootPosition");
 static const QString LEFT_FOOT_ROTATION("leftFootRotation");
 static const QString LEFT_FOOT_IK_POSITION_VAR("leftFootIKPositionVar");
@@ -614,6 +622,7 @@ void Rig::destroyAnimGraph() {
     _numOverrides = 0;
     _leftEyeJointChildren.clear();
     _rightEyeJointChildren.clear();
+    _fingerJoints.clear();
 }
 
 void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset) {
@@ -661,6 +670,10 @@ void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset
 
     _leftEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("LeftEye"));
     _rightEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("RightEye"));
+
+    _fingerJoints = _animSkeleton->getChildrenOfJoint(_leftHandJointIndex);
+    auto rightFingerJoints = _animSkeleton->getChildrenOfJoint(_rightHandJointIndex);
+    _fingerJoints.insert(_fingerJoints.end(), rightFingerJoints.begin(), rightFingerJoints.end());
 }
 
 void Rig::reset(const HFMModel& hfmModel) {
@@ -708,6 +721,10 @@ void Rig::reset(const HFMModel& hfmModel) {
     _leftEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("LeftEye"));
     _rightEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("RightEye"));
 
+    _fingerJoints = _animSkeleton->getChildrenOfJoint(_leftHandJointIndex);
+    auto rightFingerJoints = _animSkeleton->getChildrenOfJoint(_rightHandJointIndex);
+    _fingerJoints.insert(_fingerJoints.end(), rightFingerJoints.begin(), rightFingerJoints.end());
+
     if (!_animGraphURL.isEmpty()) {
         _animNode.reset();
         initAnimGraph(_animGraphURL);
@@ -1016,6 +1033,28 @@ void Rig::setEnableAnimations(bool enable) {
     _enabledAnimations = enable;
 }
 
+Rig::AnimationLOD Rig::computeAnimationLOD(float screenCoverage, AnimationLOD currentLOD) {
+    float minimalCoverage = MINIMAL_ANIMATION_LOD_SCREEN_COVERAGE;
+    float reducedCoverage = REDUCED_ANIMATION_LOD_SCREEN_COVERAGE;
+    if (currentLOD == AnimationLOD::Minimal) {
+        minimalCoverage *= ANIMATION_LOD_HYSTERESIS;
+    }
+    if (currentLOD != AnimationLOD::Full) {
+        reducedCoverage *= ANIMATION_LOD_HYSTERESIS;
+    }
+
+    if (screenCoverage < minimalCoverage) {
+        return AnimationLOD::Minimal;
+    } else if (screenCoverage < reducedCoverage) {
+        return AnimationLOD::Reduced;
+    }
+    return AnimationLOD::Full;
+}
+
+int Rig::getAnimationLODInterval() const {
+    return ANIMATION_LOD_INTERVALS[(int)_animationLOD];
+}
+
 AnimPose Rig::getAbsoluteDefaultPose(int index) const {
     if (_animSkeleton && index >= 0 && index < _animSkeleton->getNumJoints()) {
         return _absoluteDefaultPoses[index];
@@ -2280,17 +2319,15 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     ASSERT(_animSkeleton->getNumJoints() == (int)relativePoses.size());
 
-    absolutePosesOut.resize(relativePoses.size());
+    absolutePosesOut = relativePoses;
     AnimPose geometryToRigTransform(_geometryToRigTransform);
     for (int i = 0; i < (int)relativePoses.size(); i++) {
-        int parentIndex = _animSkeleton->getParentIndex(i);
-        if (parentIndex == -1) {
+        if (_animSkeleton->getParentIndex(i) == -1) {
             // transform all root absolute poses into rig space
             absolutePosesOut[i] = geometryToRigTransform * relativePoses[i];
-        } else {
-            absolutePosesOut[i] = absolutePosesOut[parentIndex] * relativePoses[i];
         }
     }
+    _animSkeleton->convertRelativePosesToAbsolute(absolutePosesOut);
 }
 
 int Rig::getOverrideJointCount() const {
@@ -2401,6 +2438,13 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
             _internalPoseSet._relativePoses[i].trans() = data.translation;
         }
     }
+
+    // nobody can make out the fingers of a rig that small on screen
+    if (_animationLOD == AnimationLOD::Minimal) {
+        for (auto fingerJoint : _fingerJoints) {
+            _internalPoseSet._relativePoses[fingerJoint] = relativeDefaultPoses[fingerJoint];
+        }
+    }
 }
 
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
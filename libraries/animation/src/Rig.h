@@ -224,6 +224,22 @@ public:
     void setEnableInverseKinematics(bool enable);
     void setEnableAnimations(bool enable);
 
+    // How much animation work goes into a rig driven by network joint data, lower for rigs that cover less of the screen.
+    // Below Full the joint data is applied every few frames, and Minimal also leaves the fingers relaxed. Rigs that
+    // evaluate their own anim graph, like MyAvatar's, are always Full.
+    enum class AnimationLOD {
+        Full = 0,
+        Reduced,
+        Minimal
+    };
+    // screenCoverage is the bounding radius over the distance times the tangent of half the field of view. The LOD a
+    // rig is at now is kept until the coverage is clearly past the threshold, so rigs near one don't flap between LODs.
+    static AnimationLOD computeAnimationLOD(float screenCoverage, AnimationLOD currentLOD);
+    void setAnimationLOD(AnimationLOD lod) { _animationLOD = lod; }
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+    // frames between updates of the joints at the current LOD
+    int getAnimationLODInterval() const;
+
     const glm::mat4& getGeometryToRigTransform() const { return _geometryToRigTransform; }
 
     const AnimPose& getModelOffsetPose() const { return _modelOffset; }
@@ -308,6 +324,7 @@ protected:
     int _rightEyeJointIndex { -1 };
     std::vector<int> _leftEyeJointChildren;
     std::vector<int> _rightEyeJointChildren;
+    std::vector<int> _fingerJoints;
 
     int _leftHandJointIndex { -1 };
     int _leftElbowJointIndex { -1 };
@@ -439,6 +456,8 @@ protected:
     bool _enableInverseKinematics { true };
     bool _enabledAnimations { true };
 
+    AnimationLOD _animationLOD { AnimationLOD::Full };
+
     mutable uint32_t _jointNameWarningCount { 0 };
 
     bool _enableDebugDrawIKTargets { false };
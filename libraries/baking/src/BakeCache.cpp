@@ -0,0 +1,293 @@
+//
+//  BakeCache.cpp
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeCache.h"
+
+#include <mutex>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include <AssetUtils.h>
+#include <Sha256Hasher.h>
+
+#include "ModelBakingLoggingCategory.h"
+
+const int BakeCache::BAKER_VERSION = 1;
+const qint64 BakeCache::DEFAULT_MAX_BYTES = 10LL * 1024 * 1024 * 1024;
+
+static const QString ENTRY_FILE_NAME = "entry.json";
+static const QString OUTPUT_FOLDER_NAME = "output";
+static const QString TEMPORARY_SUFFIX = ".tmp";
+// a temporary folder this old was left by an oven that died while storing
+static const qint64 STALE_TEMPORARY_MSECS = 24 * 60 * 60 * 1000;
+
+namespace {
+    std::mutex recordingMutex;
+    bool isRecording { false };
+    bool recordedUncheckableInput { false };
+    std::vector<BakeCache::Input> recordedInputs;
+}
+
+// copies the files under from into to, adding up their sizes in bytes
+static bool copyDirectory(const QString& from, const QString& to, qint64& bytes) {
+    QDir fromDir { from };
+    if (!fromDir.exists() || !QDir().mkpath(to)) {
+        return false;
+    }
+
+    QDirIterator it { from, QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories };
+    while (it.hasNext()) {
+        auto filePath = it.next();
+        auto destination = QDir(to).filePath(fromDir.relativeFilePath(filePath));
+        if (!QDir().mkpath(QFileInfo(destination).absolutePath())) {
+            return false;
+        }
+        QFile::remove(destination);
+        if (!QFile::copy(filePath, destination)) {
+            return false;
+        }
+        bytes += it.fileInfo().size();
+    }
+    return true;
+}
+
+static qint64 getDirectorySize(const QString& directory) {
+    qint64 bytes = 0;
+    QDirIterator it { directory, QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories };
+    while (it.hasNext()) {
+        it.next();
+        bytes += it.fileInfo().size();
+    }
+    return bytes;
+}
+
+BakeCache::BakeCache(const QString& directory, qint64 maxBytes) :
+    _directory(directory),
+    _maxBytes(maxBytes)
+{
+    QDir().mkpath(_directory);
+}
+
+QByteArray BakeCache::makeKey(const QString& inputPath, const QString& type, const QString& options) {
+    QByteArray inputHash;
+    if (!AssetUtils::hashFile(inputPath, inputHash)) {
+        return QByteArray();
+    }
+    return makeKeyFromHash(inputHash, type, options);
+}
+
+QByteArray BakeCache::makeKeyFromHash(const QByteArray& inputHash, const QString& type, const QString& options) {
+    if (inputHash.isEmpty()) {
+        return QByteArray();
+    }
+
+    Sha256Hasher hasher;
+    hasher.addData(QByteArray::number(BAKER_VERSION) + '\0' + type.toUtf8() + '\0' + options.toUtf8() + '\0');
+    hasher.addData(inputHash);
+    return hasher.result().toHex();
+}
+
+bool BakeCache::fetch(const QByteArray& key, const QString& outputDirectory, Result& result) {
+    QDir entryDir { QDir(_directory).filePath(key) };
+
+    QFile entryFile { entryDir.filePath(ENTRY_FILE_NAME) };
+    if (!entryFile.open(QIODevice::ReadWrite)) {
+        ++_stats.misses;
+        return false;
+    }
+    auto entry = QJsonDocument::fromJson(entryFile.readAll()).object();
+
+    // the input is part of the key, but whatever else it loaded may have changed since
+    for (const auto& value : entry["inputs"].toArray()) {
+        auto input = value.toObject();
+        QByteArray hash;
+        if (!AssetUtils::hashFile(input["path"].toString(), hash) || hash.toHex() != input["hash"].toString().toLatin1()) {
+            qCDebug(model_baking) << "Bake cache entry" << key << "is out of date," << input["path"].toString() << "changed";
+            entryFile.close();
+            entryDir.removeRecursively();
+            ++_stats.misses;
+            return false;
+        }
+    }
+
+    qint64 bytes = 0;
+    if (!copyDirectory(entryDir.filePath(OUTPUT_FOLDER_NAME), outputDirectory, bytes)) {
+        // evicted by another oven while we were copying, don't leave half of it behind
+        QDir(outputDirectory).removeRecursively();
+        QDir().mkpath(outputDirectory);
+        ++_stats.misses;
+        return false;
+    }
+
+    result.outputURL = entry["outputURL"].toString();
+    result.warnings.clear();
+    for (const auto& warning : entry["warnings"].toArray()) {
+        result.warnings << warning.toString();
+    }
+
+    // the oldest entries go first when the cache is full
+    auto now = QDateTime::currentDateTime();
+    entryFile.setFileTime(now, QFileDevice::FileModificationTime);
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        it->lastUsed = now.toMSecsSinceEpoch();
+    }
+
+    ++_stats.hits;
+    return true;
+}
+
+void BakeCache::store(const QByteArray& key, const QString& outputDirectory, const Result& result,
+                      const std::vector<Input>& inputs) {
+    loadEntries();
+
+    // put it together next to the cache and move it in once it's all there, other ovens may be looking
+    auto finalPath = QDir(_directory).filePath(key);
+    auto temporaryPath = finalPath + TEMPORARY_SUFFIX + QString::number(QCoreApplication::applicationPid());
+    QDir temporaryDir { temporaryPath };
+    temporaryDir.removeRecursively();
+
+    qint64 bytes = 0;
+    if (!copyDirectory(outputDirectory, temporaryDir.filePath(OUTPUT_FOLDER_NAME), bytes)) {
+        qCWarning(model_baking) << "Could not copy" << outputDirectory << "to the bake cache";
+        temporaryDir.removeRecursively();
+        return;
+    }
+
+    QJsonArray inputArray;
+    for (const auto& input : inputs) {
+        QJsonObject inputObject;
+        inputObject["path"] = input.filePath;
+        inputObject["hash"] = QString(input.hash.toHex());
+        inputArray.append(inputObject);
+    }
+    QJsonObject entry;
+    entry["inputs"] = inputArray;
+    entry["outputURL"] = result.outputURL;
+    entry["warnings"] = QJsonArray::fromStringList(result.warnings);
+
+    QSaveFile entryFile { temporaryDir.filePath(ENTRY_FILE_NAME) };
+    if (!entryFile.open(QIODevice::WriteOnly) || entryFile.write(QJsonDocument(entry).toJson()) == -1 || !entryFile.commit()) {
+        qCWarning(model_baking) << "Could not write a bake cache entry for" << outputDirectory;
+        temporaryDir.removeRecursively();
+        return;
+    }
+
+    // an entry for the same key replaces a stale one, the inputs it recorded changed
+    QDir(finalPath).removeRecursively();
+    if (!QDir().rename(temporaryPath, finalPath)) {
+        // another oven stored the same bake first
+        temporaryDir.removeRecursively();
+        return;
+    }
+
+    auto& cached = _entries[key];
+    _totalBytes += bytes - cached.bytes;
+    cached.bytes = bytes;
+    cached.lastUsed = QDateTime::currentMSecsSinceEpoch();
+    ++_stats.stores;
+
+    evict();
+}
+
+void BakeCache::loadEntries() {
+    if (_entriesLoaded) {
+        return;
+    }
+    _entriesLoaded = true;
+
+    auto now = QDateTime::currentMSecsSinceEpoch();
+    QDir cacheDir { _directory };
+    for (const auto& info : cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (info.fileName().contains(TEMPORARY_SUFFIX)) {
+            if (now - info.lastModified().toMSecsSinceEpoch() > STALE_TEMPORARY_MSECS) {
+                QDir(info.absoluteFilePath()).removeRecursively();
+            }
+            continue;
+        }
+
+        Entry entry;
+        entry.bytes = getDirectorySize(info.absoluteFilePath());
+        entry.lastUsed = QFileInfo(QDir(info.absoluteFilePath()).filePath(ENTRY_FILE_NAME)).lastModified().toMSecsSinceEpoch();
+        _entries.insert(info.fileName().toLatin1(), entry);
+        _totalBytes += entry.bytes;
+    }
+}
+
+void BakeCache::evict() {
+    while (_totalBytes > _maxBytes && !_entries.isEmpty()) {
+        auto oldest = _entries.begin();
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            if (it->lastUsed < oldest->lastUsed) {
+                oldest = it;
+            }
+        }
+
+        QDir(QDir(_directory).filePath(oldest.key())).removeRecursively();
+        _totalBytes -= oldest->bytes;
+        _entries.erase(oldest);
+        ++_stats.evictions;
+    }
+}
+
+void BakeCache::startRecording() {
+    std::lock_guard<std::mutex> lock { recordingMutex };
+    isRecording = true;
+    recordedUncheckableInput = false;
+    recordedInputs.clear();
+}
+
+bool BakeCache::stopRecording(std::vector<Input>& inputs) {
+    std::lock_guard<std::mutex> lock { recordingMutex };
+    isRecording = false;
+    inputs.swap(recordedInputs);
+    recordedInputs.clear();
+    return !recordedUncheckableInput;
+}
+
+void BakeCache::recordInput(const QUrl& url, const QByteArray& data) {
+    std::lock_guard<std::mutex> lock { recordingMutex };
+    if (!isRecording) {
+        return;
+    }
+    if (!url.isLocalFile()) {
+        recordedUncheckableInput = true;
+        return;
+    }
+    recordedInputs.push_back({ url.toLocalFile(), AssetUtils::hashData(data) });
+}
+
+void BakeCache::recordInput(const QUrl& url) {
+    {
+        std::lock_guard<std::mutex> lock { recordingMutex };
+        if (!isRecording) {
+            return;
+        }
+    }
+
+    QByteArray hash;
+    bool canCheck = url.isLocalFile() && AssetUtils::hashFile(url.toLocalFile(), hash);
+
+    std::lock_guard<std::mutex> lock { recordingMutex };
+    if (!canCheck) {
+        recordedUncheckableInput = true;
+        return;
+    }
+    recordedInputs.push_back({ url.toLocalFile(), hash });
+}
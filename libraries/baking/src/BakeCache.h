@@ -0,0 +1,91 @@
+//
+//  BakeCache.h
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeCache_h
+#define hifi_BakeCache_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QUrl>
+
+/// Keeps the output of finished bakes on disk under a key made from the content of the input, the baker type and
+/// options, so baking the same content again copies the output instead. The files a bake loads besides its input
+/// (textures next to a model, say) are recorded and checked again before the output is reused. Bakes that load
+/// anything from the network are not kept.
+///
+/// The cache folder can be shared by any number of oven processes.
+class BakeCache {
+public:
+    // bump whenever a baker changes what it outputs, so the outputs of older bakers are not reused
+    static const int BAKER_VERSION;
+    static const qint64 DEFAULT_MAX_BYTES;
+
+    struct Input {
+        QString filePath;
+        QByteArray hash;
+    };
+
+    /// What a bake reported besides its files
+    struct Result {
+        // the model mapping, relative to the output folder
+        QString outputURL;
+        QStringList warnings;
+    };
+
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 stores { 0 };
+        quint64 evictions { 0 };
+    };
+
+    BakeCache(const QString& directory, qint64 maxBytes = DEFAULT_MAX_BYTES);
+
+    /// The key for baking the local file at inputPath, empty if the file can't be read
+    static QByteArray makeKey(const QString& inputPath, const QString& type, const QString& options);
+    /// The key for baking content whose SHA-256 hash is already known, like an asset server asset
+    static QByteArray makeKeyFromHash(const QByteArray& inputHash, const QString& type, const QString& options);
+
+    /// Copies the output of the bake kept under key into the empty outputDirectory, if its inputs are unchanged
+    bool fetch(const QByteArray& key, const QString& outputDirectory, Result& result);
+    /// Keeps a copy of outputDirectory, which holds the output of one bake and nothing else, under key
+    void store(const QByteArray& key, const QString& outputDirectory, const Result& result, const std::vector<Input>& inputs);
+
+    const Stats& getStats() const { return _stats; }
+
+    /// Bakers report each file or URL they load while a bake is being recorded. Only one bake can be recorded at once.
+    static void startRecording();
+    /// Returns false if the bake loaded anything that can't be checked again later
+    static bool stopRecording(std::vector<Input>& inputs);
+    static void recordInput(const QUrl& url, const QByteArray& data);
+    static void recordInput(const QUrl& url);
+
+private:
+    struct Entry {
+        qint64 bytes { 0 };
+        qint64 lastUsed { 0 };
+    };
+
+    void loadEntries();
+    void evict();
+
+    QString _directory;
+    qint64 _maxBytes;
+    QHash<QByteArray, Entry> _entries;
+    qint64 _totalBytes { 0 };
+    bool _entriesLoaded { false };
+    Stats _stats;
+};
+
+#endif // hifi_BakeCache_h
@@ -17,6 +17,8 @@
 #include <SharedUtil.h>
 #include <PathUtils.h>
 
+#include "BakeCache.h"
+
 const int ASCII_CHARACTERS_UPPER_LIMIT = 126;
 
 JSBaker::JSBaker(const QUrl& jsURL, const QString& bakedOutputDir) :
@@ -51,6 +53,7 @@ void JSBaker::loadScript() {
         }
 
         _originalScript = localScript.readAll();
+        BakeCache::recordInput(_jsURL, _originalScript);
 
         emit originalScriptLoaded();
     } else {
@@ -82,6 +85,7 @@ void JSBaker::handleScriptNetworkReply() {
 
         // store the original script so it can be passed along for the bake
         _originalScript = requestReply->readAll();
+        BakeCache::recordInput(_jsURL, _originalScript);
 
         emit originalScriptLoaded();
     } else {
@@ -16,6 +16,7 @@
 #include "QJsonObject"
 #include "QJsonDocument"
 
+#include "BakeCache.h"
 #include "MaterialBakingLoggingCategory.h"
 
 #include <SharedUtil.h>
@@ -72,6 +73,7 @@ void MaterialBaker::loadMaterial() {
         _materialResource->parsedMaterials = NetworkMaterialResource::parseJSONMaterials(QJsonDocument::fromJson(_materialData.toUtf8()), QUrl());
     } else {
         qCDebug(material_baking) << "Downloading material" << _materialData;
+        BakeCache::recordInput(QUrl(_materialData));
         _materialResource = DependencyManager::get<MaterialCache>()->getMaterial(_materialData);
     }
 
@@ -41,6 +41,7 @@
 #endif
 
 #include "baking/BakerLibrary.h"
+#include "BakeCache.h"
 
 #include <QJsonArray>
 
@@ -146,6 +147,7 @@ void ModelBaker::saveSourceModel() {
         }
 
         localModelURL.copy(_originalOutputModelPath);
+        BakeCache::recordInput(_modelURL);
 
         // emit our signal to start the import of the model source copy
         emit modelLoaded();
@@ -181,6 +183,7 @@ void ModelBaker::handleModelNetworkReply() {
 
         // grab the contents of the reply and make a copy in the output folder
         QFile copyOfOriginal(_originalOutputModelPath);
+        BakeCache::recordInput(_modelURL, QByteArray());
 
         qDebug(model_baking) << "Writing copy of original model file to" << _originalOutputModelPath << copyOfOriginal.fileName();
 
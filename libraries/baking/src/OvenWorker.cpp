@@ -0,0 +1,225 @@
+//
+//  OvenWorker.cpp
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OvenWorker.h"
+
+#include <mutex>
+
+#include <QtCore/QJsonDocument>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "ModelBakingLoggingCategory.h"
+
+static const int LOW_PRIORITY_OVEN_NICENESS = 10;
+
+static const int OVEN_KILL_TIMEOUT_MSECS = 5000;
+
+namespace {
+
+class OvenProcess : public QProcess {
+public:
+    OvenProcess(qint64 memoryLimit, bool lowPriority) : _memoryLimit(memoryLimit), _lowPriority(lowPriority) {}
+
+protected:
+    // runs in the child between fork and exec
+    void setupChildProcess() override {
+#ifdef Q_OS_UNIX
+        if (_memoryLimit > 0) {
+            struct rlimit limit;
+            limit.rlim_cur = (rlim_t)_memoryLimit;
+            limit.rlim_max = (rlim_t)_memoryLimit;
+            setrlimit(RLIMIT_AS, &limit);
+        }
+        if (_lowPriority && nice(LOW_PRIORITY_OVEN_NICENESS) == -1) {
+            // not being able to lower our priority is no reason not to bake
+        }
+#endif
+    }
+
+private:
+    const qint64 _memoryLimit;
+    const bool _lowPriority;
+};
+
+}
+
+std::once_flag registerMetaTypesFlag;
+
+OvenWorker::OvenWorker(const Options& options, QObject* parent) :
+    QObject(parent),
+    _options(options),
+    _timeoutTimer(this)
+{
+    std::call_once(registerMetaTypesFlag, []() {
+        qRegisterMetaType<QProcess::ProcessError>("QProcess::ProcessError");
+        qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
+    });
+
+    _timeoutTimer.setSingleShot(true);
+    connect(&_timeoutTimer, &QTimer::timeout, this, &OvenWorker::handleTimeout);
+}
+
+OvenWorker::~OvenWorker() {
+    if (_process) {
+        _process->disconnect(this);
+        _process->kill();
+        _process->waitForFinished(OVEN_KILL_TIMEOUT_MSECS);
+    }
+}
+
+void OvenWorker::startProcess() {
+    _process.reset(new OvenProcess(_options.memoryLimit, _options.lowPriority));
+    _bakesByProcess = 0;
+
+    // the oven logs to stderr and only writes its results to stdout, we only want the results
+    _process->setStandardErrorFile(QProcess::nullDevice());
+
+    connect(_process.get(), &QProcess::readyReadStandardOutput, this, &OvenWorker::handleReadyRead);
+    connect(_process.get(), static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &OvenWorker::handleProcessFinished);
+    connect(_process.get(), &QProcess::errorOccurred, this, &OvenWorker::handleProcessError);
+
+    QStringList arguments { "--worker" };
+    arguments << _options.arguments;
+    qCDebug(model_baking) << "Starting oven worker:" << _options.ovenPath << arguments;
+    _process->start(_options.ovenPath, arguments, QIODevice::ReadWrite);
+}
+
+void OvenWorker::releaseProcess() {
+    if (!_process) {
+        return;
+    }
+
+    auto process = _process.release();
+    process->disconnect(this);
+    if (process->state() == QProcess::NotRunning) {
+        process->deleteLater();
+    } else {
+        connect(process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                process, &QObject::deleteLater);
+        // closing its stdin is how an oven worker is asked to exit
+        process->closeWriteChannel();
+    }
+}
+
+void OvenWorker::bake(const QJsonObject& job, int timeoutMsecs) {
+    Q_ASSERT(!_isBaking);
+
+    if (!_process) {
+        startProcess();
+    }
+
+    _isBaking = true;
+    _wasAborted = false;
+    _timedOut = false;
+    _details = QJsonObject();
+
+    _process->write(QJsonDocument(job).toJson(QJsonDocument::Compact) + "\n");
+
+    if (timeoutMsecs > 0) {
+        _timeoutTimer.start(timeoutMsecs);
+    }
+}
+
+void OvenWorker::abort() {
+    if (!_process) {
+        return;
+    }
+
+    _wasAborted = _isBaking;
+    _process->kill();
+    // finished is emitted from in here, which reports the bake
+    _process->waitForFinished(OVEN_KILL_TIMEOUT_MSECS);
+    releaseProcess();
+}
+
+void OvenWorker::finishBake() {
+    _isBaking = false;
+    _timeoutTimer.stop();
+}
+
+void OvenWorker::handleReadyRead() {
+    while (_process && _process->canReadLine()) {
+        auto line = _process->readLine().trimmed();
+        if (!_isBaking) {
+            continue;
+        }
+
+        if (line.startsWith(OVEN_WORKER_DETAILS_PREFIX.toUtf8())) {
+            _details = QJsonDocument::fromJson(line.mid(OVEN_WORKER_DETAILS_PREFIX.size())).object();
+            continue;
+        }
+        if (!line.startsWith(OVEN_WORKER_RESULT_PREFIX.toUtf8())) {
+            continue;
+        }
+
+        bool ok;
+        int statusCode = line.mid(OVEN_WORKER_RESULT_PREFIX.size()).toInt(&ok);
+        if (!ok) {
+            statusCode = OVEN_STATUS_CODE_FAIL;
+        }
+
+        finishBake();
+        if (_options.maxBakesPerProcess > 0 && ++_bakesByProcess >= _options.maxBakesPerProcess) {
+            releaseProcess();
+        }
+
+        emit bakeFinished(statusCode, _details);
+    }
+}
+
+void OvenWorker::handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus) {
+    qCDebug(model_baking) << "Oven worker exited:" << exitCode << exitStatus;
+
+    releaseProcess();
+
+    if (!_isBaking) {
+        // an idle oven going away is only a problem for the next bake, which will start a new one
+        return;
+    }
+    finishBake();
+
+    if (_wasAborted) {
+        emit bakeFinished(OVEN_STATUS_CODE_ABORT, QJsonObject());
+    } else if (_timedOut) {
+        emit bakeCrashed("Baking took too long", true);
+    } else if (exitStatus == QProcess::CrashExit) {
+        emit bakeCrashed("Fatal error occurred while baking", false);
+    } else {
+        emit bakeCrashed("Oven exited unexpectedly with code " + QString::number(exitCode), false);
+    }
+}
+
+void OvenWorker::handleProcessError(QProcess::ProcessError error) {
+    // the other errors are followed by finished, which is where they are reported
+    if (error != QProcess::FailedToStart) {
+        return;
+    }
+
+    qCWarning(model_baking) << "Oven worker failed to start -" << _process->errorString();
+    releaseProcess();
+
+    if (_isBaking) {
+        finishBake();
+        emit bakeCrashed("Oven process failed to start", false);
+    }
+}
+
+void OvenWorker::handleTimeout() {
+    if (_isBaking && _process) {
+        qCWarning(model_baking) << "Killing oven worker that has been baking for" << _timeoutTimer.interval() << "ms";
+        _timedOut = true;
+        _process->kill();
+    }
+}
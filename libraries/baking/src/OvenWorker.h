@@ -0,0 +1,82 @@
+//
+//  OvenWorker.h
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OvenWorker_h
+#define hifi_OvenWorker_h
+
+#include <memory>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+
+#include "OvenWorkerProtocol.h"
+
+/// A long running oven process, started with --worker, that bakes one job at a time. The process is started on the
+/// first bake, kept warm between bakes and replaced after it dies, times out or has baked its share of jobs.
+class OvenWorker : public QObject {
+    Q_OBJECT
+public:
+    struct Options {
+        QString ovenPath;
+        // passed to the oven along with --worker
+        QStringList arguments;
+        // caps the address space of the oven process in bytes, 0 for no limit. Only enforced on Unix.
+        qint64 memoryLimit { 0 };
+        // runs the oven niced, so it doesn't compete with its parent for the CPU. Only on Unix.
+        bool lowPriority { false };
+        // the oven process is replaced after this many bakes, so whatever it leaks doesn't build up forever. 0 for never.
+        int maxBakesPerProcess { 0 };
+    };
+
+    OvenWorker(const Options& options, QObject* parent = nullptr);
+    ~OvenWorker();
+
+    bool isBaking() const { return _isBaking; }
+
+    /// Hands the job, as described by BakerCLI::runWorker, to the oven process, starting one if need be. The worker
+    /// must not be baking already.
+    void bake(const QJsonObject& job, int timeoutMsecs);
+
+    /// Kills the oven process and waits for it, a running bake is reported as aborted
+    void abort();
+
+signals:
+    /// The oven finished the bake and reported one of the OVEN_STATUS_CODEs, with the details it wrote before the result
+    void bakeFinished(int statusCode, QJsonObject details);
+    /// The oven process died or was killed for taking too long before it finished the bake
+    void bakeCrashed(QString reason, bool timedOut);
+
+private slots:
+    void handleReadyRead();
+    void handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void handleProcessError(QProcess::ProcessError error);
+    void handleTimeout();
+
+private:
+    void startProcess();
+    /// Lets go of the current process, it is deleted once it has exited
+    void releaseProcess();
+    void finishBake();
+
+    const Options _options;
+    std::unique_ptr<QProcess> _process;
+    QTimer _timeoutTimer;
+
+    bool _isBaking { false };
+    bool _wasAborted { false };
+    bool _timedOut { false };
+    QJsonObject _details;
+    int _bakesByProcess { 0 };
+};
+
+#endif // hifi_OvenWorker_h
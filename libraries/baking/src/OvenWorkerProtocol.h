@@ -0,0 +1,32 @@
+//
+//  OvenWorkerProtocol.h
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  What the oven reports back to the processes that run it
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OvenWorkerProtocol_h
+#define hifi_OvenWorkerProtocol_h
+
+#include <QtCore/QString>
+
+// the exit code of a single bake, and the status code of each bake in worker mode
+static const int OVEN_STATUS_CODE_SUCCESS { 0 };
+static const int OVEN_STATUS_CODE_FAIL { 1 };
+static const int OVEN_STATUS_CODE_ABORT { 2 };
+
+// written to the output folder of a failed bake
+static const QString OVEN_ERROR_FILENAME = "errors.txt";
+
+// written on stdout in worker mode, followed by the status code, once a bake is done
+static const QString OVEN_WORKER_RESULT_PREFIX = "OVEN_WORKER_RESULT:";
+// written on stdout in worker mode just before the result, followed by a JSON object with the output and errors of the bake
+// and whether it came from the bake cache
+static const QString OVEN_WORKER_DETAILS_PREFIX = "OVEN_WORKER_DETAILS:";
+
+#endif // hifi_OvenWorkerProtocol_h
@@ -24,6 +24,7 @@
 
 #include <OwningBuffer.h>
 
+#include "BakeCache.h"
 #include "ModelBakingLoggingCategory.h"
 
 const QString BAKED_TEXTURE_KTX_EXT = ".ktx";
@@ -88,6 +89,7 @@ void TextureBaker::loadTexture() {
         }
 
         _originalTexture = localTexture.readAll();
+        BakeCache::recordInput(_textureURL, _originalTexture);
 
         emit originalTextureLoaded();
     } else {
@@ -119,6 +121,7 @@ void TextureBaker::handleTextureNetworkReply() {
 
         // store the original texture so it can be passed along for the bake
         _originalTexture = requestReply->readAll();
+        BakeCache::recordInput(_textureURL, _originalTexture);
 
         emit originalTextureLoaded();
     } else {
@@ -0,0 +1,240 @@
+//
+//  EntityCache.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityCache.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtScript/QScriptEngine>
+
+#include <Gzip.h>
+#include <NodeList.h>
+#include <SettingHandle.h>
+#include <VariantMapToScriptValue.h>
+
+#include "EntitiesLogging.h"
+#include "EntityItemProperties.h"
+
+using File = cache::File;
+
+// Whenever a change is made to the serialized format for the entity cache that isn't backward compatible,
+// this value should be incremented.  This will force the entity cache to be wiped
+const int EntityCache::CURRENT_VERSION = 0x01;
+const int EntityCache::INVALID_VERSION = 0x00;
+const char* EntityCache::SETTING_VERSION_NAME = "hifi.entity.cache_version";
+
+static const QString ENTITY_DATA_VERSION_KEY = "EntityDataVersion";
+static const QString ENTITIES_KEY = "Entities";
+static const QString LAST_EDITED_KEY = "cachedLastEdited";
+static const QString REMOTE_LAST_EDITED_KEY = "cachedLastEditedInRemoteTime";
+
+static std::string domainKey(const QUuid& domainID) {
+    return domainID.toString(QUuid::WithoutBraces).toStdString();
+}
+
+EntityCache::EntityCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext)
+{
+    // one job at a time keeps loads ordered after the saves started before them
+    _workerPool.setMaxThreadCount(1);
+}
+
+void EntityCache::initialize() {
+    FileCache::initialize();
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set(CURRENT_VERSION);
+    }
+}
+
+std::unique_ptr<File> EntityCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCDebug(entities) << "Wrote entity cache" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
+
+void EntityCache::saveDomain(const QUuid& domainID, const EntityTreePointer& tree) {
+    if (domainID.isNull() || !tree) {
+        return;
+    }
+
+    CachedEntities cachedEntities;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+                // only what the entity server sent us is worth keeping, and only if it hasn't been edited here since
+                quint64 lastEditedInRemoteTime = entity->getLastEditedFromRemoteInRemoteTime();
+                if (!entity->isDomainEntity() || lastEditedInRemoteTime == 0 ||
+                    entity->getLastEdited() > entity->getLastEditedFromRemote()) {
+                    return;
+                }
+                cachedEntities.push_back({ entity->getEntityItemID(), entity->getProperties(), entity->getLastEdited(),
+                                           lastEditedInRemoteTime });
+            });
+            return true;
+        });
+    });
+
+    if (cachedEntities.empty()) {
+        return;
+    }
+
+    QtConcurrent::run(&_workerPool, [this, domainID, cachedEntities] {
+        writeDomain(domainID, cachedEntities);
+    });
+}
+
+void EntityCache::writeDomain(const QUuid& domainID, const CachedEntities& cachedEntities) {
+    QScriptEngine scriptEngine;
+    QVariantList entitiesList;
+    for (const auto& cachedEntity : cachedEntities) {
+        QVariantMap entityMap = EntityItemPropertiesToScriptValue(&scriptEngine, cachedEntity.properties).toVariant().toMap();
+        entityMap[LAST_EDITED_KEY] = QString::number(cachedEntity.lastEdited);
+        entityMap[REMOTE_LAST_EDITED_KEY] = QString::number(cachedEntity.lastEditedInRemoteTime);
+        entitiesList << entityMap;
+    }
+
+    QVariantMap cacheMap;
+    cacheMap[ENTITY_DATA_VERSION_KEY] = (int)versionForPacketType(PacketType::EntityData);
+    cacheMap[ENTITIES_KEY] = entitiesList;
+
+    QByteArray compressed;
+    if (!gzip(QJsonDocument::fromVariant(cacheMap).toJson(QJsonDocument::Compact), compressed)) {
+        qCWarning(entities) << "Failed to compress entity cache for domain" << domainID;
+        return;
+    }
+
+    auto file = writeFile(compressed.constData(), Metadata(domainKey(domainID), compressed.size()), true);
+    if (!file) {
+        return;
+    }
+
+    qCDebug(entities) << "Cached" << entitiesList.size() << "entities for domain" << domainID;
+}
+
+QFuture<EntityCache::CachedEntities> EntityCache::loadDomain(const QUuid& domainID) {
+    return QtConcurrent::run(&_workerPool, [this, domainID] {
+        return readDomain(domainID);
+    });
+}
+
+EntityCache::CachedEntities EntityCache::readDomain(const QUuid& domainID) {
+    CachedEntities cachedEntities;
+
+    auto file = getFile(domainKey(domainID));
+    if (!file) {
+        return cachedEntities;
+    }
+
+    QByteArray compressed;
+    {
+        QFile cacheFile(QString::fromStdString(file->getFilepath()));
+        if (!cacheFile.open(QIODevice::ReadOnly)) {
+            qCWarning(entities) << "Failed to open entity cache for domain" << domainID;
+            return cachedEntities;
+        }
+        compressed = cacheFile.readAll();
+    }
+
+    QByteArray json;
+    if (!gunzip(compressed, json)) {
+        qCWarning(entities) << "Failed to decompress entity cache for domain" << domainID;
+        return cachedEntities;
+    }
+
+    QVariantMap cacheMap = QJsonDocument::fromJson(json).toVariant().toMap();
+    if (cacheMap[ENTITY_DATA_VERSION_KEY].toInt() != (int)versionForPacketType(PacketType::EntityData)) {
+        // the entity server will send us everything in its current format anyway
+        qCDebug(entities) << "Ignoring entity cache for domain" << domainID << "from an older entity data version";
+        return cachedEntities;
+    }
+
+    QScriptEngine scriptEngine;
+    quint64 now = usecTimestampNow();
+    QVariantList entitiesList = cacheMap[ENTITIES_KEY].toList();
+    cachedEntities.reserve(entitiesList.size());
+    for (const auto& entityVariant : entitiesList) {
+        QVariantMap entityMap = entityVariant.toMap();
+        CachedEntity cachedEntity;
+        cachedEntity.entityID = EntityItemID(QUuid(entityMap["id"].toString()));
+        if (cachedEntity.entityID.isNull()) {
+            continue;
+        }
+
+        cachedEntity.lastEdited = std::min(entityMap.take(LAST_EDITED_KEY).toString().toULongLong(), now);
+        cachedEntity.lastEditedInRemoteTime = entityMap.take(REMOTE_LAST_EDITED_KEY).toString().toULongLong();
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(variantMapToScriptValue(entityMap, scriptEngine), cachedEntity.properties);
+        cachedEntities.push_back(std::move(cachedEntity));
+    }
+
+    qCDebug(entities) << "Read" << cachedEntities.size() << "cached entities for domain" << domainID;
+    return cachedEntities;
+}
+
+int EntityCache::restoreEntities(const CachedEntities& cachedEntities, const EntityTreePointer& tree) {
+    if (!tree) {
+        return 0;
+    }
+
+    int restored = 0;
+    tree->withWriteLock([&] {
+        for (const auto& cachedEntity : cachedEntities) {
+            if (tree->findEntityByEntityItemID(cachedEntity.entityID)) {
+                continue;
+            }
+
+            auto entity = tree->addCachedEntity(cachedEntity.entityID, cachedEntity.properties);
+            if (entity) {
+                entity->restoreCachedEditTimes(cachedEntity.lastEdited, cachedEntity.lastEditedInRemoteTime);
+                ++restored;
+            }
+        }
+    });
+
+    qCDebug(entities) << "Restored" << restored << "of" << cachedEntities.size() << "cached entities";
+    return restored;
+}
+
+EntityCache::Manifest EntityCache::buildManifest(const EntityTreePointer& tree) {
+    Manifest manifest;
+    if (!tree) {
+        return manifest;
+    }
+
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+                quint64 lastEditedInRemoteTime = entity->getLastEditedFromRemoteInRemoteTime();
+                if (entity->isDomainEntity() && lastEditedInRemoteTime != 0) {
+                    manifest.insert(entity->getEntityItemID(), lastEditedInRemoteTime);
+                }
+            });
+            return true;
+        });
+    });
+    return manifest;
+}
+
+void EntityCache::sendManifest(const Manifest& manifest, const QUuid& resumeToken, const SharedNodePointer& entityServer) {
+    if (!entityServer) {
+        return;
+    }
+
+    auto packetList = NLPacketList::create(PacketType::EntityCacheManifest, QByteArray(), true, true);
+    packetList->write(resumeToken.toRfc4122());
+    packetList->writePrimitive((quint32)manifest.size());
+    for (auto itr = manifest.cbegin(); itr != manifest.cend(); ++itr) {
+        packetList->write(itr.key().toRfc4122());
+        packetList->writePrimitive(itr.value());
+    }
+    DependencyManager::get<NodeList>()->sendPacketList(std::move(packetList), *entityServer);
+}
@@ -0,0 +1,85 @@
+//
+//  EntityCache.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityCache_h
+#define hifi_EntityCache_h
+
+#include <vector>
+
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QThreadPool>
+#include <QtCore/QUuid>
+
+#include <Node.h>
+#include <shared/FileCache.h>
+
+#include "EntityTree.h"
+
+/// On-disk cache of the domain entities a client received, one file per domain. On reconnecting the client restores
+/// its cached entities and sends the entity server a manifest of the versions it holds, so only entities that changed
+/// since the last visit are streamed down again. Serialization and disk I/O happen on the cache's own worker thread,
+/// one job at a time, so a load always sees the save that was started before it.
+class EntityCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format for the entity cache that isn't backward compatible,
+    // this value should be incremented.  This will force the entity cache to be wiped
+    static const int CURRENT_VERSION;
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+
+    // entity ID -> last edited time of the version we hold, in the entity server's time frame
+    using Manifest = QHash<QUuid, quint64>;
+
+    struct CachedEntity {
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        quint64 lastEdited { 0 };
+        quint64 lastEditedInRemoteTime { 0 };
+    };
+    using CachedEntities = std::vector<CachedEntity>;
+
+    EntityCache(const std::string& dir, const std::string& ext);
+
+    void initialize() override;
+
+    /// Collects the domain entities in tree that came from the entity server, then writes them to the cache for
+    /// domainID on the worker thread.
+    void saveDomain(const QUuid& domainID, const EntityTreePointer& tree);
+
+    /// Reads the cached entities for domainID on the worker thread. Hand the result to restoreEntities.
+    QFuture<CachedEntities> loadDomain(const QUuid& domainID);
+
+    /// Blocks until the saves and loads that were started have finished, for when the cache is about to go away.
+    void waitForDone() { _workerPool.waitForDone(); }
+
+    /// Adds the cached entities to tree, skipping any it already has. Returns the number restored.
+    static int restoreEntities(const CachedEntities& cachedEntities, const EntityTreePointer& tree);
+
+    /// The versions of the domain entities tree currently holds.
+    static Manifest buildManifest(const EntityTreePointer& tree);
+    /// Sends manifest to the entity server, tagged with the resume token of the query it goes along with.
+    static void sendManifest(const Manifest& manifest, const QUuid& resumeToken, const SharedNodePointer& entityServer);
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+
+private:
+    void writeDomain(const QUuid& domainID, const CachedEntities& cachedEntities);
+    CachedEntities readDomain(const QUuid& domainID);
+
+    QThreadPool _workerPool;
+};
+
+using EntityCachePointer = std::shared_ptr<EntityCache>;
+
+#endif // hifi_EntityCache_h
@@ -14,6 +14,47 @@
 #include <QUrl>
 
 #include <ResourceManager.h>
+#include <SharedUtil.h>
+
+void EntityEditFilters::FilterStats::trackCall(quint64 callUsecs, bool wasRejected) {
+    calls++;
+    if (wasRejected) {
+        rejected++;
+    }
+    totalUsecs += callUsecs;
+    quint64 previousMax = maxUsecs.load();
+    while (callUsecs > previousMax && !maxUsecs.compare_exchange_weak(previousMax, callUsecs)) {
+    }
+}
+
+QJsonObject EntityEditFilters::FilterStats::toJson() const {
+    QJsonObject result;
+    quint64 numCalls = calls.load();
+    result["calls"] = (double)numCalls;
+    result["skipped"] = (double)skipped.load();
+    result["rejected"] = (double)rejected.load();
+    result["avgCallUsecs"] = numCalls > 0 ? (double)totalUsecs.load() / numCalls : 0.0;
+    result["maxCallUsecs"] = (double)maxUsecs.load();
+    return result;
+}
+
+bool EntityEditFilters::FilterData::isInterestedIn(const EntityPropertyFlags& changedProperties) const {
+    if (wantsAllProperties) {
+        return true;
+    }
+    if (includedFilterProperties.isEmpty() || changedProperties.isEmpty()) {
+        return false;
+    }
+    int first = std::max((int)includedFilterProperties.firstFlag(), (int)changedProperties.firstFlag());
+    int last = std::min((int)includedFilterProperties.lastFlag(), (int)changedProperties.lastFlag());
+    for (int flag = first; flag <= last; flag++) {
+        if (includedFilterProperties.getHasProperty((EntityPropertyList)flag) &&
+            changedProperties.getHasProperty((EntityPropertyList)flag)) {
+            return true;
+        }
+    }
+    return false;
+}
 
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
@@ -72,106 +113,145 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
-            auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
-            propertiesIn.setDesiredProperties(specifiedProperties);
-            QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
-            propertiesIn.setDesiredProperties(oldProperties);
 
-            auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
+            // skip the script entirely if none of the properties it asked to see were changed
+            if ((filterType == EntityTree::FilterType::Edit || filterType == EntityTree::FilterType::Physics) &&
+                !filterData.isInterestedIn(specifiedProperties)) {
+                // the outer zones and the global filter still get their say
+                filterData.stats->skipped++;
+                continue;
+            }
 
-            QScriptValueList args;
-            args << inputValues;
-            args << filterType;
+            quint64 startCall = usecTimestampNow();
+            bool accepted = callFilter(*filterData.engine, filterData, id, propertiesIn, propertiesOut, wasChanged,
+                                       filterType, existingEntity);
+            filterData.stats->trackCall(usecTimestampNow() - startCall, !accepted);
 
-            // get the current properties for then entity and include them for the filter call
-            if (existingEntity && filterData.wantsOriginalProperties) {
-                auto currentProperties = existingEntity->getProperties(filterData.includedOriginalProperties);
-                QScriptValue currentValues = currentProperties.copyToScriptValue(filterData.engine, false, true, true);
-                args << currentValues;
+            if (!accepted) {
+                return false;
             }
+        }
+    }
+    // if we made it here, 
+    return true;
+}
 
+bool EntityEditFilters::callFilter(FilterEngine& filterEngine, const FilterData& filterData, const EntityItemID& id,
+        EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged,
+        EntityTree::FilterType filterType, EntityItemPointer& existingEntity) {
+    QScriptEngine* engine = filterEngine.engine;
 
-            // get the zone properties
-            if (filterData.wantsZoneProperties) {
-                auto zoneEntity = _tree->findEntityByEntityItemID(id);
-                if (zoneEntity) {
-                    auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
-                    QScriptValue zoneValues = zoneProperties.copyToScriptValue(filterData.engine, false, true, true);
-
-                    if (filterData.wantsZoneBoundingBox) {
-                        bool success = true;
-                        AABox aaBox = zoneEntity->getAABox(success);
-                        if (success) {
-                            QScriptValue boundingBox = filterData.engine->newObject();
-                            QScriptValue bottomRightNear = vec3ToScriptValue(filterData.engine, aaBox.getCorner());
-                            QScriptValue topFarLeft = vec3ToScriptValue(filterData.engine, aaBox.calcTopFarLeft());
-                            QScriptValue center = vec3ToScriptValue(filterData.engine, aaBox.calcCenter());
-                            QScriptValue boundingBoxDimensions = vec3ToScriptValue(filterData.engine, aaBox.getDimensions());
-                            boundingBox.setProperty("brn", bottomRightNear);
-                            boundingBox.setProperty("tfl", topFarLeft);
-                            boundingBox.setProperty("center", center);
-                            boundingBox.setProperty("dimensions", boundingBoxDimensions);
-                            zoneValues.setProperty("boundingBox", boundingBox);
-                        }
-                    }
+    auto oldProperties = propertiesIn.getDesiredProperties();
+    auto specifiedProperties = propertiesIn.getChangedProperties();
+    propertiesIn.setDesiredProperties(specifiedProperties);
+    QScriptValue inputValues = propertiesIn.copyToScriptValue(engine, false, true, true);
+    propertiesIn.setDesiredProperties(oldProperties);
 
-                    // If this is an add or delete, or original properties weren't requested
-                    // there won't be original properties in the args, but zone properties need
-                    // to be the fourth parameter, so we need to pad the args accordingly
-                    int EXPECTED_ARGS = 3;
-                    if (args.length() < EXPECTED_ARGS) {
-                        args << QScriptValue();
-                    }
-                    assert(args.length() == EXPECTED_ARGS); // we MUST have 3 args by now!
-                    args << zoneValues;
+    auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
+
+    QScriptValueList args;
+    args << inputValues;
+    args << filterType;
+
+    // get the current properties for then entity and include them for the filter call
+    if (existingEntity && filterData.wantsOriginalProperties) {
+        auto currentProperties = existingEntity->getProperties(filterData.includedOriginalProperties);
+        QScriptValue currentValues = currentProperties.copyToScriptValue(engine, false, true, true);
+        args << currentValues;
+    }
+
+
+    // get the zone properties
+    if (filterData.wantsZoneProperties) {
+        auto zoneEntity = _tree->findEntityByEntityItemID(id);
+        if (zoneEntity) {
+            auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
+            QScriptValue zoneValues = zoneProperties.copyToScriptValue(engine, false, true, true);
+
+            if (filterData.wantsZoneBoundingBox) {
+                bool success = true;
+                AABox aaBox = zoneEntity->getAABox(success);
+                if (success) {
+                    QScriptValue boundingBox = engine->newObject();
+                    QScriptValue bottomRightNear = vec3ToScriptValue(engine, aaBox.getCorner());
+                    QScriptValue topFarLeft = vec3ToScriptValue(engine, aaBox.calcTopFarLeft());
+                    QScriptValue center = vec3ToScriptValue(engine, aaBox.calcCenter());
+                    QScriptValue boundingBoxDimensions = vec3ToScriptValue(engine, aaBox.getDimensions());
+                    boundingBox.setProperty("brn", bottomRightNear);
+                    boundingBox.setProperty("tfl", topFarLeft);
+                    boundingBox.setProperty("center", center);
+                    boundingBox.setProperty("dimensions", boundingBoxDimensions);
+                    zoneValues.setProperty("boundingBox", boundingBox);
                 }
             }
 
-            QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
-
-            if (filterData.uncaughtExceptions()) {
-                return false;
+            // If this is an add or delete, or original properties weren't requested
+            // there won't be original properties in the args, but zone properties need
+            // to be the fourth parameter, so we need to pad the args accordingly
+            int EXPECTED_ARGS = 3;
+            if (args.length() < EXPECTED_ARGS) {
+                args << QScriptValue();
             }
+            assert(args.length() == EXPECTED_ARGS); // we MUST have 3 args by now!
+            args << zoneValues;
+        }
+    }
 
-            if (result.isObject()) {
-                // make propertiesIn reflect the changes, for next filter...
-                propertiesIn.copyFromScriptValue(result, false);
+    QScriptValue result = filterEngine.filterFn.call(filterEngine.nullObject, args);
 
-                // and update propertiesOut too.  TODO: this could be more efficient...
-                propertiesOut.copyFromScriptValue(result, false);
-                // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
-                auto out = QJsonValue::fromVariant(result.toVariant());
-                wasChanged |= (in != out);
-            } else if (result.isBool()) {
+    if (filterEngine.uncaughtExceptions()) {
+        return false;
+    }
 
-                // if the filter returned false, then it's authoritative
-                if (!result.toBool()) {
-                    return false;
-                }
+    if (result.isObject()) {
+        // make propertiesIn reflect the changes, for next filter...
+        propertiesIn.copyFromScriptValue(result, false);
 
-                // otherwise, assume it wants to pass all properties
-                propertiesOut = propertiesIn;
-                wasChanged = false;
-                
-            } else {
-                return false;
-            }
+        // and update propertiesOut too.  TODO: this could be more efficient...
+        propertiesOut.copyFromScriptValue(result, false);
+        // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
+        auto out = QJsonValue::fromVariant(result.toVariant());
+        wasChanged |= (in != out);
+    } else if (result.isBool()) {
+
+        // if the filter returned false, then it's authoritative
+        if (!result.toBool()) {
+            return false;
         }
+
+        // otherwise, assume it wants to pass all properties
+        propertiesOut = propertiesIn;
+        wasChanged = false;
+        
+    } else {
+        return false;
     }
-    // if we made it here, 
     return true;
 }
 
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
+    // the engine is released once the last in-flight filter call lets go of it
     QWriteLocker writeLock(&_lock);
-    FilterData filterData = _filterDataMap.value(entityID);
-    if (filterData.valid()) {
-        delete filterData.engine;
-    }
     _filterDataMap.remove(entityID);
 }
 
+QJsonObject EntityEditFilters::getFilterStats() {
+    QJsonObject result;
+    QReadLocker readLock(&_lock);
+    for (auto itr = _filterDataMap.cbegin(); itr != _filterDataMap.cend(); ++itr) {
+        const FilterData& filterData = itr.value();
+        if (!filterData.stats) {
+            continue;
+        }
+        QJsonObject filterStats = filterData.stats->toJson();
+        filterStats["url"] = filterData.url;
+        QString key = itr.key().isInvalidID() ? QString("global") : itr.key().toString();
+        result[key] = filterStats;
+    }
+    return result;
+}
+
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
 
     QUrl scriptURL(filterURL);
@@ -247,6 +327,31 @@ static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName
     return false;
 }
 
+std::unique_ptr<EntityEditFilters::FilterEngine> EntityEditFilters::createFilterEngine(const QScriptProgram& program) {
+    const QString urlString = program.fileName();
+    std::unique_ptr<FilterEngine> filterEngine { new FilterEngine() };
+    filterEngine->engine = new QScriptEngine();
+    filterEngine->engine->evaluate(program);
+    if (hadUncaughtExceptions(*filterEngine->engine, urlString)) {
+        return nullptr;
+    }
+
+    // define the uncaughtException function
+    QScriptEngine& engineRef = *filterEngine->engine;
+    filterEngine->uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
+
+    // now get the filter function
+    auto global = filterEngine->engine->globalObject();
+    auto entitiesObject = filterEngine->engine->newObject();
+    entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+    entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+    entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+    entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
+    global.setProperty("Entities", entitiesObject);
+    filterEngine->filterFn = global.property("filter");
+    return filterEngine;
+}
+
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     qDebug() << "script request completed for entity " << entityID;
     auto scriptRequest = qobject_cast<ResourceRequest*>(sender());
@@ -256,52 +361,39 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         qInfo() << "Downloaded script:" << scriptContents;
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->evaluate(scriptContents);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
+            auto filterEngine = createFilterEngine(program);
+            if (filterEngine) {
                 FilterData filterData;
-                filterData.engine = engine;
+                filterData.url = urlString;
                 filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
+
+                QScriptValue filterFn = filterEngine->filterFn;
+                if (!filterFn.isFunction()) {
                     qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
-                    filterData.rejectAll=true;
+                    filterData.rejectAll = true;
+                } else {
+                    filterData.engine = std::move(filterEngine);
+                    filterData.stats = std::make_shared<FilterStats>();
                 }
 
                 // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
+                QScriptValue wantsToFilterAddValue = filterFn.property("wantsToFilterAdd");
                 filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
 
                 // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
+                QScriptValue wantsToFilterEditValue = filterFn.property("wantsToFilterEdit");
                 filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
 
                 // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
+                QScriptValue wantsToFilterPhysicsValue = filterFn.property("wantsToFilterPhysics");
                 filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
 
                 // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
-                QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
+                QScriptValue wantsToFilterDeleteValue = filterFn.property("wantsToFilterDelete");
                 filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
 
                 // check to see if the filterFn has properties asking for Original props
-                QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
+                QScriptValue wantsOriginalPropertiesValue = filterFn.property("wantsOriginalProperties");
                 // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
                 //   - boolean - true  - include all original properties
                 //               false - no properties at all
@@ -322,7 +414,7 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 }
 
                 // check to see if the filterFn has properties asking for Zone props
-                QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
+                QScriptValue wantsZonePropertiesValue = filterFn.property("wantsZoneProperties");
                 // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
                 //   - boolean - true  - include all Zone properties
                 //               false - no properties at all
@@ -363,6 +455,16 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                     }
                 }
 
+                // check to see if the filterFn declares which edited properties it cares about
+                QScriptValue wantsToFilterPropertiesValue = filterFn.property("wantsToFilterProperties");
+                // if the wantsToFilterProperties is a string or list of strings, then edits and physics updates
+                // that change none of those properties are accepted without calling the filter.  Anything else
+                // (including a boolean) means the filter sees every edit.
+                if (wantsToFilterPropertiesValue.isString() || wantsToFilterPropertiesValue.isArray()) {
+                    EntityPropertyFlagsFromScriptValue(wantsToFilterPropertiesValue, filterData.includedFilterProperties);
+                    filterData.wantsAllProperties = false;
+                }
+
                 _lock.lockForWrite();
                 _filterDataMap.insert(entityID, filterData);
                 _lock.unlock();
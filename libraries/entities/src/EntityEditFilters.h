@@ -13,11 +13,15 @@
 
 #include <QObject>
 #include <QMap>
+#include <QJsonObject>
 #include <QScriptValue>
 #include <QScriptEngine>
+#include <QScriptProgram>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -26,8 +30,29 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
-    struct FilterData {
+    // The compiled filter script.  Filters only ever run on the inbound packet thread, under the
+    // tree's write lock, so one engine per filter is all that can be in use at a time.
+    struct FilterEngine {
+        QScriptEngine* engine { nullptr };
         QScriptValue filterFn;
+        QScriptValue nullObject;
+        std::function<bool()> uncaughtExceptions;
+
+        ~FilterEngine() { delete engine; }
+    };
+
+    struct FilterStats {
+        std::atomic<quint64> calls { 0 };
+        std::atomic<quint64> skipped { 0 };
+        std::atomic<quint64> rejected { 0 };
+        std::atomic<quint64> totalUsecs { 0 };
+        std::atomic<quint64> maxUsecs { 0 };
+
+        void trackCall(quint64 callUsecs, bool wasRejected);
+        QJsonObject toJson() const;
+    };
+
+    struct FilterData {
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
 
@@ -36,16 +61,22 @@ public:
         bool wantsToFilterPhysics { true };
         bool wantsToFilterDelete { true };
 
+        // when the filter declares the properties it cares about, edits and physics updates that
+        // don't touch any of them are accepted without calling into the script
+        bool wantsAllProperties { true };
+        EntityPropertyFlags includedFilterProperties;
+
         EntityPropertyFlags includedOriginalProperties;
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
-        std::function<bool()> uncaughtExceptions;
-        QScriptEngine* engine;
-        bool rejectAll;
-        
-        FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        QString url;
+        std::shared_ptr<FilterEngine> engine;
+        std::shared_ptr<FilterStats> stats;
+        bool rejectAll { false };
+
+        bool valid() { return (rejectAll || engine); }
+        bool isInterestedIn(const EntityPropertyFlags& changedProperties) const;
     };
 
     EntityEditFilters() {};
@@ -54,6 +85,8 @@ public:
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
 
+    QJsonObject getFilterStats();
+
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, EntityItemPointer& existingEntity);
 
@@ -66,10 +99,14 @@ private slots:
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
 
+    std::unique_ptr<FilterEngine> createFilterEngine(const QScriptProgram& program);
+    bool callFilter(FilterEngine& filterEngine, const FilterData& filterData, const EntityItemID& id,
+                    EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged,
+                    EntityTree::FilterType filterType, EntityItemPointer& existingEntity);
+
     EntityTreePointer _tree {};
     bool _rejectAll {false};
-    QScriptValue _nullObjectForFilter{};
-    
+
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
 };
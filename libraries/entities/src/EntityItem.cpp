@@ -2724,6 +2724,14 @@ void EntityItem::setLastEdited(quint64 lastEdited) {
     });
 }
 
+void EntityItem::restoreCachedEditTimes(quint64 lastEdited, quint64 lastEditedInRemoteTime) {
+    withWriteLock([&] {
+        _lastEdited = _lastUpdated = lastEdited;
+        _lastEditedFromRemote = lastEdited;
+        _lastEditedFromRemoteInRemoteTime = lastEditedInRemoteTime;
+    });
+}
+
 void EntityItem::markAsChangedOnServer() {
     withWriteLock([&] {
         _changedOnServer = usecTimestampNow();
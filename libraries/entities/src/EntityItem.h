@@ -445,6 +445,10 @@ public:
 
     quint64 getLastEditedFromRemote() const { return _lastEditedFromRemote; }
     void updateLastEditedFromRemote() { _lastEditedFromRemote = usecTimestampNow(); }
+    quint64 getLastEditedFromRemoteInRemoteTime() const { return _lastEditedFromRemoteInRemoteTime; }
+
+    /// restores the edit times of an entity loaded from the client's entity cache, so newer server data still applies
+    void restoreCachedEditTimes(quint64 lastEdited, quint64 lastEditedInRemoteTime);
 
     void getTransformAndVelocityProperties(EntityItemProperties& properties) const;
 
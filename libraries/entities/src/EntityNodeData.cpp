@@ -28,3 +28,20 @@ bool EntityNodeData::isEntityFlaggedAsExtra(const QUuid& entityID) const {
 
     return false;
 }
+
+void EntityNodeData::setCachedEntityVersions(const QUuid& resumeToken, QHash<QUuid, quint64> versions) {
+    QMutexLocker locker(&_cachedEntityVersionsLock);
+    _cachedEntityVersionsResumeToken = resumeToken;
+    _cachedEntityVersions = std::move(versions);
+}
+
+bool EntityNodeData::takeCachedEntityVersions(const QUuid& resumeToken, QHash<QUuid, quint64>& versions) {
+    QMutexLocker locker(&_cachedEntityVersionsLock);
+    if (_cachedEntityVersionsResumeToken.isNull() || _cachedEntityVersionsResumeToken != resumeToken) {
+        return false;
+    }
+    versions.swap(_cachedEntityVersions);
+    _cachedEntityVersions.clear();
+    _cachedEntityVersionsResumeToken = QUuid();
+    return true;
+}
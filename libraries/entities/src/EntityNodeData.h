@@ -12,6 +12,8 @@
 #ifndef hifi_EntityNodeData_h
 #define hifi_EntityNodeData_h
 
+#include <QtCore/QMutex>
+
 #include <udt/PacketHeaders.h>
 
 #include <OctreeQueryNode.h>
@@ -35,6 +37,7 @@ public:
     void removeSentFilteredEntity(const QUuid& entityID) { _sentFilteredEntities.remove(entityID); }
     bool sentFilteredEntity(const QUuid& entityID) const { return _sentFilteredEntities.contains(entityID); }
     QSet<QUuid> getSentFilteredEntities() { return _sentFilteredEntities; }
+    void setSentFilteredEntities(const QSet<QUuid>& sentFilteredEntities) { _sentFilteredEntities = sentFilteredEntities; }
 
     // the following flagged extra entity methods can only be called from the OctreeSendThread for the given Node
 
@@ -44,11 +47,26 @@ public:
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
+    // versions of the entities the client restored from its entity cache, as last edited times in server time,
+    // held until the send thread is serving the query with the resume token they were sent with
+    void setCachedEntityVersions(const QUuid& resumeToken, QHash<QUuid, quint64> versions);
+    bool takeCachedEntityVersions(const QUuid& resumeToken, QHash<QUuid, quint64>& versions);
+
+    // cached entities the server no longer has, can only be used from the OctreeSendThread for the given Node
+    void addStaleCachedEntity(const QUuid& entityID) { _staleCachedEntities << entityID; }
+    bool hasStaleCachedEntities() const { return !_staleCachedEntities.isEmpty(); }
+    QList<QUuid> takeStaleCachedEntities() { QList<QUuid> stale; stale.swap(_staleCachedEntities); return stale; }
+
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
+
+    QMutex _cachedEntityVersionsLock;
+    QUuid _cachedEntityVersionsResumeToken;
+    QHash<QUuid, quint64> _cachedEntityVersions;
+    QList<QUuid> _staleCachedEntities;
 };
 
 #endif // hifi_EntityNodeData_h
@@ -579,6 +579,20 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     return result;
 }
 
+EntityItemPointer EntityTree::addCachedEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
+    if (getContainingElement(entityID)) {
+        return nullptr;
+    }
+
+    EntityItemPointer result = EntityTypes::constructEntityItem(properties.getType(), entityID, properties);
+    if (result) {
+        AddEntityOperator theOperator(getThisPointer(), result);
+        recurseTreeWithOperator(&theOperator);
+        postAddEntity(result);
+    }
+    return result;
+}
+
 void EntityTree::emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload) {
     emit entityScriptChanging(entityItemID, reload);
 }
@@ -119,6 +119,9 @@ public:
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false);
 
+    // adds an entity restored from the client's entity cache, which was already accepted from the entity server once
+    EntityItemPointer addCachedEntity(const EntityItemID& entityID, const EntityItemProperties& properties);
+
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
 
@@ -22,6 +22,7 @@
 
 #include <ktx/KTX.h>
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 #include "GPULogging.h"
 #include "Context.h"
@@ -353,6 +354,32 @@ uint16 Texture::safeNumMips(uint16 askedNumMips, uint16 maxNumMips) {
     }
 }
 
+const float Texture::UNKNOWN_SCREEN_SIZE = -1.0f;
+const quint64 Texture::SCREEN_SIZE_PERIOD_USECS = USECS_PER_SECOND / 2;
+
+void Texture::reportScreenSize(float pixels) {
+    // keep the largest of the period, every item using the texture reports it each frame
+    auto now = usecTimestampNow();
+    if (now - _screenSizeUsecs.load() > SCREEN_SIZE_PERIOD_USECS) {
+        _screenSizeUsecs = now;
+        _screenSize = pixels;
+    } else if (pixels > _screenSize.load()) {
+        _screenSize = pixels;
+    }
+}
+
+float Texture::getScreenSize() const {
+    auto screenSize = _screenSize.load();
+    if (screenSize == UNKNOWN_SCREEN_SIZE) {
+        return UNKNOWN_SCREEN_SIZE;
+    }
+    // a texture that is still drawn starts a new period every SCREEN_SIZE_PERIOD_USECS
+    if (usecTimestampNow() - _screenSizeUsecs.load() > 2 * SCREEN_SIZE_PERIOD_USECS) {
+        return 0.0f;
+    }
+    return screenSize;
+}
+
 // Same but applied to this texture's num max mips from evalNumMips()
 uint16 Texture::safeNumMips(uint16 askedNumMips) const {
     return safeNumMips(askedNumMips, evalMaxNumMips());
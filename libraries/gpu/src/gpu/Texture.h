@@ -379,6 +379,14 @@ public:
 
     uint16 minAvailableMipLevel() const { return _storage->minAvailableMipLevel(); };
 
+    // How tall in pixels the renderer drew this texture lately, for whatever streams its mips in
+    void reportScreenSize(float pixels);
+    // The largest size reported over the last SCREEN_SIZE_PERIOD_USECS or so, 0 if it wasn't drawn in that time and
+    // UNKNOWN_SCREEN_SIZE if nothing ever reported it
+    float getScreenSize() const;
+    static const float UNKNOWN_SCREEN_SIZE;
+    static const quint64 SCREEN_SIZE_PERIOD_USECS;
+
     static const uint16 MAX_NUM_MIPS = 0;
     static const uint16 SINGLE_MIP = 1;
     static TexturePointer create1D(const Element& texelFormat, uint16 width, uint16 numMips = SINGLE_MIP, const Sampler& sampler = Sampler());
@@ -620,6 +628,9 @@ protected:
     uint16 _maxMipLevel { 0 };
 
     uint16 _minMip { 0 };
+
+    std::atomic<float> _screenSize { UNKNOWN_SCREEN_SIZE };
+    std::atomic<quint64> _screenSizeUsecs { 0 };
  
     Type _type { TEX_1D };
 
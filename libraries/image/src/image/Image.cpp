@@ -2,7 +2,10 @@
 #include "ImageLogging.h"
 #include "TextureProcessing.h"
 
+#include <algorithm>
+
 #include <nvtt/nvtt.h>
+#include <TBBHelpers.h>
 
 using namespace image;
 
@@ -234,6 +237,66 @@ void Image::invertPixels() {
     _packedData.invertPixels(QImage::InvertRgba);
 }
 
+namespace {
+    // The source pixels one mip pixel covers along an axis. Even sizes take two at half weight, odd ones spread the
+    // extra pixel over its neighbours.
+    struct BoxTaps {
+        static const int MAX_TAPS = 4;
+        int first { 0 };
+        int count { 0 };
+        float weights[MAX_TAPS];
+    };
+
+    std::vector<BoxTaps> computeBoxTaps(int srcSize, int dstSize) {
+        std::vector<BoxTaps> taps(dstSize);
+        const float scale = (float)srcSize / (float)dstSize;
+        for (int i = 0; i < dstSize; i++) {
+            const float begin = i * scale;
+            const float end = (i + 1) * scale;
+            auto& tap = taps[i];
+            tap.first = (int)begin;
+            for (int j = tap.first; j < srcSize && (float)j < end && tap.count < BoxTaps::MAX_TAPS; j++) {
+                tap.weights[tap.count++] = (std::min(end, (float)(j + 1)) - std::max(begin, (float)j)) / scale;
+            }
+        }
+        return taps;
+    }
+}
+
+Image Image::getNextMipLevel() const {
+    assert(_format == Format_RGBAF);
+    const int width = std::max(1, _dims.x / 2);
+    const int height = std::max(1, _dims.y / 2);
+    Image mip(width, height, Format_RGBAF);
+
+    const auto columnTaps = computeBoxTaps(_dims.x, width);
+    const auto rowTaps = computeBoxTaps(_dims.y, height);
+    const glm::vec4* source = _floatData.data();
+    glm::vec4* destination = mip._floatData.data();
+    const int sourceWidth = _dims.x;
+
+    tbb::parallel_for(tbb::blocked_range<int>(0, height, 16), [&](const tbb::blocked_range<int>& range) {
+        for (int y = range.begin(); y < range.end(); y++) {
+            const auto& rowTap = rowTaps[y];
+            glm::vec4* outputIt = destination + y * width;
+            for (int x = 0; x < width; x++) {
+                const auto& columnTap = columnTaps[x];
+                glm::vec4 sum { 0.0f };
+                for (int j = 0; j < rowTap.count; j++) {
+                    const glm::vec4* line = source + (rowTap.first + j) * sourceWidth + columnTap.first;
+                    glm::vec4 lineSum { 0.0f };
+                    for (int i = 0; i < columnTap.count; i++) {
+                        lineSum += line[i] * columnTap.weights[i];
+                    }
+                    sum += lineSum * rowTap.weights[j];
+                }
+                outputIt[x] = sum;
+            }
+        }
+    });
+    return mip;
+}
+
 Image Image::getSubImage(QRect rect) const {
     assert(_format != Format_RGBAF);
     return _packedData.copy(rect);
@@ -116,6 +116,9 @@ namespace image {
         Image getConvertedToFormat(Format newFormat) const;
         Image getSubImage(QRect rect) const;
         Image getMirrored(bool horizontal, bool vertical) const;
+        // The next mip level down, half the size rounded down with a box filter. Only for Format_RGBAF, the rows are
+        // filtered in parallel.
+        Image getNextMipLevel() const;
 
         // Inplace transformations
         void invertPixels();
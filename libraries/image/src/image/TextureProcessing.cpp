@@ -19,10 +19,15 @@
 #include <QBuffer>
 #include <QImageReader>
 
+#include <deque>
+#include <functional>
+#include <thread>
+
 #include <Finally.h>
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -421,6 +426,7 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
 }
 
 #if defined(NVTT_API)
+// Holds on to the mip it was given until assignToTexture, the texture can't take mips from several threads at once
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
 
@@ -428,7 +434,8 @@ struct OutputHandler : public nvtt::OutputHandler {
         _size = size;
         _miplevel = miplevel;
 
-        _data = static_cast<gpu::Byte*>(malloc(size));
+        _storage = std::make_shared<storage::MemoryStorage>(size);
+        _data = _storage->data();
         _current = _data;
     }
 
@@ -440,15 +447,24 @@ struct OutputHandler : public nvtt::OutputHandler {
     }
 
     virtual void endImage() override {
+        _data = nullptr;
+        _current = nullptr;
+    }
+
+    void assignToTexture() {
+        if (!_storage) {
+            return;
+        }
+        storage::StoragePointer storage = _storage;
         if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
+            _texture->assignStoredMipFace(_miplevel, _face, storage);
         } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
+            _texture->assignStoredMip(_miplevel, storage);
         }
-        free(_data);
-        _data = nullptr;
+        _storage.reset();
     }
 
+    std::shared_ptr<storage::MemoryStorage> _storage;
     gpu::Byte* _data{ nullptr };
     gpu::Byte* _current{ nullptr };
     gpu::Texture* _texture{ nullptr };
@@ -501,25 +517,70 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Spreads the blocks of a mip over the TBB workers, so one big texture doesn't hold up its loading thread on one core
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
 #endif
 
+// Hands the image and, when buildMips is set, every mip below it to compressMip as a Format_RGBAF surface, and
+// assigns the mips it compressed to the texture once they are all done. Each mip compresses while the next one is
+// filtered from it and is let go of as soon as its surface has a copy, so only two levels of the float chain are
+// alive at once, along with the surfaces still being compressed.
+using CompressMip = std::function<std::unique_ptr<OutputHandler>(int mipLevel, const nvtt::Surface& surface)>;
+static void compressMipChain(Image&& image, bool buildMips, nvtt::WrapMode wrapMode,
+                             const std::atomic<bool>& abortProcessing, const CompressMip& compressMip) {
+    PROFILE_RANGE(resource_parse, "compressMipChain");
+    Image mip;
+    if (image.getFormat() != Image::Format_RGBAF) {
+        mip = image.getConvertedToFormat(Image::Format_RGBAF);
+        // free up the memory as we go to avoid bloating the heap
+        image = Image();
+    } else {
+        mip = std::move(image);
+    }
+
+    // a deque so the handlers being filled in don't move when the next level is added
+    std::deque<std::unique_ptr<OutputHandler>> outputHandlers;
+    tbb::task_group compressions;
+    for (int level = 0; !abortProcessing.load(); level++) {
+        auto surface = std::make_shared<nvtt::Surface>();
+        surface->setImage(nvtt::InputFormat_RGBA_32F, mip.getWidth(), mip.getHeight(), 1, mip.getBits());
+        surface->setAlphaMode(nvtt::AlphaMode_None);
+        surface->setWrapMode(wrapMode);
+
+        outputHandlers.emplace_back();
+        auto& outputHandler = outputHandlers.back();
+        compressions.run([&compressMip, &outputHandler, level, surface] {
+            outputHandler = compressMip(level, *surface);
+        });
+
+        if (!buildMips || (mip.getWidth() <= 1 && mip.getHeight() <= 1)) {
+            break;
+        }
+        mip = mip.getNextMipLevel();
+    }
+    compressions.wait();
+
+    for (auto& outputHandler : outputHandlers) {
+        if (outputHandler) {
+            outputHandler->assignToTexture();
+        }
+    }
+}
+
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
                               glm::vec4* output, size_t outputLinePixelStride) {
     glm::vec4* outputIt;
@@ -560,7 +621,7 @@ void convertToPackedFromFloat(unsigned char* output, int width, int height, size
     }
 }
 
-nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture, int face, nvtt::CompressionOptions& compressionOptions) {
+OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture, int face, nvtt::CompressionOptions& compressionOptions) {
     auto outputFormat = outputTexture->getStoredMipFormat();
     bool useNVTT = false;
 
@@ -599,40 +660,26 @@ nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture
 void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
     assert(image.hasFloatFormat());
 
-    Image localCopy = image.getConvertedToFormat(Image::Format_RGBAF);
-
-    const int width = localCopy.getWidth();
-    const int height = localCopy.getHeight();
-
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
-    nvtt::CompressionOptions compressionOptions;
-    std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
-
-    nvtt::Surface surface;
-    surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
-    surface.setAlphaMode(nvtt::AlphaMode_None);
-    surface.setWrapMode(nvtt::WrapMode_Mirror);
+    compressMipChain(std::move(image), buildMips, nvtt::WrapMode_Mirror, abortProcessing,
+                     [&](int level, const nvtt::Surface& surface) {
+        nvtt::CompressionOptions compressionOptions;
+        std::unique_ptr<OutputHandler> outputHandler { getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
+        if (!outputHandler) {
+            return outputHandler;
+        }
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
+        nvtt::OutputOptions outputOptions;
+        outputOptions.setOutputHeader(false);
+        outputOptions.setOutputHandler(outputHandler.get());
+        MyErrorHandler errorHandler;
+        outputOptions.setErrorHandler(&errorHandler);
 
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        }
-    }
+        ParallelTaskDispatcher dispatcher(abortProcessing);
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
+        context.compress(surface, face, baseMipLevel + level, compressionOptions, outputOptions);
+        return outputHandler;
+    });
 }
 
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -649,7 +696,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
         }
 
-        const void* data = static_cast<const void*>(localCopy.getBits());
         nvtt::TextureType textureType = nvtt::TextureType_2D;
         nvtt::InputFormat inputFormat = nvtt::InputFormat_BGRA_8UB;
         nvtt::WrapMode wrapMode = nvtt::WrapMode_Mirror;
@@ -659,15 +705,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         float inputGamma = 2.2f;
         float outputGamma = 2.2f;
 
-        nvtt::Surface surface;
-        surface.setImage(inputFormat, width, height, 1, data);
-        surface.setAlphaMode(alphaMode);
-        surface.setWrapMode(wrapMode);
-
-        // Surface copies the memory, so free up the memory afterward to avoid bloating the heap
-        data = nullptr;
-        localCopy = Image(); // Image doesn't have a clear function, so override it with an empty one.
-
         nvtt::InputOptions inputOptions;
         inputOptions.setTextureLayout(textureType, width, height);
 
@@ -752,23 +789,22 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        // The mips are filtered in float like nvtt's surfaces did, so they come out the same
+        compressMipChain(std::move(localCopy), buildMips, wrapMode, abortProcessing,
+                         [&](int level, const nvtt::Surface& surface) {
+            std::unique_ptr<OutputHandler> outputHandler { new OutputHandler(texture, face) };
+            nvtt::OutputOptions outputOptions;
+            outputOptions.setOutputHeader(false);
+            outputOptions.setOutputHandler(outputHandler.get());
+            MyErrorHandler errorHandler;
+            outputOptions.setErrorHandler(&errorHandler);
+
+            ParallelTaskDispatcher dispatcher(abortProcessing);
+            nvtt::Compressor context;
+            context.setTaskDispatcher(&dispatcher);
+            context.compress(surface, face, mipLevel + level, compressionOptions, outputOptions);
+            return outputHandler;
+        });
     } else {
         int numMips = 1;
     
@@ -807,7 +843,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
+        const int numEncodeThreads = std::max(1, (int)std::thread::hardware_concurrency());
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
@@ -0,0 +1,181 @@
+//
+//  MipStreamingScheduler.cpp
+//  libraries/material-networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MipStreamingScheduler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <gpu/Context.h>
+#include <gpu/Texture.h>
+#include <NumericalConstants.h>
+#include <ResourceCache.h>
+#include <SharedUtil.h>
+#include <StatTracker.h>
+
+#include "TextureCache.h"
+
+const quint64 MipStreamingScheduler::DEFAULT_MAX_BYTES_PER_SECOND = 32 * BYTES_PER_KILOBYTE * BYTES_PER_KILOBYTE;
+
+static const int SCHEDULE_INTERVAL_MSECS = 100;
+// a mip that isn't drawn at a size that needs it within this long after it arrived was fetched for nothing
+static const quint64 SAMPLED_MIP_TIMEOUT_USECS = 30 * USECS_PER_SECOND;
+// textures nothing reported a screen size for go after the blurry ones
+static const float UNKNOWN_SCREEN_SIZE_PRIORITY = 0.0f;
+
+MipStreamingScheduler::MipStreamingScheduler() {
+    _timer.setInterval(SCHEDULE_INTERVAL_MSECS);
+    connect(&_timer, &QTimer::timeout, this, &MipStreamingScheduler::schedule);
+}
+
+void MipStreamingScheduler::queueMipRequest(const QWeakPointer<NetworkTexture>& texture) {
+    if (std::find(_queuedTextures.begin(), _queuedTextures.end(), texture) == _queuedTextures.end()) {
+        _queuedTextures.push_back(texture);
+    }
+    if (!_timer.isActive()) {
+        _timer.start();
+    }
+    schedule();
+}
+
+void MipStreamingScheduler::mipRequestFinished(const gpu::TexturePointer& gpuTexture, uint16_t mipLevel, quint64 bytes) {
+    if (!gpuTexture) {
+        return;
+    }
+
+    ++_fetchedMips;
+    _fetchedBytes += bytes;
+    if (gpuTexture->getScreenSize() == gpu::Texture::UNKNOWN_SCREEN_SIZE) {
+        _unknownScreenSizeBytes += bytes;
+    } else {
+        float size = (float)(std::max(gpuTexture->getWidth(), gpuTexture->getHeight()) >> mipLevel);
+        _unsampledMips.push_back({ gpuTexture, size, bytes, usecTimestampNow() });
+    }
+
+    // a request slot just opened up
+    schedule();
+}
+
+float MipStreamingScheduler::evalPriority(const gpu::Texture& gpuTexture, float screenSize, uint16_t mipLevel) const {
+    if (screenSize <= 0.0f) {
+        return -FLT_MAX;
+    }
+    // the mip above the one to request is what gets drawn now
+    int currentSize = std::max(1, std::max(gpuTexture.getWidth(), gpuTexture.getHeight()) >> (mipLevel + 1));
+    // how many pixels each of its texels covers across, the next mip sharpens it while that's over one
+    return log2f(screenSize / (float)currentSize);
+}
+
+bool MipStreamingScheduler::hasBandwidthFor(quint64 bytes, quint64 now) {
+    while (!_recentRequests.empty() && now - _recentRequests.front().first > USECS_PER_SECOND) {
+        _recentRequests.pop_front();
+    }
+    quint64 recentBytes = 0;
+    for (const auto& request : _recentRequests) {
+        recentBytes += request.second;
+    }
+    // a mip bigger than the whole budget still goes, once nothing else is
+    return _maxBytesPerSecond == 0 || recentBytes == 0 || recentBytes + bytes <= _maxBytesPerSecond;
+}
+
+void MipStreamingScheduler::schedule() {
+    auto now = usecTimestampNow();
+    updateSampledMips(now);
+
+    struct Candidate {
+        QSharedPointer<NetworkTexture> texture;
+        float priority;
+        quint64 bytes;
+    };
+    std::vector<Candidate> candidates;
+
+    // past it, more mips only go to textures that are blurry on screen
+    auto allowedGPUMemory = gpu::Texture::getAllowedGPUMemoryUsage();
+    bool isOverMemoryBudget = allowedGPUMemory > 0 && gpu::Context::getTextureResourcePopulatedGPUMemSize() > allowedGPUMemory;
+
+    _deferredCount = 0;
+    for (auto it = _queuedTextures.begin(); it != _queuedTextures.end();) {
+        auto texture = it->lock();
+        uint16_t mipLevel;
+        size_t bytes;
+        if (!texture || !texture->getNextMipToRequest(mipLevel, bytes)) {
+            it = _queuedTextures.erase(it);
+            continue;
+        }
+        ++it;
+
+        auto gpuTexture = texture->getGPUTexture();
+        float screenSize = gpuTexture->getScreenSize();
+        float priority = UNKNOWN_SCREEN_SIZE_PRIORITY;
+        bool isWanted = !isOverMemoryBudget;
+        if (screenSize != gpu::Texture::UNKNOWN_SCREEN_SIZE) {
+            priority = evalPriority(*gpuTexture, screenSize, mipLevel);
+            isWanted = priority > UNKNOWN_SCREEN_SIZE_PRIORITY;
+        }
+
+        if (isWanted) {
+            candidates.push_back({ texture, priority, bytes });
+        } else {
+            // off screen or sharp enough, it waits here until that changes
+            ++_deferredCount;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.priority > b.priority;
+    });
+
+    // only start as many as the resource cache will run right away, its own queue doesn't know about any of this
+    for (const auto& candidate : candidates) {
+        if (ResourceCache::getLoadingRequestCount() >= ResourceCache::getRequestLimit() ||
+            !hasBandwidthFor(candidate.bytes, now)) {
+            break;
+        }
+
+        QWeakPointer<NetworkTexture> texture = candidate.texture;
+        _queuedTextures.erase(std::find(_queuedTextures.begin(), _queuedTextures.end(), texture));
+        _recentRequests.emplace_back(now, candidate.bytes);
+        candidate.texture->requestNextMipLevel();
+    }
+
+    updateStats();
+
+    if (_queuedTextures.empty() && _unsampledMips.empty()) {
+        _timer.stop();
+    }
+}
+
+void MipStreamingScheduler::updateSampledMips(quint64 now) {
+    for (auto it = _unsampledMips.begin(); it != _unsampledMips.end();) {
+        auto texture = it->texture.lock();
+        // the GPU draws from a mip once each of its texels covers about half a pixel or more
+        if (texture && texture->getScreenSize() >= it->size / 2.0f) {
+            ++_sampledMips;
+            _sampledBytes += it->bytes;
+            it = _unsampledMips.erase(it);
+        } else if (!texture || now - it->usecs > SAMPLED_MIP_TIMEOUT_USECS) {
+            it = _unsampledMips.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MipStreamingScheduler::updateStats() {
+    auto statTracker = DependencyManager::get<StatTracker>();
+    statTracker->setStat("MipStreamingQueued", (int64_t)_queuedTextures.size());
+    statTracker->setStat("MipStreamingDeferred", _deferredCount);
+    statTracker->setStat("MipStreamingFetchedMips", (int64_t)_fetchedMips);
+    statTracker->setStat("MipStreamingFetchedBytes", (int64_t)_fetchedBytes);
+    statTracker->setStat("MipStreamingSampledMips", (int64_t)_sampledMips);
+    statTracker->setStat("MipStreamingSampledBytes", (int64_t)_sampledBytes);
+    statTracker->setStat("MipStreamingUnknownScreenSizeBytes", (int64_t)_unknownScreenSizeBytes);
+}
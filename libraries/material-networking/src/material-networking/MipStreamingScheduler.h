@@ -0,0 +1,81 @@
+//
+//  MipStreamingScheduler.h
+//  libraries/material-networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MipStreamingScheduler_h
+#define hifi_MipStreamingScheduler_h
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <QObject>
+#include <QTimer>
+#include <QWeakPointer>
+
+#include <gpu/Forward.h>
+
+class NetworkTexture;
+
+/// Decides which of the KTX textures waiting on their next mip gets it first. The textures drawn the most
+/// under-resolved on screen go first, textures that are off screen or already sharp enough wait, and the fetches stay
+/// inside a bandwidth budget. Once the textures on the GPU are over their memory budget only the textures that are
+/// visibly blurry get more mips. Textures nothing reported a screen size for stream in the same as before.
+class MipStreamingScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    static const quint64 DEFAULT_MAX_BYTES_PER_SECOND;
+
+    MipStreamingScheduler();
+
+    void setMaxBytesPerSecond(quint64 maxBytesPerSecond) { _maxBytesPerSecond = maxBytesPerSecond; }
+    quint64 getMaxBytesPerSecond() const { return _maxBytesPerSecond; }
+
+    /// Holds on to texture until its next mip is worth fetching
+    void queueMipRequest(const QWeakPointer<NetworkTexture>& texture);
+    /// mipLevel of gpuTexture arrived, bytes long. Counts towards the fetched and sampled stats.
+    void mipRequestFinished(const gpu::TexturePointer& gpuTexture, uint16_t mipLevel, quint64 bytes);
+
+public slots:
+    void schedule();
+
+private:
+    struct FetchedMip {
+        std::weak_ptr<gpu::Texture> texture;
+        float size;
+        quint64 bytes;
+        quint64 usecs;
+    };
+
+    float evalPriority(const gpu::Texture& gpuTexture, float screenSize, uint16_t mipLevel) const;
+    bool hasBandwidthFor(quint64 bytes, quint64 now);
+    void updateSampledMips(quint64 now);
+    void updateStats();
+
+    QTimer _timer;
+    quint64 _maxBytesPerSecond { DEFAULT_MAX_BYTES_PER_SECOND };
+
+    std::vector<QWeakPointer<NetworkTexture>> _queuedTextures;
+    // the mips requested over the last second, as (usecs, bytes)
+    std::deque<std::pair<quint64, quint64>> _recentRequests;
+    // the mips that arrived but haven't been drawn at a size that needs them yet
+    std::list<FetchedMip> _unsampledMips;
+
+    int _deferredCount { 0 };
+    quint64 _fetchedMips { 0 };
+    quint64 _fetchedBytes { 0 };
+    quint64 _sampledMips { 0 };
+    quint64 _sampledBytes { 0 };
+    // fetched for textures nothing reported a screen size for, so there's no telling whether they were drawn
+    quint64 _unknownScreenSizeBytes { 0 };
+};
+
+#endif // hifi_MipStreamingScheduler_h
@@ -685,6 +685,39 @@ void NetworkTexture::startRequestForNextMipLevel() {
         return;
     }
 
+    _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
+    if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
+        // the scheduler weighs it against the mips every other texture is waiting on
+        DependencyManager::get<TextureCache>()->getMipStreamingScheduler().queueMipRequest(qSharedPointerCast<NetworkTexture>(self));
+    }
+}
+
+bool NetworkTexture::getNextMipToRequest(uint16_t& mipLevel, size_t& bytes) const {
+    auto texture = _textureSource->getGPUTexture();
+    if (!texture || !_originalKtxDescriptor || _ktxResourceState != WAITING_FOR_MIP_REQUEST) {
+        return false;
+    }
+
+    auto lowestPopulatedMip = texture->minAvailableMipLevel();
+    if (_lowestRequestedMipLevel >= lowestPopulatedMip || lowestPopulatedMip > _originalKtxDescriptor->images.size()) {
+        return false;
+    }
+    mipLevel = lowestPopulatedMip - 1;
+    bytes = _originalKtxDescriptor->images[mipLevel]._imageSize;
+    return true;
+}
+
+void NetworkTexture::requestNextMipLevel() {
+    auto self = _self.lock();
+    if (!self) {
+        return;
+    }
+
+    auto texture = _textureSource->getGPUTexture();
+    if (!texture || _ktxResourceState != WAITING_FOR_MIP_REQUEST) {
+        return;
+    }
+
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
     if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
         _ktxResourceState = PENDING_MIP_REQUEST;
@@ -823,6 +856,7 @@ void NetworkTexture::ktxMipRequestFinished() {
             auto data = _ktxMipRequest->getData();
             auto mipLevel = _ktxMipLevelRangeInFlight.first;
             auto texture = _textureSource->getGPUTexture();
+            DependencyManager::get<TextureCache>()->getMipStreamingScheduler().mipRequestFinished(texture, mipLevel, data.size());
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
             QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
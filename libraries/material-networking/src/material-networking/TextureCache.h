@@ -29,6 +29,7 @@
 
 #include <gpu/Context.h>
 #include "KTXCache.h"
+#include "MipStreamingScheduler.h"
 
 namespace gpu {
 class Batch;
@@ -95,6 +96,12 @@ protected:
 private:
     friend class KTXReader;
     friend class ImageReader;
+    friend class MipStreamingScheduler;
+
+    // The next mip to request and how big it is, false if no request is waiting on the scheduler
+    bool getNextMipToRequest(uint16_t& mipLevel, size_t& bytes) const;
+    // Called by the scheduler once the next mip is worth fetching
+    void requestNextMipLevel();
 
     image::TextureUsage::Type _type { image::TextureUsage::UNUSED_TEXTURE };
     image::ColorChannel _sourceChannel;
@@ -198,6 +205,8 @@ public:
     void setGPUContext(const gpu::ContextPointer& context) { _gpuContext = context; }
     gpu::ContextPointer getGPUContext() const { return _gpuContext; }
 
+    MipStreamingScheduler& getMipStreamingScheduler() { return _mipStreamingScheduler; }
+
 signals:
     void spectatorCameraFramebufferReset();
 
@@ -225,6 +234,8 @@ private:
 
     std::shared_ptr<cache::FileCache> _ktxCache { std::make_shared<KTXCache>(KTX_DIRNAME, KTX_EXT) };
 
+    MipStreamingScheduler _mipStreamingScheduler;
+
     // Map from image hashes to texture weak pointers
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
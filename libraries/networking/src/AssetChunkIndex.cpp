@@ -0,0 +1,109 @@
+//
+//  AssetChunkIndex.cpp
+//  libraries/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkIndex.h"
+
+#include <cstring>
+
+#include <QtCore/QFile>
+
+#include "NetworkLogging.h"
+
+// about as many chunks as fit in the disk cache, past that the index starts over
+static const int MAX_INDEXED_CHUNKS = 256 * 1024;
+
+void AssetChunkIndex::load(const QString& filePath) {
+    _filePath = filePath;
+    _locations.clear();
+    _indexedAssets.clear();
+
+    QFile file { _filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // each record is the raw hash of an asset and the size of its manifest, followed by the manifest
+    auto data = file.readAll();
+    int position = 0;
+    while (position + (int)(AssetUtils::SHA256_HASH_LENGTH + sizeof(uint32_t)) <= data.size()) {
+        auto assetHash = AssetUtils::AssetHash(data.mid(position, AssetUtils::SHA256_HASH_LENGTH).toHex());
+        position += AssetUtils::SHA256_HASH_LENGTH;
+
+        uint32_t manifestSize;
+        memcpy(&manifestSize, data.constData() + position, sizeof(manifestSize));
+        position += sizeof(manifestSize);
+
+        AssetChunking::Manifest manifest;
+        if (position + (qint64)manifestSize > data.size() ||
+            !AssetChunking::deserializeManifest(data.mid(position, manifestSize), manifest)) {
+            // a record cut short by a crash, everything before it is fine
+            qCWarning(asset_client) << "Ignoring the end of the asset chunk index at" << _filePath;
+            break;
+        }
+        position += manifestSize;
+
+        insert(assetHash, manifest);
+    }
+
+    qCDebug(asset_client) << "Loaded" << _locations.size() << "cached asset chunks";
+}
+
+void AssetChunkIndex::addManifest(const AssetUtils::AssetHash& assetHash, const AssetChunking::Manifest& manifest) {
+    if (_indexedAssets.contains(assetHash)) {
+        return;
+    }
+
+    bool restart = _locations.size() + (int)manifest.size() > MAX_INDEXED_CHUNKS;
+    if (restart) {
+        _locations.clear();
+        _indexedAssets.clear();
+    }
+    insert(assetHash, manifest);
+
+    if (_filePath.isEmpty()) {
+        return;
+    }
+
+    QFile file { _filePath };
+    if (!file.open(restart ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::Append)) {
+        qCWarning(asset_client) << "Could not write the asset chunk index to" << _filePath;
+        return;
+    }
+
+    auto serializedManifest = AssetChunking::serializeManifest(manifest);
+    uint32_t manifestSize = serializedManifest.size();
+    file.write(QByteArray::fromHex(assetHash.toLatin1()));
+    file.write(reinterpret_cast<const char*>(&manifestSize), sizeof(manifestSize));
+    file.write(serializedManifest);
+}
+
+void AssetChunkIndex::insert(const AssetUtils::AssetHash& assetHash, const AssetChunking::Manifest& manifest) {
+    _indexedAssets.insert(assetHash);
+    for (const auto& chunk : manifest) {
+        _locations.insert(chunk.hash, { assetHash, chunk.offset, chunk.size });
+    }
+}
+
+bool AssetChunkIndex::find(const QByteArray& chunkHash, Location& location) const {
+    auto it = _locations.find(chunkHash);
+    if (it == _locations.end()) {
+        return false;
+    }
+    location = it.value();
+    return true;
+}
+
+void AssetChunkIndex::clear() {
+    _locations.clear();
+    _indexedAssets.clear();
+    if (!_filePath.isEmpty()) {
+        QFile::remove(_filePath);
+    }
+}
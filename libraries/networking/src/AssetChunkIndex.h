@@ -0,0 +1,49 @@
+//
+//  AssetChunkIndex.h
+//  libraries/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkIndex_h
+#define hifi_AssetChunkIndex_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+#include "AssetChunking.h"
+#include "AssetUtils.h"
+
+/// Where the chunks of the assets in the disk cache can be found, so a download of a new version of an asset can take
+/// the chunks it shares with an older one from the cache instead of the asset server. Kept on disk as a log of the
+/// manifests of the cached assets. Entries can outlive the assets they point at, check what they lead to.
+class AssetChunkIndex {
+public:
+    struct Location {
+        AssetUtils::AssetHash assetHash;
+        qint64 offset { 0 };
+        qint64 size { 0 };
+    };
+
+    /// Loads the index kept at filePath, and keeps adding to it
+    void load(const QString& filePath);
+
+    void addManifest(const AssetUtils::AssetHash& assetHash, const AssetChunking::Manifest& manifest);
+    bool find(const QByteArray& chunkHash, Location& location) const;
+
+    void clear();
+
+private:
+    void insert(const AssetUtils::AssetHash& assetHash, const AssetChunking::Manifest& manifest);
+
+    QString _filePath;
+    QHash<QByteArray, Location> _locations;
+    QSet<AssetUtils::AssetHash> _indexedAssets;
+};
+
+#endif // hifi_AssetChunkIndex_h
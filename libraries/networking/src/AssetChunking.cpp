@@ -0,0 +1,147 @@
+//
+//  AssetChunking.cpp
+//  libraries/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunking.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "AssetUtils.h"
+#include "Sha256Hasher.h"
+
+namespace AssetChunking {
+
+// FastCDC style gear hash: every byte shifts the hash left and adds a random value for the byte, so the top bits
+// depend on the last 64 bytes and nothing before them
+using GearTable = std::array<uint64_t, 256>;
+
+static GearTable makeGearTable() {
+    // splitmix64 from a fixed seed, both ends of a transfer have to cut an asset at the same places
+    GearTable table;
+    uint64_t state = 0x6869666963686b73ULL;
+    for (auto& value : table) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static const GearTable GEAR = makeGearTable();
+
+// a cut needs all of the masked bits to be zero. Before the average size the mask is harder to satisfy and after it
+// easier, which keeps chunk sizes close to the average (FastCDC's normalized chunking).
+static const uint64_t SMALL_CHUNK_MASK = ((1ULL << 18) - 1) << (64 - 18);
+static const uint64_t LARGE_CHUNK_MASK = ((1ULL << 14) - 1) << (64 - 14);
+
+// a manifest is a chunk count followed by the hash and size of each chunk
+static const int SERIALIZED_CHUNK_SIZE = (int)(AssetUtils::SHA256_HASH_LENGTH + sizeof(uint32_t));
+
+qint64 findChunkSize(const char* data, qint64 size) {
+    if (size <= MIN_CHUNK_SIZE) {
+        return size;
+    }
+
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    auto normalEnd = std::min(size, AVERAGE_CHUNK_SIZE);
+    auto end = std::min(size, MAX_CHUNK_SIZE);
+
+    uint64_t hash = 0;
+    qint64 i = MIN_CHUNK_SIZE;
+    for (; i < normalEnd; ++i) {
+        hash = (hash << 1) + GEAR[bytes[i]];
+        if (!(hash & SMALL_CHUNK_MASK)) {
+            return i + 1;
+        }
+    }
+    for (; i < end; ++i) {
+        hash = (hash << 1) + GEAR[bytes[i]];
+        if (!(hash & LARGE_CHUNK_MASK)) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+Manifest createManifest(const char* data, qint64 size) {
+    Manifest manifest;
+    manifest.reserve(size / AVERAGE_CHUNK_SIZE + 1);
+
+    qint64 offset = 0;
+    while (offset < size) {
+        Chunk chunk;
+        chunk.offset = offset;
+        chunk.size = findChunkSize(data + offset, size - offset);
+        chunk.hash = Sha256Hasher::hash(data + offset, chunk.size);
+        offset += chunk.size;
+        manifest.push_back(chunk);
+    }
+    return manifest;
+}
+
+qint64 getAssetSize(const Manifest& manifest) {
+    if (manifest.empty()) {
+        return 0;
+    }
+    return manifest.back().offset + manifest.back().size;
+}
+
+QByteArray serializeManifest(const Manifest& manifest) {
+    uint32_t count = (uint32_t)manifest.size();
+
+    QByteArray data;
+    data.reserve(sizeof(count) + count * SERIALIZED_CHUNK_SIZE);
+    data.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& chunk : manifest) {
+        uint32_t size = (uint32_t)chunk.size;
+        data.append(chunk.hash);
+        data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
+    return data;
+}
+
+bool deserializeManifest(const QByteArray& data, Manifest& manifest) {
+    uint32_t count;
+    if (data.size() < (int)sizeof(count)) {
+        return false;
+    }
+    memcpy(&count, data.constData(), sizeof(count));
+    if ((qint64)data.size() != (qint64)sizeof(count) + (qint64)count * SERIALIZED_CHUNK_SIZE) {
+        return false;
+    }
+
+    manifest.clear();
+    manifest.reserve(count);
+
+    auto position = data.constData() + sizeof(count);
+    qint64 offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        Chunk chunk;
+        chunk.hash = QByteArray(position, (int)AssetUtils::SHA256_HASH_LENGTH);
+        position += AssetUtils::SHA256_HASH_LENGTH;
+
+        uint32_t size;
+        memcpy(&size, position, sizeof(size));
+        position += sizeof(size);
+        if (size == 0 || size > MAX_CHUNK_SIZE) {
+            return false;
+        }
+
+        chunk.offset = offset;
+        chunk.size = size;
+        offset += size;
+        manifest.push_back(chunk);
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,51 @@
+//
+//  AssetChunking.h
+//  libraries/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunking_h
+#define hifi_AssetChunking_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+/// Content-defined chunking of assets. Chunk boundaries are picked by a rolling hash of the bytes around them rather than
+/// by offset, so an edit in the middle of an asset only changes the chunks it touches and everything after it still
+/// chunks, and hashes, the same as before.
+namespace AssetChunking {
+
+const qint64 MIN_CHUNK_SIZE = 16 * 1024;
+const qint64 AVERAGE_CHUNK_SIZE = 64 * 1024;
+const qint64 MAX_CHUNK_SIZE = 256 * 1024;
+
+struct Chunk {
+    QByteArray hash; // raw SHA-256 of the chunk's bytes
+    qint64 offset { 0 };
+    qint64 size { 0 };
+};
+
+/// The chunks of an asset, in order, covering all of it
+using Manifest = std::vector<Chunk>;
+
+/// Returns the size of the chunk at the front of data, size being the number of bytes left in the asset
+qint64 findChunkSize(const char* data, qint64 size);
+
+Manifest createManifest(const char* data, qint64 size);
+inline Manifest createManifest(const QByteArray& data) { return createManifest(data.constData(), data.size()); }
+
+/// The size of the asset the manifest describes
+qint64 getAssetSize(const Manifest& manifest);
+
+QByteArray serializeManifest(const Manifest& manifest);
+/// Returns false if data isn't a whole, well formed manifest
+bool deserializeManifest(const QByteArray& data, Manifest& manifest);
+
+}
+
+#endif // hifi_AssetChunking_h
@@ -13,7 +13,10 @@
 
 #include <cstdint>
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
@@ -31,9 +34,13 @@
 #include "NodeList.h"
 #include "PacketReceiver.h"
 #include "ResourceCache.h"
+#include "Sha256Hasher.h"
 
 MessageID AssetClient::_currentID = 0;
 
+// smaller uploads go out whole, the manifest round trip would cost more than the chunks it could save
+static const qint64 MIN_CHUNKED_UPLOAD_SIZE = 4 * 1024 * 1024;
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -45,7 +52,9 @@ AssetClient::AssetClient() {
 
     packetReceiver.registerListener(PacketType::AssetMappingOperationReply, this, "handleAssetMappingOperationReply");
     packetReceiver.registerListener(PacketType::AssetGetInfoReply, this, "handleAssetGetInfoReply");
+    packetReceiver.registerListener(PacketType::AssetGetManifestReply, this, "handleAssetGetManifestReply");
     packetReceiver.registerListener(PacketType::AssetGetReply, this, "handleAssetGetReply", true);
+    packetReceiver.registerListener(PacketType::AssetUploadManifestReply, this, "handleAssetUploadManifestReply");
     packetReceiver.registerListener(PacketType::AssetUploadReply, this, "handleAssetUploadReply");
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
@@ -79,6 +88,10 @@ void AssetClient::initCaching() {
                 << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
     }
 
+    static const QString ASSET_CHUNK_INDEX_FILENAME = "asset_chunks.idx";
+    if (auto cache = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache())) {
+        _chunkIndex.load(QDir(cache->cacheDirectory()).filePath(ASSET_CHUNK_INDEX_FILENAME));
+    }
 }
 
 namespace {
@@ -272,6 +285,7 @@ void AssetClient::clearCache() {
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
         qInfo() << "AssetClient::clearCache(): Clearing disk cache.";
         cache->clear();
+        _chunkIndex.clear();
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
@@ -493,6 +507,61 @@ void AssetClient::handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> messag
     }
 }
 
+MessageID AssetClient::getAssetManifest(const QString& hash, GetManifestCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto messageID = ++_currentID;
+
+        auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH;
+        auto packet = NLPacket::create(PacketType::AssetGetManifest, payloadSize, true);
+
+        packet->writePrimitive(messageID);
+        packet->write(QByteArray::fromHex(hash.toLatin1()));
+
+        if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
+            _pendingManifestRequests[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, AssetChunking::Manifest());
+    return INVALID_MESSAGE_ID;
+}
+
+void AssetClient::handleAssetGetManifestReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    AssetChunking::Manifest manifest;
+    if (error == AssetUtils::AssetServerError::NoError &&
+        !AssetChunking::deserializeManifest(message->readAll(), manifest)) {
+        qCWarning(asset_client) << "Received a malformed asset manifest";
+        error = AssetUtils::AssetServerError::FileOperationFailed;
+    }
+
+    auto messageMapIt = _pendingManifestRequests.find(senderNode);
+    if (messageMapIt != _pendingManifestRequests.end()) {
+        auto& messageCallbackMap = messageMapIt->second;
+
+        auto requestIt = messageCallbackMap.find(messageID);
+        if (requestIt != messageCallbackMap.end()) {
+            auto callback = requestIt->second;
+            messageCallbackMap.erase(requestIt);
+            callback(true, error, manifest);
+        }
+    }
+}
+
 void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -809,6 +878,42 @@ bool AssetClient::cancelMappingRequest(MessageID id) {
     return false;
 }
 
+// bound on the memory held by downloads waiting to be resumed
+static const qint64 MAX_PARTIAL_DOWNLOAD_BYTES = 512 * 1024 * 1024;
+
+void AssetClient::stashPartialDownload(const AssetUtils::AssetHash& hash, PartialDownload partial) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    PartialDownload previous;
+    takePartialDownload(hash, previous);
+
+    if (partial.data.size() > MAX_PARTIAL_DOWNLOAD_BYTES) {
+        return;
+    }
+
+    _partialDownloadBytes += partial.data.size();
+    _partialDownloads.emplace_back(hash, std::move(partial));
+
+    while (_partialDownloadBytes > MAX_PARTIAL_DOWNLOAD_BYTES) {
+        _partialDownloadBytes -= _partialDownloads.front().second.data.size();
+        _partialDownloads.pop_front();
+    }
+}
+
+bool AssetClient::takePartialDownload(const AssetUtils::AssetHash& hash, PartialDownload& partial) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    for (auto it = _partialDownloads.begin(); it != _partialDownloads.end(); ++it) {
+        if (it->first == hash) {
+            partial = std::move(it->second);
+            _partialDownloadBytes -= partial.data.size();
+            _partialDownloads.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
 bool AssetClient::cancelGetAssetInfoRequest(MessageID id) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -820,6 +925,17 @@ bool AssetClient::cancelGetAssetInfoRequest(MessageID id) {
     return false;
 }
 
+bool AssetClient::cancelGetAssetManifestRequest(MessageID id) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    for (auto& kv : _pendingManifestRequests) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool AssetClient::cancelGetAssetRequest(MessageID id) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -849,6 +965,7 @@ bool AssetClient::cancelUploadAssetRequest(MessageID id) {
     // Search through each pending mapping request for id `id`
     for (auto& kv : _pendingUploads) {
         if (kv.second.erase(id)) {
+            _chunkedUploads.erase(id);
             return true;
         }
     }
@@ -862,16 +979,16 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
     if (assetServer) {
-        auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
-
         auto messageID = ++_currentID;
-        packetList->writePrimitive(messageID);
 
-        uint64_t size = data.length();
-        packetList->writePrimitive(size);
-        packetList->write(data.constData(), size);
+        if (data.length() >= MIN_CHUNKED_UPLOAD_SIZE) {
+            _pendingUploads[assetServer][messageID] = callback;
+            startChunkedUpload(assetServer, messageID, data);
 
-        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            return messageID;
+        }
+
+        if (sendWholeUpload(assetServer, messageID, data)) {
             _pendingUploads[assetServer][messageID] = callback;
 
             return messageID;
@@ -882,6 +999,174 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     return INVALID_MESSAGE_ID;
 }
 
+bool AssetClient::sendWholeUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data) {
+    auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
+
+    packetList->writePrimitive(messageID);
+
+    uint64_t size = data.length();
+    packetList->writePrimitive(size);
+    packetList->write(data.constData(), size);
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    return nodeList->sendPacketList(std::move(packetList), *assetServer) != -1;
+}
+
+void AssetClient::startChunkedUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data) {
+    // chunking and hashing a few hundred MB takes a while, the replies to everything else shouldn't wait on it
+    auto watcher = new QFutureWatcher<ChunkedUpload>(this);
+    connect(watcher, &QFutureWatcher<ChunkedUpload>::finished, this, [this, watcher, assetServer, messageID] {
+        watcher->deleteLater();
+        sendUploadManifest(assetServer, messageID, watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run([data] {
+        ChunkedUpload upload;
+        upload.data = data;
+        upload.hash = Sha256Hasher::hash(data.constData(), data.length());
+        upload.manifest = AssetChunking::createManifest(data);
+        return upload;
+    }));
+}
+
+void AssetClient::sendUploadManifest(const SharedNodePointer& assetServer, MessageID messageID, ChunkedUpload upload) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    if (!isUploadPending(assetServer, messageID)) {
+        // cancelled, or the asset server went away, while it was being chunked
+        return;
+    }
+
+    auto packetList = NLPacketList::create(PacketType::AssetUploadManifest, QByteArray(), true, true);
+
+    packetList->writePrimitive(messageID);
+    packetList->write(upload.hash);
+
+    uint64_t size = upload.data.length();
+    packetList->writePrimitive(size);
+    packetList->write(AssetChunking::serializeManifest(upload.manifest));
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+        _chunkedUploads[messageID] = std::move(upload);
+    } else {
+        failUpload(assetServer, messageID, false, AssetUtils::AssetServerError::NoError);
+    }
+}
+
+void AssetClient::handleAssetUploadManifestReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    auto uploadIt = _chunkedUploads.find(messageID);
+    if (uploadIt == _chunkedUploads.end()) {
+        return;
+    }
+    if (!isUploadPending(senderNode, messageID)) {
+        _chunkedUploads.erase(uploadIt);
+        return;
+    }
+
+    if (error == AssetUtils::AssetServerError::FileOperationFailed) {
+        sendWholeUploadInstead(senderNode, messageID);
+        return;
+    } else if (error != AssetUtils::AssetServerError::NoError) {
+        failUpload(senderNode, messageID, true, error);
+        return;
+    }
+
+    const auto& upload = uploadIt->second;
+
+    // the chunks the asset server doesn't have, in order
+    uint32_t missingCount { 0 };
+    message->readPrimitive(&missingCount);
+    std::vector<uint32_t> missingChunks;
+    if (missingCount <= upload.manifest.size() &&
+        message->getBytesLeftToRead() == (qint64)(missingCount * sizeof(uint32_t))) {
+        missingChunks.resize(missingCount);
+        message->read(reinterpret_cast<char*>(missingChunks.data()), missingCount * sizeof(uint32_t));
+    }
+    bool validChunks = missingChunks.size() == missingCount;
+    for (uint32_t i = 0; validChunks && i < missingCount; ++i) {
+        validChunks = missingChunks[i] < upload.manifest.size() && (i == 0 || missingChunks[i] > missingChunks[i - 1]);
+    }
+    if (!validChunks) {
+        qCWarning(asset_client) << "Received a malformed list of the chunks to upload";
+        sendWholeUploadInstead(senderNode, messageID);
+        return;
+    }
+
+    auto packetList = NLPacketList::create(PacketType::AssetUploadChunks, QByteArray(), true, true);
+
+    packetList->writePrimitive(messageID);
+    packetList->write(upload.hash);
+
+    uint64_t size = upload.data.length();
+    packetList->writePrimitive(size);
+
+    auto serializedManifest = AssetChunking::serializeManifest(upload.manifest);
+    packetList->writePrimitive((uint32_t)serializedManifest.size());
+    packetList->write(serializedManifest);
+
+    packetList->writePrimitive(missingCount);
+    for (auto index : missingChunks) {
+        packetList->writePrimitive(index);
+    }
+
+    qint64 sentBytes = 0;
+    for (auto index : missingChunks) {
+        const auto& chunk = upload.manifest[index];
+        packetList->write(upload.data.constData() + chunk.offset, chunk.size);
+        sentBytes += chunk.size;
+    }
+
+    qCDebug(asset_client) << "Uploading" << sentBytes << "of" << size << "bytes, the asset server has the rest";
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    if (nodeList->sendPacketList(std::move(packetList), *senderNode) == -1) {
+        failUpload(senderNode, messageID, false, AssetUtils::AssetServerError::NoError);
+    }
+}
+
+void AssetClient::sendWholeUploadInstead(const SharedNodePointer& assetServer, MessageID messageID) {
+    auto uploadIt = _chunkedUploads.find(messageID);
+    if (uploadIt == _chunkedUploads.end()) {
+        return;
+    }
+
+    auto data = uploadIt->second.data;
+    _chunkedUploads.erase(uploadIt);
+
+    qCDebug(asset_client) << "The asset server could not take the upload in chunks, sending all of it";
+    if (!sendWholeUpload(assetServer, messageID, data)) {
+        failUpload(assetServer, messageID, false, AssetUtils::AssetServerError::NoError);
+    }
+}
+
+bool AssetClient::isUploadPending(const SharedNodePointer& assetServer, MessageID messageID) const {
+    auto messageMapIt = _pendingUploads.find(assetServer);
+    return messageMapIt != _pendingUploads.end() && messageMapIt->second.count(messageID) > 0;
+}
+
+void AssetClient::failUpload(const SharedNodePointer& assetServer, MessageID messageID, bool responseReceived,
+                             AssetUtils::AssetServerError error) {
+    _chunkedUploads.erase(messageID);
+
+    auto messageMapIt = _pendingUploads.find(assetServer);
+    if (messageMapIt != _pendingUploads.end()) {
+        auto requestIt = messageMapIt->second.find(messageID);
+        if (requestIt != messageMapIt->second.end()) {
+            auto callback = requestIt->second;
+            messageMapIt->second.erase(requestIt);
+            callback(responseReceived, error, QString());
+        }
+    }
+}
+
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -891,6 +1176,16 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     AssetUtils::AssetServerError error;
     message->readPrimitive(&error);
 
+    auto chunkedUploadIt = _chunkedUploads.find(messageID);
+    if (chunkedUploadIt != _chunkedUploads.end()) {
+        if (error == AssetUtils::AssetServerError::FileOperationFailed && isUploadPending(senderNode, messageID)) {
+            // some of the chunks it was going to take from its own files are gone
+            sendWholeUploadInstead(senderNode, messageID);
+            return;
+        }
+        _chunkedUploads.erase(chunkedUploadIt);
+    }
+
     QString hashString;
 
     if (error) {
@@ -935,6 +1230,7 @@ void AssetClient::handleNodeKilled(SharedNodePointer node) {
         auto messageMapIt = _pendingUploads.find(node);
         if (messageMapIt != _pendingUploads.end()) {
             for (const auto& value : messageMapIt->second) {
+                _chunkedUploads.erase(value.first);
                 value.second(false, AssetUtils::AssetServerError::NoError, "");
             }
             messageMapIt->second.clear();
@@ -984,6 +1280,16 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
         }
     }
 
+    {
+        auto messageMapIt = _pendingManifestRequests.find(node);
+        if (messageMapIt != _pendingManifestRequests.end()) {
+            for (const auto& value : messageMapIt->second) {
+                value.second(false, AssetUtils::AssetServerError::NoError, AssetChunking::Manifest());
+            }
+            messageMapIt->second.clear();
+        }
+    }
+
     {
         auto messageMapIt = _pendingMappingRequests.find(node);
         if (messageMapIt != _pendingMappingRequests.end()) {
@@ -16,11 +16,15 @@
 #include <QtQml/QJSEngine>
 #include <QString>
 
+#include <list>
 #include <map>
+#include <vector>
 
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetChunkIndex.h"
+#include "AssetChunking.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
@@ -45,6 +49,7 @@ struct AssetInfo {
 using MappingOperationCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, QSharedPointer<ReceivedMessage> message)>;
 using ReceivedAssetCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data)>;
 using GetInfoCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info)>;
+using GetManifestCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const AssetChunking::Manifest& manifest)>;
 using UploadResultCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QString& hash)>;
 using ProgressCallback = std::function<void(qint64 totalReceived, qint64 total)>;
 
@@ -76,7 +81,9 @@ public slots:
 private slots:
     void handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetGetManifestReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadManifestReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
@@ -91,12 +98,14 @@ private:
     MessageID setBakingEnabled(const AssetUtils::AssetPathList& paths, bool enabled, MappingOperationCallback callback);
 
     MessageID getAssetInfo(const QString& hash, GetInfoCallback callback);
+    MessageID getAssetManifest(const QString& hash, GetManifestCallback callback);
     MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
 
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
+    bool cancelGetAssetManifestRequest(MessageID id);
     bool cancelGetAssetRequest(MessageID id);
     bool cancelUploadAssetRequest(MessageID id);
 
@@ -105,6 +114,31 @@ private:
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    // a big upload goes out as its manifest first, then as just the chunks the asset server doesn't have anywhere
+    struct ChunkedUpload {
+        QByteArray data;
+        QByteArray hash;
+        AssetChunking::Manifest manifest;
+    };
+    bool sendWholeUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data);
+    void startChunkedUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data);
+    void sendUploadManifest(const SharedNodePointer& assetServer, MessageID messageID, ChunkedUpload upload);
+    /// For when the asset server can't take an upload in chunks
+    void sendWholeUploadInstead(const SharedNodePointer& assetServer, MessageID messageID);
+    bool isUploadPending(const SharedNodePointer& assetServer, MessageID messageID) const;
+    void failUpload(const SharedNodePointer& assetServer, MessageID messageID, bool responseReceived,
+                    AssetUtils::AssetServerError error);
+
+    // what a download of a whole asset had finished when it stopped, so a new request can pick up from there
+    struct PartialDownload {
+        QByteArray data;
+        // the (offset, size) ranges of data that were filled in
+        std::vector<std::pair<qint64, qint64>> completedRanges;
+        AssetChunking::Manifest manifest;
+    };
+    void stashPartialDownload(const AssetUtils::AssetHash& hash, PartialDownload partial);
+    bool takePartialDownload(const AssetUtils::AssetHash& hash, PartialDownload& partial);
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
@@ -115,7 +149,17 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, MappingOperationCallback>> _pendingMappingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetManifestCallback>> _pendingManifestRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    // the chunked uploads in _pendingUploads, until the asset server has answered them
+    std::unordered_map<MessageID, ChunkedUpload> _chunkedUploads;
+
+    // oldest first
+    std::list<std::pair<AssetUtils::AssetHash, PartialDownload>> _partialDownloads;
+    qint64 _partialDownloadBytes { 0 };
+
+    // the chunks of the assets in the disk cache, for downloads of other versions of them
+    AssetChunkIndex _chunkIndex;
 
     QString _cacheDir;
 
@@ -12,13 +12,19 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QThread>
+#include <QtNetwork/QNetworkDiskCache>
 
 #include <StatTracker.h>
 #include <Trace.h>
 
 #include "AssetClient.h"
+#include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "ResourceCache.h"
@@ -33,11 +39,29 @@ AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     
 }
 
+// whole assets are downloaded in pieces of up to this size, with up to MAX_PIECES_IN_FLIGHT requested at once
+static const qint64 DOWNLOAD_PIECE_SIZE = 4 * 1024 * 1024;
+static const int MAX_PIECES_IN_FLIGHT = 4;
+// a piece that was cut off by a dropped connection is asked for again this many times before the request gives up
+static const int MAX_PIECE_ATTEMPTS = 3;
+// other cached assets a download will load looking for chunks it shares with them
+static const int MAX_CHUNK_SOURCE_ASSETS = 4;
+
 AssetRequest::~AssetRequest() {
     auto assetClient = DependencyManager::get<AssetClient>();
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+    }
+    if (_manifestRequestID) {
+        assetClient->cancelGetAssetManifestRequest(_manifestRequestID);
+    }
+    if (_state == WaitingForData) {
+        // keep whatever pieces we got for the next request for this asset
+        cancelPieces();
+    }
 }
 
 void AssetRequest::start() {
@@ -75,6 +99,14 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        startSingleDownload();
+    } else {
+        startChunkedDownload();
+    }
+}
+
+void AssetRequest::startSingleDownload() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -89,52 +121,398 @@ void AssetRequest::start() {
         }
         _assetRequestID = INVALID_MESSAGE_ID;
 
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            finishWithServerError(responseReceived, serverError);
+            return;
+        }
+
+        _data = data;
+        _totalReceived += data.size();
+        emit progress(_totalReceived, data.size());
+
+        finish();
+    }, [this, that](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            // If the request is dead, return
+            return;
+        }
+        emit progress(totalReceived, total);
+    });
+}
+
+void AssetRequest::startChunkedDownload() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+
+    // pick up where an earlier request for this asset left off
+    AssetClient::PartialDownload partial;
+    if (assetClient->takePartialDownload(_hash, partial)) {
+        _data = partial.data;
+        _completedRanges = partial.completedRanges;
+        _manifest = partial.manifest;
+        for (const auto& range : _completedRanges) {
+            _totalReceived += range.second;
+        }
+        qCDebug(asset_client) << "Resuming download of" << _hash << "from" << _totalReceived << "of" << _data.size() << "bytes";
+        setupPieces();
+        requestPieces();
+        return;
+    }
+
+    // ask for the last piece first, if the asset is smaller than a piece that gets us all of it in one go
+    auto that = QPointer<AssetRequest>(this);
+    auto hash = _hash;
+
+    _assetRequestID = assetClient->getAsset(_hash, -DOWNLOAD_PIECE_SIZE, 0,
+        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+
+        if (!that) {
+            qCWarning(asset_client) << "Got reply for dead asset request " << hash << "- error code" << _error;
+            return;
+        }
+        _assetRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            finishWithServerError(responseReceived, serverError);
+        } else if (data.size() < DOWNLOAD_PIECE_SIZE) {
+            finishWholeAsset(data);
         } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
+            requestManifest(data);
+        }
+    }, [this, that](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            return;
+        }
+        emit progress(totalReceived, total);
+    });
+}
+
+void AssetRequest::requestManifest(const QByteArray& tail) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this);
+
+    _manifestRequestID = assetClient->getAssetManifest(_hash,
+        [this, that, tail](bool responseReceived, AssetUtils::AssetServerError serverError,
+                           const AssetChunking::Manifest& manifest) {
+
+        if (!that) {
+            return;
+        }
+        _manifestRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived) {
+            finishWithServerError(responseReceived, serverError);
+            return;
+        }
+
+        auto assetSize = AssetChunking::getAssetSize(manifest);
+        if (serverError != AssetUtils::AssetServerError::NoError || assetSize < tail.size()) {
+            // the server couldn't chunk it, download it without
+            requestAssetSize(tail);
+            return;
+        }
+
+        _manifest = manifest;
+        startPieces(assetSize, tail);
+    });
+}
+
+void AssetRequest::requestAssetSize(const QByteArray& tail) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this);
+
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that, tail](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            finishWithServerError(responseReceived, serverError);
+            return;
+        }
+
+        startPieces(info.size, tail);
+    });
+}
+
+void AssetRequest::startPieces(qint64 assetSize, const QByteArray& tail) {
+    if (assetSize <= tail.size()) {
+        finishWholeAsset(tail);
+        return;
+    }
+
+    _data = QByteArray(assetSize, Qt::Uninitialized);
+
+    // the tail we already have goes at the end
+    auto tailOffset = assetSize - tail.size();
+    memcpy(_data.data() + tailOffset, tail.constData(), tail.size());
+    _completedRanges.emplace_back(tailOffset, tail.size());
+    _totalReceived = tail.size();
+
+    copyCachedChunks();
+}
+
+void AssetRequest::copyCachedChunks() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto diskCache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+    auto tailOffset = _completedRanges.front().first;
+
+    // the index lookups are cheap, loading and hashing the older versions of this asset isn't
+    std::vector<std::pair<AssetChunking::Chunk, AssetChunkIndex::Location>> cachedChunks;
+    QSet<AssetUtils::AssetHash> sources;
+    for (const auto& chunk : _manifest) {
+        if (!diskCache || chunk.offset + chunk.size > tailOffset) {
+            // we have the rest from the tail
+            break;
+        }
+
+        AssetChunkIndex::Location location;
+        if (!assetClient->_chunkIndex.find(chunk.hash, location) || location.assetHash == _hash ||
+            location.size != chunk.size) {
+            continue;
+        }
+        if (!sources.contains(location.assetHash)) {
+            if (sources.size() >= MAX_CHUNK_SOURCE_ASSETS) {
+                continue;
             }
+            sources.insert(location.assetHash);
+        }
+        cachedChunks.emplace_back(chunk, location);
+    }
 
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
+    if (cachedChunks.empty()) {
+        setupPieces();
+        requestPieces();
+        return;
+    }
+
+    // the disk cache belongs to this thread, the worker reads the same directory through a cache of its own
+    auto cacheDirectory = diskCache->cacheDirectory();
+    auto watcher = new QFutureWatcher<CachedChunks>(this);
+    connect(watcher, &QFutureWatcher<CachedChunks>::finished, this, [this, watcher] {
+        watcher->deleteLater();
+        finishCopyingCachedChunks(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run([cacheDirectory, cachedChunks] {
+        QNetworkDiskCache cache;
+        cache.setCacheDirectory(cacheDirectory);
 
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
+        // the older versions of this asset we loaded from the cache, an empty one if it wasn't there anymore
+        QHash<AssetUtils::AssetHash, QByteArray> sources;
+        CachedChunks verifiedChunks;
+        for (const auto& cachedChunk : cachedChunks) {
+            const auto& chunk = cachedChunk.first;
+            const auto& location = cachedChunk.second;
+
+            auto sourceIt = sources.find(location.assetHash);
+            if (sourceIt == sources.end()) {
+                QByteArray source;
+                if (auto ioDevice = std::unique_ptr<QIODevice>(cache.data(AssetUtils::getATPUrl(location.assetHash)))) {
+                    source = ioDevice->readAll();
                 }
+                sourceIt = sources.insert(location.assetHash, source);
+            }
+
+            // the index can be out of date with the cache, only use what checks out
+            const auto& source = sourceIt.value();
+            if (location.offset + location.size > source.size()) {
+                continue;
             }
+            auto data = QByteArray::fromRawData(source.constData() + location.offset, location.size);
+            if (AssetUtils::hashData(data) != chunk.hash) {
+                continue;
+            }
+            verifiedChunks.emplace_back(chunk.offset, QByteArray(data.constData(), data.size()));
         }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        return verifiedChunks;
+    }));
+}
+
+void AssetRequest::finishCopyingCachedChunks(const CachedChunks& cachedChunks) {
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    qint64 copiedBytes = 0;
+    for (const auto& chunk : cachedChunks) {
+        memcpy(_data.data() + chunk.first, chunk.second.constData(), chunk.second.size());
+        _completedRanges.emplace_back(chunk.first, chunk.second.size());
+        copiedBytes += chunk.second.size();
+    }
+
+    if (copiedBytes > 0) {
+        qCDebug(asset_client) << "Found" << copiedBytes << "of the" << _data.size() << "bytes of" << _hash << "in the cache";
+        _totalReceived += copiedBytes;
+    }
+
+    setupPieces();
+    requestPieces();
+}
+
+void AssetRequest::setupPieces() {
+    // pieces cover the gaps between the ranges we have
+    std::sort(_completedRanges.begin(), _completedRanges.end());
+
+    _pieces.clear();
+    _nextPiece = 0;
+    qint64 position = 0;
+    auto addGap = [this](qint64 start, qint64 end) {
+        for (qint64 offset = start; offset < end; offset += DOWNLOAD_PIECE_SIZE) {
+            Piece piece;
+            piece.offset = offset;
+            piece.size = std::min(DOWNLOAD_PIECE_SIZE, end - offset);
+            _pieces.push_back(piece);
         }
-        
-        _state = Finished;
-        emit finished(this);
-    }, [this, that](qint64 totalReceived, qint64 total) {
+    };
+    for (const auto& range : _completedRanges) {
+        addGap(position, range.first);
+        position = std::max(position, range.first + range.second);
+    }
+    addGap(position, _data.size());
+}
+
+void AssetRequest::requestPieces() {
+    while (_state == WaitingForData && _piecesInFlight < MAX_PIECES_IN_FLIGHT && _nextPiece < _pieces.size()) {
+        requestPiece(_nextPiece++);
+    }
+
+    if (_state == WaitingForData && _piecesInFlight == 0 && _nextPiece >= _pieces.size()) {
+        finishWholeAsset(_data);
+    }
+}
+
+void AssetRequest::requestPiece(size_t pieceIndex) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this);
+    auto& piece = _pieces[pieceIndex];
+
+    ++_piecesInFlight;
+    ++piece.attempts;
+    piece.received = 0;
+
+    piece.requestID = assetClient->getAsset(_hash, piece.offset, piece.offset + piece.size,
+        [this, that, pieceIndex](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+
         if (!that) {
-            // If the request is dead, return
             return;
         }
-        emit progress(totalReceived, total);
+        handlePieceReply(pieceIndex, responseReceived, serverError, data);
+    }, [this, that, pieceIndex](qint64 totalReceived, qint64 total) {
+        if (!that || pieceIndex >= _pieces.size()) {
+            return;
+        }
+        _pieces[pieceIndex].received = totalReceived;
+        emitPieceProgress();
     });
 }
 
+void AssetRequest::handlePieceReply(size_t pieceIndex, bool responseReceived, AssetUtils::AssetServerError serverError,
+                                    const QByteArray& data) {
+    auto& piece = _pieces[pieceIndex];
+    piece.requestID = INVALID_MESSAGE_ID;
+    --_piecesInFlight;
+
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    if (responseReceived && serverError == AssetUtils::AssetServerError::NoError && data.size() == piece.size) {
+        memcpy(_data.data() + piece.offset, data.constData(), piece.size);
+        piece.completed = true;
+        piece.received = piece.size;
+        _completedRanges.emplace_back(piece.offset, piece.size);
+        _totalReceived += piece.size;
+        emitPieceProgress();
+    } else if (!responseReceived && piece.attempts < MAX_PIECE_ATTEMPTS) {
+        qCDebug(asset_client) << "Retrying piece at" << piece.offset << "of" << _hash;
+        requestPiece(pieceIndex);
+        return;
+    } else {
+        // keep what we have so the next request for this asset can resume from it
+        cancelPieces();
+        finishWithServerError(responseReceived, serverError);
+        return;
+    }
+
+    requestPieces();
+}
+
+void AssetRequest::cancelPieces() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+
+    for (auto& piece : _pieces) {
+        if (piece.requestID != INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(piece.requestID);
+            piece.requestID = INVALID_MESSAGE_ID;
+        }
+    }
+    _piecesInFlight = 0;
+
+    if (!_completedRanges.empty()) {
+        assetClient->stashPartialDownload(_hash, { _data, _completedRanges, _manifest });
+    }
+}
+
+void AssetRequest::emitPieceProgress() {
+    qint64 received = _totalReceived;
+    for (const auto& piece : _pieces) {
+        if (!piece.completed) {
+            received += piece.received;
+        }
+    }
+    emit progress(received, _data.size());
+}
+
+void AssetRequest::finishWholeAsset(const QByteArray& data) {
+    if (AssetUtils::hashData(data).toHex() != _hash) {
+        // the hash of the received data does not match what we expect, so we return an error
+        _error = HashVerificationFailed;
+        _data = QByteArray();
+    } else {
+        _data = data;
+        _totalReceived = data.size();
+        emit progress(_totalReceived, data.size());
+
+        if (AssetUtils::saveToCache(getUrl(), data) && !_manifest.empty()) {
+            // later versions of this asset can take the chunks they share with it from the cache
+            DependencyManager::get<AssetClient>()->_chunkIndex.addManifest(_hash, _manifest);
+        }
+    }
+
+    finish();
+}
+
+void AssetRequest::finishWithServerError(bool responseReceived, AssetUtils::AssetServerError serverError) {
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else {
+        switch (serverError) {
+            case AssetUtils::AssetServerError::AssetNotFound:
+                _error = NotFound;
+                break;
+            case AssetUtils::AssetServerError::InvalidByteRange:
+                _error = InvalidByteRange;
+                break;
+            default:
+                _error = UnknownError;
+                break;
+        }
+    }
+
+    finish();
+}
+
+void AssetRequest::finish() {
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
 
 const QString AssetRequest::getErrorString() const {
     QString result;
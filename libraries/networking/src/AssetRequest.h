@@ -12,10 +12,13 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <vector>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
 
+#include "AssetChunking.h"
 #include "AssetClient.h"
 #include "AssetUtils.h"
 
@@ -62,6 +65,42 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    void startSingleDownload();
+
+    // whole assets are fetched in pieces, several at a time, so a dropped connection only loses the pieces in flight.
+    // Past the first piece they are fetched by their manifest of content-defined chunks, and the chunks the disk cache
+    // already has from other versions of the asset aren't fetched at all.
+    void startChunkedDownload();
+    void requestManifest(const QByteArray& tail);
+    void requestAssetSize(const QByteArray& tail);
+    void startPieces(qint64 assetSize, const QByteArray& tail);
+    // the (offset, data) of chunks of this asset found in other cached assets
+    using CachedChunks = std::vector<std::pair<qint64, QByteArray>>;
+    /// Looks for the chunks of the manifest that other assets in the disk cache have on a worker thread, and carries on
+    /// with the download once it has them
+    void copyCachedChunks();
+    void finishCopyingCachedChunks(const CachedChunks& cachedChunks);
+    void setupPieces();
+    void requestPieces();
+    void requestPiece(size_t pieceIndex);
+    void handlePieceReply(size_t pieceIndex, bool responseReceived, AssetUtils::AssetServerError serverError,
+                          const QByteArray& data);
+    void cancelPieces();
+    void emitPieceProgress();
+
+    void finishWholeAsset(const QByteArray& data);
+    void finishWithServerError(bool responseReceived, AssetUtils::AssetServerError serverError);
+    void finish();
+
+    struct Piece {
+        qint64 offset { 0 };
+        qint64 size { 0 };
+        qint64 received { 0 };
+        MessageID requestID { INVALID_MESSAGE_ID };
+        int attempts { 0 };
+        bool completed { false };
+    };
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -72,6 +111,15 @@ private:
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
+
+    std::vector<Piece> _pieces;
+    size_t _nextPiece { 0 };
+    int _piecesInFlight { 0 };
+    // the (offset, size) ranges of _data we have, whether they were downloaded or found in the cache
+    std::vector<std::pair<qint64, qint64>> _completedRanges;
+    AssetChunking::Manifest _manifest;
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    MessageID _manifestRequestID { INVALID_MESSAGE_ID };
 };
 
 #endif
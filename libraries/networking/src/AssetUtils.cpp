@@ -13,8 +13,8 @@
 
 #include <memory>
 
-#include <QtCore/QCryptographicHash>
 #include <QtCore/QDateTime>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo> // for baseName
 #include <QtNetwork/QAbstractNetworkCache>
 
@@ -23,6 +23,7 @@
 #include "NetworkingConstants.h"
 
 #include "ResourceManager.h"
+#include "Sha256Hasher.h"
 
 namespace AssetUtils {
 
@@ -59,7 +60,29 @@ QUrl getATPUrl(const QString& input) {
 }
 
 QByteArray hashData(const QByteArray& data) {
-    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+    return Sha256Hasher::hash(data.constData(), data.size());
+}
+
+bool hashFile(const QString& filePath, QByteArray& hash) {
+    static const qint64 HASH_CHUNK_SIZE = 1024 * 1024;
+
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    Sha256Hasher hasher;
+    QByteArray chunk(HASH_CHUNK_SIZE, Qt::Uninitialized);
+    qint64 bytesRead;
+    while ((bytesRead = file.read(chunk.data(), HASH_CHUNK_SIZE)) > 0) {
+        hasher.addData(chunk.constData(), bytesRead);
+    }
+    if (bytesRead < 0) {
+        return false;
+    }
+
+    hash = hasher.result();
+    return true;
 }
 
 QByteArray loadFromCache(const QUrl& url) {
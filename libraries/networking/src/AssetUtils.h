@@ -80,6 +80,8 @@ QUrl getATPUrl(const QString& input);
 AssetHash extractAssetHash(const QString& input);
 
 QByteArray hashData(const QByteArray& data);
+/// Hashes the file at filePath a chunk at a time, without reading it all into memory. Returns false if it can't be read.
+bool hashFile(const QString& filePath, QByteArray& hash);
 
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
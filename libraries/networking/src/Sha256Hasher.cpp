@@ -0,0 +1,55 @@
+//
+//  Sha256Hasher.cpp
+//  libraries/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Sha256Hasher.h"
+
+#include <openssl/opensslv.h>
+#include <openssl/evp.h>
+
+struct Sha256Hasher::Context {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+    Context() : digest(EVP_MD_CTX_new()) {}
+    ~Context() { EVP_MD_CTX_free(digest); }
+#else
+    Context() : digest(EVP_MD_CTX_create()) {}
+    ~Context() { EVP_MD_CTX_destroy(digest); }
+#endif
+
+    EVP_MD_CTX* digest;
+};
+
+Sha256Hasher::Sha256Hasher() : _context(new Context()) {
+    EVP_DigestInit_ex(_context->digest, EVP_sha256(), nullptr);
+}
+
+Sha256Hasher::~Sha256Hasher() {
+}
+
+void Sha256Hasher::addData(const char* data, qint64 length) {
+    if (length > 0) {
+        EVP_DigestUpdate(_context->digest, data, (size_t)length);
+    }
+}
+
+QByteArray Sha256Hasher::result() {
+    QByteArray digest(EVP_MAX_MD_SIZE, 0);
+    unsigned int digestLength = 0;
+    EVP_DigestFinal_ex(_context->digest, reinterpret_cast<unsigned char*>(digest.data()), &digestLength);
+    digest.resize(digestLength);
+
+    EVP_DigestInit_ex(_context->digest, EVP_sha256(), nullptr);
+    return digest;
+}
+
+QByteArray Sha256Hasher::hash(const char* data, qint64 length) {
+    Sha256Hasher hasher;
+    hasher.addData(data, length);
+    return hasher.result();
+}
@@ -0,0 +1,42 @@
+//
+//  Sha256Hasher.h
+//  libraries/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_Sha256Hasher_h
+#define hifi_Sha256Hasher_h
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+
+/// Incremental SHA-256 on top of OpenSSL, which picks the SHA extensions or the fastest SIMD path the CPU has at
+/// runtime. Not thread-safe, use one hasher per stream.
+class Sha256Hasher {
+public:
+    Sha256Hasher();
+    ~Sha256Hasher();
+
+    Sha256Hasher(const Sha256Hasher&) = delete;
+    Sha256Hasher& operator=(const Sha256Hasher&) = delete;
+
+    void addData(const char* data, qint64 length);
+    void addData(const QByteArray& data) { addData(data.constData(), data.size()); }
+
+    /// Finishes the hash and returns the 32 byte digest. The hasher starts over afterwards.
+    QByteArray result();
+
+    static QByteArray hash(const char* data, qint64 length);
+
+private:
+    // wraps the OpenSSL digest context, whose struct name differs between OpenSSL versions
+    struct Context;
+    std::unique_ptr<Context> _context;
+};
+
+#endif // hifi_Sha256Hasher_h
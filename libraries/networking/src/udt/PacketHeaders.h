@@ -135,6 +135,12 @@ public:
         AudioSoloRequest,
         BulkAvatarTraitsAck,
         StopInjector,
+        EntityCacheManifest,
+        AssetGetManifest,
+        AssetGetManifestReply,
+        AssetUploadManifest,
+        AssetUploadManifestReply,
+        AssetUploadChunks,
         NUM_PACKET_TYPE
     };
 
@@ -289,14 +295,17 @@ enum class EntityQueryPacketVersion: PacketVersion {
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    ResumeToken = 24
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ChunkManifests,
+    ChunkedUploads
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -17,6 +17,7 @@
 
 #include <GLMHelpers.h>
 #include <udt/PacketHeaders.h>
+#include <UUID.h>
 
 OctreeQuery::OctreeQuery(bool randomizeConnectionID) {
     if (randomizeConnectionID) {
@@ -24,6 +25,9 @@ OctreeQuery::OctreeQuery(bool randomizeConnectionID) {
         // the connection ID is 16 bits so we take a generated 32 bit value from random device and chop off the top
         std::random_device randomDevice;
         _connectionID = randomDevice();
+
+        // a querying client starts out with nothing, so it also needs a fresh resume token
+        _resumeToken = QUuid::createUuid();
     }
 }
 
@@ -38,6 +42,11 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
     memcpy(destinationBuffer, &_connectionID, sizeof(_connectionID));
     destinationBuffer += sizeof(_connectionID);
 
+    // pack the resume token so the server can tell if we still hold what it sent on an earlier connection
+    QByteArray resumeToken = getResumeToken().toRfc4122();
+    memcpy(destinationBuffer, resumeToken.constData(), resumeToken.size());
+    destinationBuffer += resumeToken.size();
+
     {
         QMutexLocker lock(&_conicalViewsLock);
         // Number of frustums
@@ -115,6 +124,15 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
         }
     }
 
+    // unpack the resume token
+    {
+        QUuid resumeToken = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(sourceBuffer),
+                                                                       NUM_BYTES_RFC4122_UUID));
+        sourceBuffer += NUM_BYTES_RFC4122_UUID;
+        QMutexLocker lock(&_resumeTokenLock);
+        _resumeToken = resumeToken;
+    }
+
     // check if this query uses a view frustum
     uint8_t numFrustums = 0;
     memcpy(&numFrustums, sourceBuffer, sizeof(numFrustums));
@@ -13,7 +13,9 @@
 #define hifi_OctreeQuery_h
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
 #include <QtCore/QReadWriteLock>
+#include <QtCore/QUuid>
 
 #include <NodeData.h>
 #include <shared/ConicalViewFrustum.h>
@@ -50,6 +52,12 @@ public:
 
     void incrementConnectionID() { ++_connectionID; }
 
+    // The resume token identifies the set of entities the client is currently holding.  The client picks a new
+    // token whenever it throws its entities away; while the token is unchanged a server may pick up sending
+    // where it left off, even across a new connection ID.  Servers only resume for the session that was sent to.
+    QUuid getResumeToken() const { QMutexLocker lock(&_resumeTokenLock); return _resumeToken; }
+    void regenerateResumeToken() { QMutexLocker lock(&_resumeTokenLock); _resumeToken = QUuid::createUuid(); }
+
     bool hasReceivedFirstQuery() const  { return _hasReceivedFirstQuery; }
 
     // Want a report when the initial query is complete.
@@ -74,6 +82,9 @@ protected:
     int _boundaryLevelAdjust = 0; /// used for LOD calculations
 
     uint16_t _connectionID; // query connection ID, randomized to start, increments with each new connection to server
+
+    mutable QMutex _resumeTokenLock;
+    QUuid _resumeToken;
     
     QJsonObject _jsonParameters;
     QReadWriteLock _jsonParametersLock;
@@ -0,0 +1,198 @@
+//
+//  CollisionShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CollisionShapeCache.h"
+
+#include <cstring>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+
+#include "PhysicsLogging.h"
+
+const int CollisionShapeCache::VERSION = 1;
+const qint64 CollisionShapeCache::DEFAULT_MAX_BYTES = 1024LL * 1024 * 1024;
+
+static const QString ENTRY_SUFFIX = ".bvh";
+static const uint32_t ENTRY_MAGIC = 0x48564248; // "HBVH" in a little endian file
+static const int MESH_HASH_SIZE = 16;
+// Bullet requires the serialized BVH to start on a 16 byte boundary
+static const int BVH_ALIGNMENT = 16;
+
+namespace {
+    // The serialized BVH is a memory image, only good for the same Bullet on the same kind of machine
+    struct EntryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t bulletVersion;
+        uint32_t pointerSize;
+        uint8_t meshHash[MESH_HASH_SIZE];
+        uint32_t bvhSize;
+    };
+
+    bool isUsable(const EntryHeader& header) {
+        return header.magic == ENTRY_MAGIC && header.version == (uint32_t)CollisionShapeCache::VERSION &&
+            header.bulletVersion == (uint32_t)BT_BULLET_VERSION && header.pointerSize == (uint32_t)sizeof(void*);
+    }
+}
+
+CollisionShapeCache::CollisionShapeCache(const QString& directory, qint64 maxBytes) :
+    _directory(directory),
+    _maxBytes(maxBytes)
+{
+    QDir().mkpath(_directory);
+}
+
+QByteArray CollisionShapeCache::hashMesh(const btIndexedMesh& mesh) {
+    QCryptographicHash hash { QCryptographicHash::Md5 };
+    int32_t layout[] = { mesh.m_numTriangles, mesh.m_numVertices, (int32_t)mesh.m_indexType, (int32_t)mesh.m_vertexType };
+    hash.addData((const char*)layout, sizeof(layout));
+    hash.addData((const char*)mesh.m_triangleIndexBase, mesh.m_numTriangles * mesh.m_triangleIndexStride);
+    hash.addData((const char*)mesh.m_vertexBase, mesh.m_numVertices * mesh.m_vertexStride);
+    return hash.result();
+}
+
+QString CollisionShapeCache::getFilePath(uint64_t key) const {
+    return QDir(_directory).filePath(QString::number(key, 16) + ENTRY_SUFFIX);
+}
+
+btOptimizedBvh* CollisionShapeCache::fetch(uint64_t key, const QByteArray& meshHash) {
+    QFile file { getFilePath(key) };
+    EntryHeader header;
+    bool found = file.open(QIODevice::ReadWrite) && file.read((char*)&header, sizeof(header)) == sizeof(header) &&
+        isUsable(header) && (qint64)header.bvhSize == file.size() - (qint64)sizeof(header) &&
+        meshHash.size() == MESH_HASH_SIZE &&
+        memcmp(header.meshHash, meshHash.constData(), MESH_HASH_SIZE) == 0;
+
+    btOptimizedBvh* bvh = nullptr;
+    if (found) {
+        void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+        if (file.read((char*)buffer, header.bvhSize) == (qint64)header.bvhSize) {
+            bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.bvhSize, false);
+        }
+        if (!bvh) {
+            qCWarning(physics) << "Could not read the cached BVH in" << file.fileName();
+            btAlignedFree(buffer);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock { _mutex };
+    if (!bvh) {
+        // an entry for another mesh under the same key is replaced by the store that follows
+        ++_stats.misses;
+        return nullptr;
+    }
+
+    // the oldest entries go first when the cache is full
+    auto now = QDateTime::currentDateTime();
+    file.setFileTime(now, QFileDevice::FileModificationTime);
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        it->lastUsed = now.toMSecsSinceEpoch();
+    }
+    ++_stats.hits;
+    return bvh;
+}
+
+void CollisionShapeCache::store(uint64_t key, const QByteArray& meshHash, const btOptimizedBvh& bvh) {
+    if (meshHash.size() != MESH_HASH_SIZE) {
+        return;
+    }
+
+    EntryHeader header;
+    header.magic = ENTRY_MAGIC;
+    header.version = (uint32_t)VERSION;
+    header.bulletVersion = (uint32_t)BT_BULLET_VERSION;
+    header.pointerSize = (uint32_t)sizeof(void*);
+    memcpy(header.meshHash, meshHash.constData(), MESH_HASH_SIZE);
+    header.bvhSize = bvh.calculateSerializeBufferSize();
+
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    bool serialized = bvh.serializeInPlace(buffer, header.bvhSize, false);
+
+    // other workers may be reading the entry being replaced, so it's swapped in whole
+    QSaveFile file { getFilePath(key) };
+    bool saved = serialized && file.open(QIODevice::WriteOnly) &&
+        file.write((const char*)&header, sizeof(header)) == sizeof(header) &&
+        file.write((const char*)buffer, header.bvhSize) == (qint64)header.bvhSize && file.commit();
+    btAlignedFree(buffer);
+    if (!saved) {
+        qCWarning(physics) << "Could not write a BVH to the collision shape cache in" << _directory;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock { _mutex };
+    loadEntries();
+    auto& entry = _entries[key];
+    qint64 bytes = (qint64)(sizeof(header) + header.bvhSize);
+    _totalBytes += bytes - entry.bytes;
+    entry.bytes = bytes;
+    entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+    ++_stats.stores;
+
+    evict();
+}
+
+void CollisionShapeCache::deleteBvh(btOptimizedBvh* bvh) {
+    if (bvh) {
+        // deserialized in place, it doesn't own the arrays in its buffer
+        bvh->~btOptimizedBvh();
+        btAlignedFree(bvh);
+    }
+}
+
+CollisionShapeCache::Stats CollisionShapeCache::getStats() const {
+    std::lock_guard<std::mutex> lock { _mutex };
+    return _stats;
+}
+
+void CollisionShapeCache::loadEntries() {
+    if (_entriesLoaded) {
+        return;
+    }
+    _entriesLoaded = true;
+
+    QDir cacheDir { _directory };
+    for (const auto& info : cacheDir.entryInfoList({ "*" + ENTRY_SUFFIX }, QDir::Files)) {
+        bool ok;
+        uint64_t key = info.completeBaseName().toULongLong(&ok, 16);
+        if (!ok) {
+            continue;
+        }
+        Entry entry;
+        entry.bytes = info.size();
+        entry.lastUsed = info.lastModified().toMSecsSinceEpoch();
+        _entries.insert(key, entry);
+        _totalBytes += entry.bytes;
+    }
+}
+
+void CollisionShapeCache::evict() {
+    while (_totalBytes > _maxBytes && !_entries.isEmpty()) {
+        auto oldest = _entries.begin();
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            if (it->lastUsed < oldest->lastUsed) {
+                oldest = it;
+            }
+        }
+
+        QFile::remove(getFilePath(oldest.key()));
+        _totalBytes -= oldest->bytes;
+        _entries.erase(oldest);
+        ++_stats.evictions;
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  CollisionShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CollisionShapeCache_h
+#define hifi_CollisionShapeCache_h
+
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+class btOptimizedBvh;
+struct btIndexedMesh;
+
+/// Keeps the bounding volume hierarchies of static mesh shapes on disk, under the hash of their ShapeInfo, so the
+/// meshes of a domain that was visited before don't have to be sorted into a tree again. The hash of a mesh shape
+/// only covers its URL and dimensions, so each entry also records the hash of the mesh it was built for, and is only
+/// used for that mesh.
+///
+/// Used from the ShapeFactory::Worker threads, any number at once.
+class CollisionShapeCache {
+public:
+    // bump whenever the entry format changes
+    static const int VERSION;
+    static const qint64 DEFAULT_MAX_BYTES;
+
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 stores { 0 };
+        quint64 evictions { 0 };
+    };
+
+    CollisionShapeCache(const QString& directory, qint64 maxBytes = DEFAULT_MAX_BYTES);
+
+    /// \return the hash of the vertices and indices of mesh, as the shape will use them
+    static QByteArray hashMesh(const btIndexedMesh& mesh);
+
+    /// \return the BVH kept under key for the mesh with meshHash, nullptr if there is none.
+    /// It lives in a buffer of its own, see deleteBvh().
+    btOptimizedBvh* fetch(uint64_t key, const QByteArray& meshHash);
+    /// Keeps a copy of the BVH built for the mesh with meshHash under key
+    void store(uint64_t key, const QByteArray& meshHash, const btOptimizedBvh& bvh);
+
+    /// Frees a BVH returned by fetch()
+    static void deleteBvh(btOptimizedBvh* bvh);
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        qint64 bytes { 0 };
+        qint64 lastUsed { 0 };
+    };
+
+    QString getFilePath(uint64_t key) const;
+    void loadEntries();
+    void evict();
+
+    QString _directory;
+    qint64 _maxBytes;
+
+    mutable std::mutex _mutex;
+    QHash<uint64_t, Entry> _entries;
+    qint64 _totalBytes { 0 };
+    bool _entriesLoaded { false };
+    Stats _stats;
+};
+
+#endif // hifi_CollisionShapeCache_h
@@ -189,6 +189,10 @@ PhysicsMotionType EntityMotionState::computePhysicsMotionType() const {
             // if something would have been dynamic but is a child of something else, force it to be kinematic, instead.
             return MOTION_TYPE_KINEMATIC;
         }
+        if (_frozen) {
+            // out of the near region we don't simulate it, only move it along
+            return _entity->isMoving() ? MOTION_TYPE_KINEMATIC : MOTION_TYPE_STATIC;
+        }
         return MOTION_TYPE_DYNAMIC;
     }
     if (_entity->hasActions() ||
@@ -772,9 +776,24 @@ bool EntityMotionState::isLocallyOwnedOrShouldBe() const {
 }
 
 void EntityMotionState::setRegion(uint8_t region) {
+    if (region != workload::Region::R1 && (_region == workload::Region::R1 || _region == workload::Region::INVALID)) {
+        // objects that only graze the edge of the near region shouldn't be frozen and thawed over and over,
+        // so they have to stay out for a while first
+        const uint64_t FREEZE_DELAY = 2 * USECS_PER_SECOND;
+        _freezeExpiry = usecTimestampNow() + FREEZE_DELAY;
+    }
     _region = region;
 }
 
+bool EntityMotionState::shouldFreeze(uint64_t now) const {
+    // we keep simulating what we own, and what is moving without an owner since nobody else will
+    return _body && _region != workload::Region::R1 && now > _freezeExpiry
+        && _entity->getDynamic()
+        && _ownershipState != OwnershipState::LocallyOwned
+        && _ownershipState != OwnershipState::PendingBid
+        && (!_body->isActive() || !_entity->getSimulatorID().isNull());
+}
+
 void EntityMotionState::initForBid() {
     assert(_ownershipState != EntityMotionState::OwnershipState::Unownable);
     _ownershipState = EntityMotionState::OwnershipState::PendingBid;
@@ -97,6 +97,7 @@ public:
     OwnershipState getOwnershipState() const { return _ownershipState; }
 
     void setRegion(uint8_t region);
+    bool isFrozen() const { return _frozen; }
     void saveKinematicState(btScalar timeStep) override;
 
 protected:
@@ -117,6 +118,8 @@ protected:
 
     bool isInPhysicsSimulation() const { return _body != nullptr; }
     bool shouldBeInPhysicsSimulation() const;
+    bool shouldFreeze(uint64_t now) const;
+    void setFrozen(bool frozen) { _frozen = frozen; }
     void setMotionType(PhysicsMotionType motionType) override;
 
     // EntityMotionState keeps a SharedPointer to its EntityItem which is only set in the CTOR
@@ -157,6 +160,11 @@ protected:
     uint8_t _bumpedPriority { 0 }; // the target simulation priority according to collision history
     uint8_t _region { workload::Region::INVALID };
 
+    // A dynamic entity that stays out of the near region is frozen: it is given to the PhysicsEngine as a static
+    // or kinematic proxy that follows the entity-server's extrapolation, until it comes back.
+    uint64_t _freezeExpiry { 0 };
+    bool _frozen { false };
+
     bool isServerlessMode();
 };
 
@@ -54,7 +54,7 @@ void PhysicalEntitySimulation::addEntityInternal(EntityItemPointer entity) {
     if (shouldBePhysical) {
         EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
         if (motionState) {
-            motionState->setRegion(region);
+            setRegion(motionState, region);
         } else {
             _entitiesToAddToPhysics.insert(entity);
         }
@@ -167,7 +167,7 @@ void PhysicalEntitySimulation::processChangedEntity(const EntityItemPointer& ent
         } else {
             _incomingChanges.insert(motionState);
         }
-        motionState->setRegion(region);
+        setRegion(motionState, region);
     } else if (shouldBePhysical) {
         // The intent is for this object to be in the PhysicsEngine, but it has no MotionState yet.
         // Perhaps it's shape has changed and it can now be added?
@@ -209,6 +209,8 @@ void PhysicalEntitySimulation::clearEntitiesInternal() {
         delete motionState;
     }
     _physicalObjects.clear();
+    _freezeCandidates.clear();
+    _frozenObjects.clear();
 
     // clear all other lists specific to this derived class
     _entitiesToRemoveFromPhysics.clear();
@@ -242,7 +244,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
         EntityMotionState* motionState = new EntityMotionState(shape, entity);
         entity->setPhysicsInfo(static_cast<void*>(motionState));
-        motionState->setRegion(_space->getRegion(entity->getSpaceIndex()));
+        setRegion(motionState, _space->getRegion(entity->getSpaceIndex()));
         _physicalObjects.insert(motionState);
         _incomingChanges.insert(motionState);
     };
@@ -357,6 +359,46 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     }
 }
 
+void PhysicalEntitySimulation::setRegion(EntityMotionState* motionState, uint8_t region) {
+    motionState->setRegion(region);
+    if (region == workload::Region::R1 || !motionState->getEntity()->getDynamic()) {
+        _freezeCandidates.remove(motionState);
+        if (motionState->isFrozen()) {
+            setFrozen(motionState, false);
+        }
+    } else if (!motionState->isFrozen()) {
+        _freezeCandidates.insert(motionState);
+    }
+}
+
+void PhysicalEntitySimulation::freezeOuterRegionObjects() {
+    // dynamic objects out of the near region stop costing us solver time once they qualify,
+    // see EntityMotionState::shouldFreeze()
+    uint64_t now = usecTimestampNow();
+    SetOfEntityMotionStates::iterator itr = _freezeCandidates.begin();
+    while (itr != _freezeCandidates.end()) {
+        EntityMotionState* motionState = *itr;
+        if (motionState->shouldFreeze(now)) {
+            setFrozen(motionState, true);
+            itr = _freezeCandidates.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
+void PhysicalEntitySimulation::setFrozen(EntityMotionState* motionState, bool frozen) {
+    motionState->setFrozen(frozen);
+    if (frozen) {
+        _frozenObjects.insert(motionState);
+    } else {
+        _frozenObjects.remove(motionState);
+    }
+    // the body is reinserted with the motion type that goes with it
+    motionState->getEntity()->markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
+    _incomingChanges.insert(motionState);
+}
+
 void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transaction& transaction) {
     QMutexLocker lock(&_mutex);
     // entities being removed
@@ -379,6 +421,8 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
     // entities to add
     buildMotionStatesForEntitiesThatNeedThem();
 
+    freezeOuterRegionObjects();
+
     // motionStates with changed entities: delete, add, or change
     for (auto& object : _incomingChanges) {
         uint32_t unhandledFlags = object->getIncomingDirtyFlags();
@@ -461,6 +505,8 @@ void PhysicalEntitySimulation::handleProcessedPhysicsTransaction(PhysicsEngine::
         EntityMotionState* entityState = static_cast<EntityMotionState*>(object);
         removeOwnershipData(entityState);
         _physicalObjects.remove(object);
+        _freezeCandidates.remove(entityState);
+        _frozenObjects.remove(entityState);
         delete object;
     }
     transaction.clear();
@@ -91,6 +91,9 @@ public:
 
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
+    // dynamic entities in the PhysicsEngine that are frozen for being out of the near region
+    int32_t getNumFrozenObjects() const { return (int32_t)_frozenObjects.size(); }
+
     void addOwnershipBid(EntityMotionState* motionState);
     void addOwnership(EntityMotionState* motionState);
     void sendOwnershipBids(uint32_t numSubsteps);
@@ -98,6 +101,9 @@ public:
 
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
+    void setRegion(EntityMotionState* motionState, uint8_t region);
+    void freezeOuterRegionObjects();
+    void setFrozen(EntityMotionState* motionState, bool frozen);
 
     class ShapeRequest {
     public:
@@ -112,6 +118,8 @@ private:
     SetOfEntities _entitiesToRemoveFromPhysics;
     SetOfEntityMotionStates _incomingChanges; // EntityMotionStates changed by external events
     SetOfMotionStates _physicalObjects; // MotionStates of entities in PhysicsEngine
+    SetOfEntityMotionStates _freezeCandidates; // dynamic, out of the near region, not frozen yet
+    SetOfEntityMotionStates _frozenObjects;
 
     using ShapeRequests = std::set<ShapeRequest>;
     ShapeRequests _shapeRequests;
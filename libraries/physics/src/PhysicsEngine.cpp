@@ -19,11 +19,16 @@
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#if defined(USE_BULLET_MULTITHREADING) && BT_THREADSAFE
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsTaskScheduler.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
@@ -58,6 +63,7 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionDispatcher;
     delete _broadphaseFilter;
     delete _constraintSolver;
+    delete _constraintSolverMt;
     delete _dynamicsWorld;
     delete _ghostPairCallback;
 }
@@ -65,10 +71,41 @@ PhysicsEngine::~PhysicsEngine() {
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+#if defined(USE_BULLET_MULTITHREADING) && BT_THREADSAFE
+        static PhysicsTaskScheduler taskScheduler;
+        if (_numThreads > 1) {
+            // the dispatcher sizes its per thread manifold lists for as many threads as the scheduler has when it's made
+            taskScheduler.setNumThreads(taskScheduler.getMaxNumThreads());
+            btSetTaskScheduler(&taskScheduler);
+            _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+            taskScheduler.setNumThreads(_numThreads);
+            _numThreads = taskScheduler.getNumThreads();
+            // one solver per thread for the islands solved side by side, the Mt solver takes the large ones on its own
+            auto constraintSolverPool = new btConstraintSolverPoolMt(_numThreads);
+            _constraintSolver = constraintSolverPool;
+            _constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+            auto dynamicsWorld = new ThreadSafeDynamicsWorldT<btDiscreteDynamicsWorldMt>(_collisionDispatcher,
+                _broadphaseFilter, constraintSolverPool, _constraintSolverMt, _collisionConfig);
+            _dynamicsWorld = dynamicsWorld;
+            _threadSafeDynamicsWorld = dynamicsWorld;
+        } else if (btGetTaskScheduler() == &taskScheduler) {
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+        }
+#else
+        if (_numThreads > 1) {
+            qCWarning(physics) << "Physics was built without USE_BULLET_MULTITHREADING, the simulation steps on one thread";
+        }
+#endif
+        if (!_dynamicsWorld) {
+            _numThreads = 1;
+            _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+            _constraintSolver = new btSequentialImpulseConstraintSolver;
+            auto dynamicsWorld = new ThreadSafeDynamicsWorldT<btDiscreteDynamicsWorld>(_collisionDispatcher,
+                _broadphaseFilter, _constraintSolver, _collisionConfig);
+            _dynamicsWorld = dynamicsWorld;
+            _threadSafeDynamicsWorld = dynamicsWorld;
+        }
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -91,7 +128,7 @@ void PhysicsEngine::init() {
 }
 
 uint32_t PhysicsEngine::getNumSubsteps() const {
-    return _dynamicsWorld->getNumSubsteps();
+    return _threadSafeDynamicsWorld->getNumSubsteps();
 }
 
 int32_t PhysicsEngine::getNumCollisionObjects() const {
@@ -361,7 +398,7 @@ void PhysicsEngine::stepSimulation() {
         this->doOwnershipInfectionForConstraints();
     };
 
-    int numSubsteps = _dynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
+    int numSubsteps = _threadSafeDynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
                                                                         PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
     if (numSubsteps > 0) {
         BT_PROFILE("postSimulation");
@@ -661,14 +698,14 @@ const VectorOfMotionStates& PhysicsEngine::getChangedMotionStates() {
         body->forceActivationState(ISLAND_SLEEPING);
         ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getUserPointer());
         if (motionState) {
-            _dynamicsWorld->addChangedMotionState(motionState);
+            _threadSafeDynamicsWorld->addChangedMotionState(motionState);
         }
         ++itr;
     }
     _activeStaticBodies.clear();
 
     _hasOutgoingChanges = false;
-    return _dynamicsWorld->getChangedMotionStates();
+    return _threadSafeDynamicsWorld->getChangedMotionStates();
 }
 
 void PhysicsEngine::dumpStatsIfNecessary() {
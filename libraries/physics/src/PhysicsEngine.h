@@ -90,6 +90,15 @@ public:
 
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
+
+    /// \brief threads to step the simulation with, more than one runs the narrowphase, the island solvers and the
+    /// integration on the TBB worker threads. Only read by init(), and Bullet's task scheduler is global, so the last
+    /// engine to init() decides how the others step as well.
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+
+    /// \return threads the simulation steps with, after init() the number actually used
+    int getNumThreads() const { return _numThreads; }
+
     void init();
 
     uint32_t getNumSubsteps() const;
@@ -114,7 +123,10 @@ public:
 
     /// \return reference to list of changed MotionStates.  The list is only valid until beginning of next simulation loop.
     const VectorOfMotionStates& getChangedMotionStates();
-    const VectorOfMotionStates& getDeactivatedMotionStates() const { return _dynamicsWorld->getDeactivatedMotionStates(); }
+    const VectorOfMotionStates& getDeactivatedMotionStates() const { return _threadSafeDynamicsWorld->getDeactivatedMotionStates(); }
+
+    btDiscreteDynamicsWorld* getDynamicsWorld() const { return _dynamicsWorld; }
+    ThreadSafeDynamicsWorld* getThreadSafeDynamicsWorld() const { return _threadSafeDynamicsWorld; }
 
     /// \return reference to list of Collision events.  The list is only valid until beginning of next simulation loop.
     const CollisionEvents& getCollisionEvents();
@@ -167,10 +179,14 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
-    ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
+    btConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolverMt = NULL;
+    // the same world, seen through Bullet's API and through ours
+    btDiscreteDynamicsWorld* _dynamicsWorld = NULL;
+    ThreadSafeDynamicsWorld* _threadSafeDynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
+    int _numThreads { 1 };
 
     ContactMap _contactMap;
     CollisionEvents _collisionEvents;
@@ -0,0 +1,81 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#include <algorithm>
+
+#include <QThread>
+
+#include <Profile.h>
+
+namespace {
+    class ParallelSumBody {
+    public:
+        ParallelSumBody(const btIParallelSumBody& body) : _body(body) {}
+        ParallelSumBody(const ParallelSumBody& other, tbb::split) : _body(other._body) {}
+
+        void operator()(const tbb::blocked_range<int>& range) { _sum += _body.sumLoop(range.begin(), range.end()); }
+        void join(const ParallelSumBody& other) { _sum += other._sum; }
+
+        btScalar getSum() const { return _sum; }
+
+    private:
+        const btIParallelSumBody& _body;
+        btScalar _sum { 0.0f };
+    };
+}
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() :
+    btITaskScheduler("PhysicsTaskScheduler"),
+    _arena(new tbb::task_arena(1))
+{
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const {
+    // Bullet keeps per thread data for up to BT_MAX_THREAD_COUNT threads, indexed by btGetCurrentThreadIndex(),
+    // and any thread of the TBB pool can end up in our arena
+    return std::min(std::max(1, QThread::idealThreadCount()), (int)BT_MAX_THREAD_COUNT);
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    numThreads = std::max(1, std::min(numThreads, getMaxNumThreads()));
+    if (numThreads != _numThreads) {
+        _numThreads = numThreads;
+        _arena.reset(new tbb::task_arena(_numThreads));
+    }
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    DETAILED_PROFILE_RANGE(simulation_physics, "parallelFor");
+    if (_numThreads == 1 || iEnd - iBegin <= grainSize) {
+        body.forLoop(iBegin, iEnd);
+        return;
+    }
+    _arena->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize), [&](const tbb::blocked_range<int>& range) {
+            body.forLoop(range.begin(), range.end());
+        }, tbb::simple_partitioner());
+    });
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    DETAILED_PROFILE_RANGE(simulation_physics, "parallelSum");
+    if (_numThreads == 1 || iEnd - iBegin <= grainSize) {
+        return body.sumLoop(iBegin, iEnd);
+    }
+    // the deterministic reduce splits and joins the same way on every run, so the solver's residuals don't depend on
+    // which threads happened to be free
+    ParallelSumBody sum(body);
+    _arena->execute([&] {
+        tbb::parallel_deterministic_reduce(tbb::blocked_range<int>(iBegin, iEnd, grainSize), sum);
+    });
+    return sum.getSum();
+}
@@ -0,0 +1,37 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsTaskScheduler_h
+#define hifi_PhysicsTaskScheduler_h
+
+#include <memory>
+
+#include <LinearMath/btThreads.h>
+
+#include <TBBHelpers.h>
+
+// Runs Bullet's parallel loops on the TBB worker threads the rest of the app uses, in an arena that limits
+// how many of them a physics step can take. Bullet only has one task scheduler at a time, see btSetTaskScheduler().
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    PhysicsTaskScheduler();
+
+    virtual int getMaxNumThreads() const override;
+    virtual int getNumThreads() const override { return _numThreads; }
+    virtual void setNumThreads(int numThreads) override;
+    virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    virtual btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    std::unique_ptr<tbb::task_arena> _arena;
+    int _numThreads { 1 };
+};
+
+#endif // hifi_PhysicsTaskScheduler_h
@@ -16,6 +16,7 @@
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "CollisionShapeCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,7 +28,19 @@ public:
         assert(_dataArray);
     }
 
+    // takes a BVH from the CollisionShapeCache instead of building one
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* cachedBvh)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _cachedBvh(cachedBvh) {
+        assert(_dataArray);
+        assert(_cachedBvh);
+        setOptimizedBvh(_cachedBvh);
+    }
+
     ~StaticMeshShape() {
+        // the base class only deletes a BVH it built itself
+        CollisionShapeCache::deleteBvh(_cachedBvh);
+        _cachedBvh = nullptr;
+
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -47,6 +60,7 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    btOptimizedBvh* _cachedBvh { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,7 +284,7 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, CollisionShapeCache* cache) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -430,7 +444,18 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         break;
         case SHAPE_TYPE_STATIC_MESH: {
             btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
-            if (dataArray) {
+            if (dataArray && cache) {
+                // sorting the triangles into a BVH is most of the work, hashing the mesh is much cheaper
+                QByteArray meshHash = CollisionShapeCache::hashMesh(dataArray->getIndexedMeshArray()[0]);
+                btOptimizedBvh* cachedBvh = cache->fetch(info.getHash(), meshHash);
+                if (cachedBvh) {
+                    shape = new StaticMeshShape(dataArray, cachedBvh);
+                } else {
+                    auto meshShape = new StaticMeshShape(dataArray);
+                    cache->store(info.getHash(), meshHash, *meshShape->getOptimizedBvh());
+                    shape = meshShape;
+                }
+            } else if (dataArray) {
                 shape = new StaticMeshShape(dataArray);
             }
         }
@@ -489,6 +514,6 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
 }
 
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    shape = ShapeFactory::createShapeFromInfo(shapeInfo, cache.get());
     emit submitWork(this);
 }
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <vector>
 
 #include <QObject>
@@ -22,6 +23,7 @@
 
 #include <ShapeInfo.h>
 
+#include "CollisionShapeCache.h"
 #include "ShapeFactory.h"
 #include "HashKey.h"
 
@@ -46,6 +48,9 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// Static mesh shapes are built on worker threads.  With a CollisionShapeCache the workers
+// load the BVHs of meshes they have built before from disk instead of building them again.
 
 
 class ShapeManager : public QObject {
@@ -66,6 +71,10 @@ public:
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// \param cache where the workers keep the BVHs of static mesh shapes, nullptr to always build them
+    void setCache(const std::shared_ptr<CollisionShapeCache>& cache) { _cache = cache; }
+    const std::shared_ptr<CollisionShapeCache>& getCache() const { return _cache; }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
     int getNumReferences(const ShapeInfo& info) const;
@@ -103,6 +112,7 @@ private:
     std::vector<uint64_t> _pendingMeshShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
+    std::shared_ptr<CollisionShapeCache> _cache;
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
@@ -21,33 +21,26 @@
 
 #include "Profile.h"
 
-ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
-        btDispatcher* dispatcher,
-        btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
-        btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
-}
-
-int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
+template <typename DiscreteDynamicsWorld>
+int ThreadSafeDynamicsWorldT<DiscreteDynamicsWorld>::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
                                                                btScalar fixedTimeStep, SubStepCallback onSubStep) {
     DETAILED_PROFILE_RANGE(simulation_physics, "stepWithCB");
     BT_PROFILE("stepSimulationWithSubstepCallback");
     int subSteps = 0;
     if (maxSubSteps) {
         //fixed timestep with interpolation
-        m_fixedTimeStep = fixedTimeStep;
-        m_localTime += timeStep;
-        if (m_localTime >= fixedTimeStep)
+        this->m_fixedTimeStep = fixedTimeStep;
+        this->m_localTime += timeStep;
+        if (this->m_localTime >= fixedTimeStep)
         {
-            subSteps = int( m_localTime / fixedTimeStep);
-            m_localTime -= subSteps * fixedTimeStep;
+            subSteps = int( this->m_localTime / fixedTimeStep);
+            this->m_localTime -= subSteps * fixedTimeStep;
         }
     } else {
         //variable timestep
         fixedTimeStep = timeStep;
-        m_localTime = m_latencyMotionStateInterpolation ? 0 : timeStep;
-        m_fixedTimeStep = 0;
+        this->m_localTime = this->m_latencyMotionStateInterpolation ? 0 : timeStep;
+        this->m_fixedTimeStep = 0;
         if (btFuzzyZero(timeStep))
         {
             subSteps = 0;
@@ -70,12 +63,12 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
         {
             DETAILED_PROFILE_RANGE(simulation_physics, "applyGravity");
             BT_PROFILE("applyGravity");
-            applyGravity();
+            this->applyGravity();
         }
 
         for (int i=0;i<clampedSimulationSteps;i++) {
             DETAILED_PROFILE_RANGE(simulation_physics, "substep");
-            internalSingleStepSimulation(fixedTimeStep);
+            this->internalSingleStepSimulation(fixedTimeStep);
             onSubStep();
         }
     }
@@ -87,13 +80,14 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
     // NOTE: We do NOT call synchronizeMotionStates() here.  Instead it is called by an external class
     // that knows how to lock threads correctly.
 
-    clearForces();
+    this->clearForces();
 
     return subSteps;
 }
 
 // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
-void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
+template <typename DiscreteDynamicsWorld>
+void ThreadSafeDynamicsWorldT<DiscreteDynamicsWorld>::synchronizeMotionState(btRigidBody* body) {
     btAssert(body);
     btAssert(body->getMotionState());
 
@@ -112,22 +106,23 @@ void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
     btTransform interpolatedTransform;
     btTransformUtil::integrateTransform(body->getInterpolationWorldTransform(),
         body->getInterpolationLinearVelocity(),body->getInterpolationAngularVelocity(),
-        (m_latencyMotionStateInterpolation && m_fixedTimeStep) ? m_localTime - m_fixedTimeStep : m_localTime*body->getHitFraction(),
+        (this->m_latencyMotionStateInterpolation && this->m_fixedTimeStep) ? this->m_localTime - this->m_fixedTimeStep : this->m_localTime*body->getHitFraction(),
         interpolatedTransform);
     body->getMotionState()->setWorldTransform(interpolatedTransform);
 }
 
-void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
+template <typename DiscreteDynamicsWorld>
+void ThreadSafeDynamicsWorldT<DiscreteDynamicsWorld>::synchronizeMotionStates() {
     PROFILE_RANGE(simulation_physics, "SyncMotionStates");
     BT_PROFILE("syncMotionStates");
     _changedMotionStates.clear();
 
     // NOTE: m_synchronizeAllMotionStates is 'false' by default for optimization.
     // See PhysicsEngine::init() where we call _dynamicsWorld->setForceUpdateAllAabbs(false)
-    if (m_synchronizeAllMotionStates) {
+    if (this->m_synchronizeAllMotionStates) {
         //iterate  over all collision objects
-        for (int i=0;i<m_collisionObjects.size();i++) {
-            btCollisionObject* colObj = m_collisionObjects[i];
+        for (int i=0;i<this->m_collisionObjects.size();i++) {
+            btCollisionObject* colObj = this->m_collisionObjects[i];
             btRigidBody* body = btRigidBody::upcast(colObj);
             if (body && body->getMotionState()) {
                 synchronizeMotionState(body);
@@ -140,8 +135,8 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
         // that remembers a list of objects deactivated last step
         _activeStates.clear();
         _deactivatedStates.clear();
-        for (int i=0;i<m_nonStaticRigidBodies.size();i++) {
-            btRigidBody* body = m_nonStaticRigidBodies[i];
+        for (int i=0;i<this->m_nonStaticRigidBodies.size();i++) {
+            btRigidBody* body = this->m_nonStaticRigidBodies[i];
             ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getMotionState());
             if (motionState) {
                 if (body->isActive()) {
@@ -158,11 +153,12 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
     _activeStates.swap(_lastActiveStates);
 }
 
-void ThreadSafeDynamicsWorld::saveKinematicState(btScalar timeStep) {
+template <typename DiscreteDynamicsWorld>
+void ThreadSafeDynamicsWorldT<DiscreteDynamicsWorld>::saveKinematicState(btScalar timeStep) {
     DETAILED_PROFILE_RANGE(simulation_physics, "saveKinematicState");
     BT_PROFILE("saveKinematicState");
-    for (int i=0;i<m_nonStaticRigidBodies.size();i++) {
-        btRigidBody* body = m_nonStaticRigidBodies[i];
+    for (int i=0;i<this->m_nonStaticRigidBodies.size();i++) {
+        btRigidBody* body = this->m_nonStaticRigidBodies[i];
         if (body && body->isKinematicObject() && body->getActivationState() != ISLAND_SLEEPING) {
             if (body->getMotionState()) {
                 btMotionState* motionState = body->getMotionState();
@@ -175,7 +171,8 @@ void ThreadSafeDynamicsWorld::saveKinematicState(btScalar timeStep) {
     }
 }
 
-void ThreadSafeDynamicsWorld::drawConnectedSpheres(btIDebugDraw* drawer, btScalar radius1, btScalar radius2, const btVector3& position1, const btVector3& position2, const btVector3& color) {
+template <typename DiscreteDynamicsWorld>
+void ThreadSafeDynamicsWorldT<DiscreteDynamicsWorld>::drawConnectedSpheres(btIDebugDraw* drawer, btScalar radius1, btScalar radius2, const btVector3& position1, const btVector3& position2, const btVector3& color) {
     float stepRadians = PI/6.0f; // 30 degrees
     btVector3 direction = position2 - position1;
     btVector3 xAxis = direction.cross(btVector3(0.0f, 1.0f, 0.0f));
@@ -195,8 +192,9 @@ void ThreadSafeDynamicsWorld::drawConnectedSpheres(btIDebugDraw* drawer, btScala
     }
 }
 
-void ThreadSafeDynamicsWorld::debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) {
-    btCollisionWorld::debugDrawObject(worldTransform, shape, color);
+template <typename DiscreteDynamicsWorld>
+void ThreadSafeDynamicsWorldT<DiscreteDynamicsWorld>::debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) {
+    this->btCollisionWorld::debugDrawObject(worldTransform, shape, color);
     if (shape->getShapeType() == MULTI_SPHERE_SHAPE_PROXYTYPE) {
         const btMultiSphereShape* multiSphereShape = static_cast<const btMultiSphereShape*>(shape);
         for (int i = multiSphereShape->getSphereCount() - 1; i >= 0; i--) {
@@ -209,11 +207,15 @@ void ThreadSafeDynamicsWorld::debugDrawObject(const btTransform& worldTransform,
             sphereTransform2.setOrigin(multiSphereShape->getSpherePosition(sphereIndex2));
             sphereTransform1 = worldTransform * sphereTransform1;
             sphereTransform2 = worldTransform * sphereTransform2;
-            getDebugDrawer()->drawSphere(multiSphereShape->getSphereRadius(sphereIndex1), sphereTransform1, color);
-            drawConnectedSpheres(getDebugDrawer(), multiSphereShape->getSphereRadius(sphereIndex1), multiSphereShape->getSphereRadius(sphereIndex2), sphereTransform1.getOrigin(), sphereTransform2.getOrigin(), color);
+            this->getDebugDrawer()->drawSphere(multiSphereShape->getSphereRadius(sphereIndex1), sphereTransform1, color);
+            drawConnectedSpheres(this->getDebugDrawer(), multiSphereShape->getSphereRadius(sphereIndex1), multiSphereShape->getSphereRadius(sphereIndex2), sphereTransform1.getOrigin(), sphereTransform2.getOrigin(), color);
         }
     } else {
-        btCollisionWorld::debugDrawObject(worldTransform, shape, color);
+        this->btCollisionWorld::debugDrawObject(worldTransform, shape, color);
     }
 }
 
+template class ThreadSafeDynamicsWorldT<btDiscreteDynamicsWorld>;
+#if defined(USE_BULLET_MULTITHREADING) && BT_THREADSAFE
+template class ThreadSafeDynamicsWorldT<btDiscreteDynamicsWorldMt>;
+#endif
@@ -20,39 +20,62 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#if defined(USE_BULLET_MULTITHREADING) && BT_THREADSAFE
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#endif
 
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <utility>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// What PhysicsEngine steps its world with on top of Bullet's own API. The motion states are only ever touched from the
+// thread that steps the world.
+class ThreadSafeDynamicsWorld {
+public:
+    virtual ~ThreadSafeDynamicsWorld() {}
+
+    virtual int getNumSubsteps() const = 0;
+    virtual int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
+                                                  btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
+                                                  SubStepCallback onSubStep = []() { }) = 0;
+
+    // btDiscreteDynamicsWorld::m_localTime is the portion of real-time that has not yet been simulated
+    // but is used for MotionState::setWorldTransform() extrapolation (a feature that Bullet uses to provide
+    // smoother rendering of objects when the physics simulation loop is ansynchronous to the render loop).
+    virtual float getLocalTimeAccumulation() const = 0;
+
+    virtual const VectorOfMotionStates& getChangedMotionStates() const = 0;
+    virtual const VectorOfMotionStates& getDeactivatedMotionStates() const = 0;
+
+    virtual void addChangedMotionState(ObjectMotionState* motionState) = 0;
+};
+
+// The ThreadSafeDynamicsWorld on top of a Bullet world, either the single threaded btDiscreteDynamicsWorld or, when
+// physics is built with USE_BULLET_MULTITHREADING, the btDiscreteDynamicsWorldMt that solves the islands on several threads.
+// The constructor takes the arguments of the Bullet world's.
+template <typename DiscreteDynamicsWorld>
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorldT : public DiscreteDynamicsWorld, public ThreadSafeDynamicsWorld {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
-    ThreadSafeDynamicsWorld(
-            btDispatcher* dispatcher,
-            btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
-            btCollisionConfiguration* collisionConfiguration);
+    template <typename... Args>
+    ThreadSafeDynamicsWorldT(Args&&... args) : DiscreteDynamicsWorld(std::forward<Args>(args)...) {}
 
-    int getNumSubsteps() const { return _numSubsteps; }
-    int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
-                                          btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
-                                          SubStepCallback onSubStep = []() { });
+    virtual int getNumSubsteps() const override { return _numSubsteps; }
+    virtual int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps, btScalar fixedTimeStep,
+                                                  SubStepCallback onSubStep) override;
     virtual void synchronizeMotionStates() override;
     virtual void saveKinematicState(btScalar timeStep) override;
 
-    // btDiscreteDynamicsWorld::m_localTime is the portion of real-time that has not yet been simulated
-    // but is used for MotionState::setWorldTransform() extrapolation (a feature that Bullet uses to provide
-    // smoother rendering of objects when the physics simulation loop is ansynchronous to the render loop).
-    float getLocalTimeAccumulation() const { return m_localTime; }
+    virtual float getLocalTimeAccumulation() const override { return this->m_localTime; }
 
-    const VectorOfMotionStates& getChangedMotionStates() const { return _changedMotionStates; }
-    const VectorOfMotionStates& getDeactivatedMotionStates() const { return _deactivatedStates; }
+    virtual const VectorOfMotionStates& getChangedMotionStates() const override { return _changedMotionStates; }
+    virtual const VectorOfMotionStates& getDeactivatedMotionStates() const override { return _deactivatedStates; }
 
-    void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
+    virtual void addChangedMotionState(ObjectMotionState* motionState) override { _changedMotionStates.push_back(motionState); }
     virtual void debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) override;
 
 private:
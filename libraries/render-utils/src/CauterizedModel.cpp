@@ -98,11 +98,11 @@ void CauterizedModel::createRenderItemSet() {
     }
 }
 
-void CauterizedModel::updateClusterMatrices() {
+bool CauterizedModel::updateClusterMatricesDeferringBlend() {
     PerformanceTimer perfTimer("CauterizedModel::updateClusterMatrices");
 
     if (!_needsUpdateClusterMatrices || !isLoaded()) {
-        return;
+        return false;
     }
     _needsUpdateClusterMatrices = false;
     const HFMModel& hfmModel = getHFMModel();
@@ -175,12 +175,7 @@ void CauterizedModel::updateClusterMatrices() {
         }
     }
 
-    // post the blender if we're not currently waiting for one to finish
-    auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && hfmModel.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
-    }
+    return takeBlendshapeChanges();
 }
 
 void CauterizedModel::updateRenderItems() {
@@ -137,6 +137,30 @@ void MeshPartPayload::bindMesh(gpu::Batch& batch) {
     batch.setModelTransform(_drawTransform);
 }
 
+void MeshPartPayload::reportTextureScreenSize(RenderArgs* args) const {
+    // shadows and mirrors don't say much about how sharp the textures need to be
+    if (args->_renderMode != RenderArgs::RenderMode::DEFAULT_RENDER_MODE || !args->_enableTexturing) {
+        return;
+    }
+    auto textureTable = _drawMaterials.getTextureTable();
+    if (!textureTable) {
+        return;
+    }
+
+    // the bound stands in for the texture's footprint, there's no telling how the UVs are spread over it
+    const auto& viewFrustum = args->getViewFrustum();
+    auto bound = getBound();
+    float size = bound.getLargestDimension();
+    float distance = glm::max(glm::distance(viewFrustum.getPosition(), bound.calcCenter()), size);
+    float pixels = (float)args->_viewport.w * size / (2.0f * distance * tanf(glm::radians(viewFrustum.getFieldOfView()) * 0.5f));
+
+    for (const auto& texture : textureTable->getTextures()) {
+        if (texture) {
+            texture->reportScreenSize(pixels);
+        }
+    }
+}
+
 
 void MeshPartPayload::render(RenderArgs* args) {
     PerformanceTimer perfTimer("MeshPartPayload::render");
@@ -157,6 +181,7 @@ void MeshPartPayload::render(RenderArgs* args) {
     if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
         args->_details._materialSwitches++;
     }
+    reportTextureScreenSize(args);
 
     // Draw!
     {
@@ -436,6 +461,7 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
         args->_details._materialSwitches++;
     }
+    reportTextureScreenSize(args);
 
     // Draw!
     {
@@ -50,6 +50,8 @@ public:
     void drawCall(gpu::Batch& batch) const;
     virtual void bindMesh(gpu::Batch& batch);
     virtual void bindTransform(gpu::Batch& batch, RenderArgs::RenderMode renderMode) const;
+    // Tells the material textures how many pixels across they're drawn, so their mips stream in by what's on screen
+    void reportTextureScreenSize(RenderArgs* args) const;
 
     // Payload resource cached values
     Transform _drawTransform;
@@ -1377,12 +1377,19 @@ void Model::updateRig(float deltaTime, glm::mat4 parentTransform) {
     _rig.updateAnimations(deltaTime, parentTransform, rigToWorldTransform);
 }
 
-// virtual
 void Model::updateClusterMatrices() {
+    // post the blender if we're not currently waiting for one to finish
+    if (updateClusterMatricesDeferringBlend()) {
+        DependencyManager::get<ModelBlender>()->noteRequiresBlend(getThisPointer());
+    }
+}
+
+// virtual
+bool Model::updateClusterMatricesDeferringBlend() {
     DETAILED_PERFORMANCE_TIMER("Model::updateClusterMatrices");
 
     if (!_needsUpdateClusterMatrices || !isLoaded()) {
-        return;
+        return false;
     }
 
     _needsUpdateClusterMatrices = false;
@@ -1408,12 +1415,17 @@ void Model::updateClusterMatrices() {
         }
     }
 
-    // post the blender if we're not currently waiting for one to finish
+    return takeBlendshapeChanges();
+}
+
+bool Model::takeBlendshapeChanges() {
     auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && hfmModel.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
+    if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() &&
+        _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
         _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
+        return true;
     }
+    return false;
 }
 
 void Model::deleteGeometry() {
@@ -1716,6 +1728,20 @@ static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, Blends
     }
 }
 
+// tangents can be null, to leave the tangent offsets alone
+static void accumulateBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, const int* indices, const glm::vec3* vertices,
+                                            const glm::vec3* normals, const glm::vec3* tangents, int size,
+                                            float vertexCoefficient, float normalCoefficient) {
+    for (int i = 0; i < size; ++i) {
+        auto& currentBlendshapeOffset = unpacked[indices[i]];
+        currentBlendshapeOffset.positionOffset += vertices[i] * vertexCoefficient;
+        currentBlendshapeOffset.normalOffset += normals[i] * normalCoefficient;
+        if (tangents) {
+            currentBlendshapeOffset.tangentOffset += tangents[i] * normalCoefficient;
+        }
+    }
+}
+
 #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 //
 // Runtime CPU dispatch
@@ -1723,6 +1749,9 @@ static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, Blends
 #include <CPUDetect.h>
 
 void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int size);
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*vertices)[3],
+                                      const float (*normals)[3], const float (*tangents)[3], int size,
+                                      float vertexCoefficient, float normalCoefficient);
 
 static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, BlendshapeOffsetPacked* packed, int size) {
     static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
@@ -1735,8 +1764,22 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
     }
 }
 
+static void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const int* indices, const glm::vec3* vertices,
+                                        const glm::vec3* normals, const glm::vec3* tangents, int size,
+                                        float vertexCoefficient, float normalCoefficient) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "struct glm::vec3 size doesn't match.");
+        accumulateBlendshapeOffsets_AVX2((float(*)[9])unpacked, indices, (const float(*)[3])vertices, (const float(*)[3])normals,
+                                         (const float(*)[3])tangents, size, vertexCoefficient, normalCoefficient);
+    } else {
+        accumulateBlendshapeOffsets_ref(unpacked, indices, vertices, normals, tangents, size, vertexCoefficient, normalCoefficient);
+    }
+}
+
 #else   // portable reference code
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
 #endif
 
 class Blender : public QRunnable {
@@ -1808,16 +1851,17 @@ void Blender::run() {
 
             float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
             const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
-
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
-                }
-            }
+            int numIndices = blendshape.indices.size();
+            Q_ASSERT(blendshape.vertices.size() >= numIndices && blendshape.normals.size() >= numIndices);
+
+            // the tangents may stop short of the rest
+            int numTangents = std::min(numIndices, blendshape.tangents.size());
+            accumulateBlendshapeOffsets(unpackedBlendshapeOffsets.data(), blendshape.indices.constData(),
+                                        blendshape.vertices.constData(), blendshape.normals.constData(),
+                                        blendshape.tangents.constData(), numTangents, vertexCoefficient, normalCoefficient);
+            accumulateBlendshapeOffsets(unpackedBlendshapeOffsets.data(), blendshape.indices.constData() + numTangents,
+                                        blendshape.vertices.constData() + numTangents, blendshape.normals.constData() + numTangents,
+                                        nullptr, numIndices - numTangents, vertexCoefficient, normalCoefficient);
         }
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
@@ -175,7 +175,10 @@ public:
     bool getSnapModelToRegistrationPoint() { return _snapModelToRegistrationPoint; }
 
     virtual void simulate(float deltaTime, bool fullUpdate = true);
-    virtual void updateClusterMatrices();
+    void updateClusterMatrices();
+    /// Updates the cluster matrices without posting the blender, and returns whether it needs posting. Can run off the
+    /// main thread as long as the blender is then posted with ModelBlender::noteRequiresBlend on the main thread.
+    virtual bool updateClusterMatricesDeferringBlend();
 
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
@@ -381,6 +384,8 @@ protected:
     void applyMaterialMapping();
 
     void setBlendshapeCoefficients(const QVector<float>& coefficients) { _blendshapeCoefficients = coefficients; }
+    /// Whether the blendshapes changed since the last blend was asked for, marking them as blended if so
+    bool takeBlendshapeChanges();
     const QVector<float>& getBlendshapeCoefficients() const { return _blendshapeCoefficients; }
 
     /// Clear the joint states
@@ -31,12 +31,12 @@ int SoftAttachmentModel::getJointIndexOverride(int i) const {
 
 // virtual
 // use the _rigOverride matrices instead of the Model::_rig
-void SoftAttachmentModel::updateClusterMatrices() {
+bool SoftAttachmentModel::updateClusterMatricesDeferringBlend() {
     if (!_needsUpdateClusterMatrices) {
-        return;
+        return false;
     }
     if (!isLoaded()) {
-        return;
+        return false;
     }
 
     _needsUpdateClusterMatrices = false;
@@ -69,10 +69,5 @@ void SoftAttachmentModel::updateClusterMatrices() {
         }
     }
 
-    // post the blender if we're not currently waiting for one to finish
-    auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && hfmModel.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
-    }
+    return takeBlendshapeChanges();
 }
@@ -10,8 +10,11 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -152,6 +155,19 @@ void Transaction::merge(Transaction&& transaction) {
     moveElements(_highlightQueries, transaction._highlightQueries);
 }
 
+template <typename T>
+void sortElementsByID(T& elements) {
+    std::stable_sort(elements.begin(), elements.end(), [](const typename T::value_type& a, const typename T::value_type& b) {
+        return std::get<0>(a) < std::get<0>(b);
+    });
+}
+
+void Transaction::sortItemsByID() {
+    sortElementsByID(_resetItems);
+    std::sort(_removedItems.begin(), _removedItems.end());
+    sortElementsByID(_updatedItems);
+}
+
 void Transaction::merge(const Transaction& transaction) {
     copyElements(_resetItems, transaction._resetItems);
     copyElements(_removedItems, transaction._removedItems);
@@ -181,7 +197,10 @@ void Transaction::clear() {
 }
 
 
+class Scene::PendingTransactions : public tbb::concurrent_queue<Transaction> {};
+
 Scene::Scene(glm::vec3 origin, float size) :
+    _transactionQueue(std::make_unique<PendingTransactions>()),
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
@@ -202,25 +221,36 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    _transactionQueue->push(transaction);
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    _transactionQueue->push(std::move(transaction));
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
+    uint64_t mergeStart = usecTimestampNow();
     TransactionQueue localTransactionQueue;
     {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+        // transactions that arrive while we drain the queue wait for the next frame
+        size_t numQueued = _transactionQueue->unsafe_size();
+        localTransactionQueue.reserve(numQueued);
+        Transaction transaction;
+        while (localTransactionQueue.size() < numQueued && _transactionQueue->try_pop(transaction)) {
+            localTransactionQueue.push_back(std::move(transaction));
+        }
     }
+    uint32_t numTransactions = (uint32_t)localTransactionQueue.size();
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
+    consolidatedTransaction.sortItemsByID();
+
+    uint64_t mergeTime = usecTimestampNow() - mergeStart;
+    _numFrameTransactions.store(numTransactions);
+    _frameMergeTime.store(mergeTime);
+    PROFILE_COUNTER(render, "sceneTransactions", { { "transactions", numTransactions }, { "mergeUsecs", (quint64)mergeTime } });
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
         _transactionFrames.push_back(consolidatedTransaction);
@@ -76,6 +76,10 @@ public:
     void merge(Transaction&& transaction);
     void clear();
 
+    // Orders the item changes by ID so they are applied in the order of the items in the scene.
+    // The changes to any one item keep their order.
+    void sortItemsByID();
+
 protected:
 
     using Reset = std::tuple<ItemID, PayloadPointer>;
@@ -158,6 +162,10 @@ public:
     // Process the pending transactions queued
     void processTransactionQueue();
 
+    // The number of transactions consolidated by the last enqueueFrame(), and how long that took in usecs
+    uint32_t getNumFrameTransactions() const { return _numFrameTransactions.load(); }
+    uint64_t getFrameMergeTime() const { return _frameMergeTime.load(); }
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -199,10 +207,12 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
+    // transactions are enqueued from any thread without taking a lock, into a tbb::concurrent_queue
+    class PendingTransactions;
+    std::unique_ptr<PendingTransactions> _transactionQueue;
+    std::atomic<uint32_t> _numFrameTransactions { 0 };
+    std::atomic<uint64_t> _frameMergeTime { 0 };
 
-    
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
@@ -1259,6 +1259,7 @@ void ScriptEngine::run() {
                 auto postUpdate = clock::now();
                 auto elapsed = (postUpdate - preUpdate);
                 totalUpdates += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+                _totalExecutionUsecs += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
             }
         }
         _lastUpdate = now;
@@ -1392,9 +1393,23 @@ void ScriptEngine::timerFired() {
     QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
     CallbackData timerData = _timerFunctionMap.value(callingTimer);
 
+    // track how late this timer fired, then work out when it's due next
+    auto dueTime = _timerDueTimes.find(callingTimer);
+    if (dueTime != _timerDueTimes.end()) {
+        quint64 now = usecTimestampNow();
+        quint64 lag = now > dueTime.value() ? now - dueTime.value() : 0;
+        _timersFired++;
+        _totalTimerLagUsecs += lag;
+        quint64 maxLag = _maxTimerLagUsecs;
+        while (lag > maxLag && !_maxTimerLagUsecs.compare_exchange_weak(maxLag, lag)) {
+        }
+        dueTime.value() = now + (quint64)callingTimer->interval() * USECS_PER_MSEC;
+    }
+
     if (!callingTimer->isActive()) {
         // this timer is done, we can kill it
         _timerFunctionMap.remove(callingTimer);
+        _timerDueTimes.remove(callingTimer);
         delete callingTimer;
     }
 
@@ -1406,6 +1421,7 @@ void ScriptEngine::timerFired() {
         auto postTimer = p_high_resolution_clock::now();
         auto elapsed = (postTimer - preTimer);
         _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        _totalExecutionUsecs += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
     } else {
         qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
     }
@@ -1430,6 +1446,7 @@ QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int
 
     CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
     _timerFunctionMap.insert(newTimer, timerData);
+    _timerDueTimes.insert(newTimer, usecTimestampNow() + (quint64)intervalMS * USECS_PER_MSEC);
 
     newTimer->start(intervalMS);
     return newTimer;
@@ -1459,6 +1476,7 @@ void ScriptEngine::stopTimer(QTimer *timer) {
     if (_timerFunctionMap.contains(timer)) {
         timer->stop();
         _timerFunctionMap.remove(timer);
+        _timerDueTimes.remove(timer);
         delete timer;
     } else {
         qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
@@ -667,6 +667,15 @@ public:
 
     void setScriptEngines(QSharedPointer<ScriptEngines>& scriptEngines) { _scriptEngines = scriptEngines; }
 
+    // Running totals of time spent executing script code on this engine's thread and of how late timers fired
+    // relative to when they were due.  Only timers and update handlers are counted.  The lag is an approximation
+    // based on the timer's interval, not its exact scheduled time.  Safe to read from any thread.
+    quint64 getTotalExecutionUsecs() const { return _totalExecutionUsecs; }
+    quint64 getTimersFired() const { return _timersFired; }
+    quint64 getTotalTimerLagUsecs() const { return _totalTimerLagUsecs; }
+    quint64 getMaxTimerLagUsecs() const { return _maxTimerLagUsecs; }
+    void resetMaxTimerLag() { _maxTimerLagUsecs = 0; }
+
 public slots:
 
     /**jsdoc
@@ -958,6 +967,12 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    QHash<QTimer*, quint64> _timerDueTimes;
+    std::atomic<quint64> _totalExecutionUsecs { 0 };
+    std::atomic<quint64> _timersFired { 0 };
+    std::atomic<quint64> _totalTimerLagUsecs { 0 };
+    std::atomic<quint64> _maxTimerLagUsecs { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
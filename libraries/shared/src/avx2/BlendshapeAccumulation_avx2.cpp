@@ -0,0 +1,201 @@
+//
+//  BlendshapeAccumulation_avx2.cpp
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+static inline void accumulateBlendshapeOffset(float* unpacked, const float* vertex, const float* normal, const float* tangent,
+                                              float vertexCoefficient, float normalCoefficient) {
+    unpacked[0] += vertex[0] * vertexCoefficient;
+    unpacked[1] += vertex[1] * vertexCoefficient;
+    unpacked[2] += vertex[2] * vertexCoefficient;
+    unpacked[3] += normal[0] * normalCoefficient;
+    unpacked[4] += normal[1] * normalCoefficient;
+    unpacked[5] += normal[2] * normalCoefficient;
+    if (tangent) {
+        unpacked[6] += tangent[0] * normalCoefficient;
+        unpacked[7] += tangent[1] * normalCoefficient;
+        unpacked[8] += tangent[2] * normalCoefficient;
+    }
+}
+
+// 8x8 matrix transpose, its own inverse
+static inline void transpose8x8(__m256& r0, __m256& r1, __m256& r2, __m256& r3, __m256& r4, __m256& r5, __m256& r6, __m256& r7) {
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1,0,1,0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3,2,3,2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1,0,1,0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3,2,3,2));
+
+    r0 = _mm256_permute2f128_ps(s0, s4, 0x20);
+    r1 = _mm256_permute2f128_ps(s1, s5, 0x20);
+    r2 = _mm256_permute2f128_ps(s2, s6, 0x20);
+    r3 = _mm256_permute2f128_ps(s3, s7, 0x20);
+    r4 = _mm256_permute2f128_ps(s0, s4, 0x31);
+    r5 = _mm256_permute2f128_ps(s1, s5, 0x31);
+    r6 = _mm256_permute2f128_ps(s2, s6, 0x31);
+    r7 = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+// deinterleave 8 vec3 (8x3 to 3x8 matrix transpose)
+static inline void load8xVec3(const float (*v)[3], __m256& x, __m256& y, __m256& z) {
+    const float* p = v[0];
+    __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 0)), _mm_loadu_ps(p + 12), 1);
+    __m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+    __m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+    __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2,1,3,2));
+    __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1,0,2,1));
+    x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2,0,3,0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3,1,2,0));
+    z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3,0,3,1));
+}
+
+//
+// unpacked[indices[i]] += { vertices[i] * vertexCoefficient, normals[i] * normalCoefficient, tangents[i] * normalCoefficient }
+// tangents can be null, to leave the tangent offsets alone
+//
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*vertices)[3],
+                                      const float (*normals)[3], const float (*tangents)[3], int size,
+                                      float vertexCoefficient, float normalCoefficient) {
+
+    const __m256 vc = _mm256_set1_ps(vertexCoefficient);
+    const __m256 nc = _mm256_set1_ps(normalCoefficient);
+    const __m256i rotate1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+    int i = 0;
+    for (; i < size - 7; i += 8) {  // blocks of 8
+
+        //
+        // a vertex that shows up twice in a block would lose one of its offsets when the rows are written back,
+        // comparing against the rotations by 1 to 4 finds any pair
+        //
+        __m256i index = _mm256_loadu_si256((const __m256i*)&indices[i]);
+        __m256i rotated = _mm256_permutevar8x32_epi32(index, rotate1);
+        __m256i conflict = _mm256_cmpeq_epi32(index, rotated);
+        rotated = _mm256_permutevar8x32_epi32(rotated, rotate1);
+        conflict = _mm256_or_si256(conflict, _mm256_cmpeq_epi32(index, rotated));
+        rotated = _mm256_permutevar8x32_epi32(rotated, rotate1);
+        conflict = _mm256_or_si256(conflict, _mm256_cmpeq_epi32(index, rotated));
+        rotated = _mm256_permutevar8x32_epi32(rotated, rotate1);
+        conflict = _mm256_or_si256(conflict, _mm256_cmpeq_epi32(index, rotated));
+
+        if (!_mm256_testz_si256(conflict, conflict)) {
+            for (int j = i; j < i + 8; ++j) {
+                accumulateBlendshapeOffset(unpacked[indices[j]], vertices[j], normals[j], tangents ? tangents[j] : nullptr,
+                                           vertexCoefficient, normalCoefficient);
+            }
+            continue;
+        }
+
+        //
+        // deinterleave the offsets of the block (8x3 to 3x8) and scale them
+        //
+        __m256 dpx, dpy, dpz;
+        load8xVec3(&vertices[i], dpx, dpy, dpz);
+        dpx = _mm256_mul_ps(dpx, vc);
+        dpy = _mm256_mul_ps(dpy, vc);
+        dpz = _mm256_mul_ps(dpz, vc);
+
+        __m256 dnx, dny, dnz;
+        load8xVec3(&normals[i], dnx, dny, dnz);
+        dnx = _mm256_mul_ps(dnx, nc);
+        dny = _mm256_mul_ps(dny, nc);
+        dnz = _mm256_mul_ps(dnz, nc);
+
+        __m256 dtx = _mm256_setzero_ps();
+        __m256 dty = _mm256_setzero_ps();
+        __m256 dtz = _mm256_setzero_ps();
+        if (tangents) {
+            load8xVec3(&tangents[i], dtx, dty, dtz);
+            dtx = _mm256_mul_ps(dtx, nc);
+            dty = _mm256_mul_ps(dty, nc);
+            dtz = _mm256_mul_ps(dtz, nc);
+        }
+
+        //
+        // deinterleave the first 8 floats of the rows being accumulated into (8x8 matrix transpose)
+        //
+        float* row0 = unpacked[indices[i+0]];
+        float* row1 = unpacked[indices[i+1]];
+        float* row2 = unpacked[indices[i+2]];
+        float* row3 = unpacked[indices[i+3]];
+        float* row4 = unpacked[indices[i+4]];
+        float* row5 = unpacked[indices[i+5]];
+        float* row6 = unpacked[indices[i+6]];
+        float* row7 = unpacked[indices[i+7]];
+
+        __m256 px = _mm256_loadu_ps(row0);
+        __m256 py = _mm256_loadu_ps(row1);
+        __m256 pz = _mm256_loadu_ps(row2);
+        __m256 nx = _mm256_loadu_ps(row3);
+        __m256 ny = _mm256_loadu_ps(row4);
+        __m256 nz = _mm256_loadu_ps(row5);
+        __m256 tx = _mm256_loadu_ps(row6);
+        __m256 ty = _mm256_loadu_ps(row7);
+        transpose8x8(px, py, pz, nx, ny, nz, tx, ty);
+
+        px = _mm256_add_ps(px, dpx);
+        py = _mm256_add_ps(py, dpy);
+        pz = _mm256_add_ps(pz, dpz);
+        nx = _mm256_add_ps(nx, dnx);
+        ny = _mm256_add_ps(ny, dny);
+        nz = _mm256_add_ps(nz, dnz);
+        tx = _mm256_add_ps(tx, dtx);
+        ty = _mm256_add_ps(ty, dty);
+
+        //
+        // interleave (8x8 matrix transpose) and store the rows back
+        //
+        transpose8x8(px, py, pz, nx, ny, nz, tx, ty);
+        _mm256_storeu_ps(row0, px);
+        _mm256_storeu_ps(row1, py);
+        _mm256_storeu_ps(row2, pz);
+        _mm256_storeu_ps(row3, nx);
+        _mm256_storeu_ps(row4, ny);
+        _mm256_storeu_ps(row5, nz);
+        _mm256_storeu_ps(row6, tx);
+        _mm256_storeu_ps(row7, ty);
+
+        // the last float of each row
+        if (tangents) {
+            alignas(32) float tz[8];
+            _mm256_store_ps(tz, dtz);
+            row0[8] += tz[0];
+            row1[8] += tz[1];
+            row2[8] += tz[2];
+            row3[8] += tz[3];
+            row4[8] += tz[4];
+            row5[8] += tz[5];
+            row6[8] += tz[6];
+            row7[8] += tz[7];
+        }
+    }
+
+    for (; i < size; ++i) { // remainder
+        accumulateBlendshapeOffset(unpacked[indices[i]], vertices[i], normals[i], tangents ? tangents[i] : nullptr,
+                                   vertexCoefficient, normalCoefficient);
+    }
+}
+
+#endif
@@ -163,6 +163,9 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
             return file;
         } else {
             qCWarning(file_cache, "[%s] Overwriting %s", _dirname.c_str(), metadata.key.c_str());
+            // stop tracking the old file, and keep whoever still holds it from unlinking the one we're about to write
+            file->_shouldPersist = true;
+            eject(file);
             file.reset();
         }
     }
@@ -0,0 +1,87 @@
+//
+//  Space_avx2.cpp
+//  libraries/workload/src/avx2
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "../workload/Region.h"
+
+using namespace workload;
+
+static inline uint8_t classifyProxy(float x, float y, float z, float radius, const float (*viewRegions)[4], int numViewRegions) {
+    uint8_t region = Region::UNKNOWN;
+    for (int j = 0; j < numViewRegions; ++j) {
+        uint8_t k = (uint8_t)(j % Region::NUM_VIEW_REGIONS);
+        if (k < region) {
+            const float* sphere = viewRegions[j];
+            float dx = x - sphere[0];
+            float dy = y - sphere[1];
+            float dz = z - sphere[2];
+            float touchDistance = radius + sphere[3];
+            if (dx * dx + dy * dy + dz * dz < touchDistance * touchDistance) {
+                region = k;
+            }
+        }
+    }
+    return region;
+}
+
+//
+// regions[i] = the nearest view region that sphere i touches, or Region::UNKNOWN
+// viewRegions holds the Region::NUM_VIEW_REGIONS spheres of each view
+//
+void classifyProxies_AVX2(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                          int numProxies, const float (*viewRegions)[4], int numViews) {
+
+    int numViewRegions = numViews * Region::NUM_VIEW_REGIONS;
+    const __m256 unknown = _mm256_set1_ps((float)Region::UNKNOWN);
+
+    int i = 0;
+    for (; i < numProxies - 7; i += 8) {  // blocks of 8
+
+        __m256 px = _mm256_loadu_ps(&x[i]);
+        __m256 py = _mm256_loadu_ps(&y[i]);
+        __m256 pz = _mm256_loadu_ps(&z[i]);
+        __m256 pr = _mm256_loadu_ps(&radius[i]);
+
+        //
+        // the region of each sphere is the smallest one it touches, over all the views
+        //
+        __m256 region = unknown;
+        for (int j = 0; j < numViewRegions; ++j) {
+            const float* sphere = viewRegions[j];
+            __m256 dx = _mm256_sub_ps(px, _mm256_set1_ps(sphere[0]));
+            __m256 dy = _mm256_sub_ps(py, _mm256_set1_ps(sphere[1]));
+            __m256 dz = _mm256_sub_ps(pz, _mm256_set1_ps(sphere[2]));
+            __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            __m256 touchDistance = _mm256_add_ps(pr, _mm256_set1_ps(sphere[3]));
+            __m256 touching = _mm256_cmp_ps(distance2, _mm256_mul_ps(touchDistance, touchDistance), _CMP_LT_OQ);
+
+            __m256 k = _mm256_set1_ps((float)(j % Region::NUM_VIEW_REGIONS));
+            region = _mm256_min_ps(region, _mm256_blendv_ps(unknown, k, touching));
+        }
+
+        //
+        // narrow to bytes and store
+        //
+        __m256i region32 = _mm256_cvttps_epi32(region);
+        __m128i region16 = _mm_packus_epi32(_mm256_castsi256_si128(region32), _mm256_extracti128_si256(region32, 1));
+        __m128i region8 = _mm_packus_epi16(region16, region16);
+        _mm_storel_epi64((__m128i*)&regions[i], region8);
+    }
+
+    for (; i < numProxies; ++i) { // remainder
+        regions[i] = classifyProxy(x[i], y[i], z[i], radius[i], viewRegions, numViewRegions);
+    }
+}
+
+#endif
@@ -13,13 +13,62 @@
 //
 
 #include "Space.h"
-#include <cstring>
 #include <algorithm>
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <TBBHelpers.h>
+
 using namespace workload;
 
+// regions[i] = the nearest view region that sphere i touches, or Region::UNKNOWN
+// viewRegions holds the Region::NUM_VIEW_REGIONS spheres of each view
+static void classifyProxies_ref(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                                int numProxies, const float (*viewRegions)[4], int numViews) {
+    int numViewRegions = numViews * Region::NUM_VIEW_REGIONS;
+    for (int i = 0; i < numProxies; ++i) {
+        uint8_t region = Region::UNKNOWN;
+        for (int j = 0; j < numViewRegions; ++j) {
+            // for each 'view' we need only test the regions below the current value of 'region'
+            uint8_t k = (uint8_t)(j % Region::NUM_VIEW_REGIONS);
+            if (k < region) {
+                const float* sphere = viewRegions[j];
+                float dx = x[i] - sphere[0];
+                float dy = y[i] - sphere[1];
+                float dz = z[i] - sphere[2];
+                float touchDistance = radius[i] + sphere[3];
+                if (dx * dx + dy * dy + dz * dz < touchDistance * touchDistance) {
+                    region = k;
+                }
+            }
+        }
+        regions[i] = region;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void classifyProxies_AVX2(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                          int numProxies, const float (*viewRegions)[4], int numViews);
+
+static void classifyProxies(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                            int numProxies, const float (*viewRegions)[4], int numViews) {
+    static auto f = cpuSupportsAVX2() ? classifyProxies_AVX2 : classifyProxies_ref;
+    (*f)(x, y, z, radius, regions, numProxies, viewRegions, numViews); // dispatch
+}
+
+#else   // portable reference code
+static auto& classifyProxies = classifyProxies_ref;
+#endif
+
+// above this many proxies the classification is split across the TBB worker threads
+const uint32_t MIN_NUM_PROXIES_FOR_PARALLEL_CLASSIFY = 100000;
+const uint32_t CLASSIFY_GRAIN_SIZE = 16384;
+
 Space::Space() : Collection() {
 }
 
@@ -28,9 +77,8 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     // Here we should be able to check the value of last ProxyID allocated
     // and allocate new proxies accordingly
     ProxyID maxID = _IDAllocator.getNumAllocatedIndices();
-    if (maxID > (Index) _proxies.size()) {
-        _proxies.resize(maxID + 100); // allocate the maxId and more
-        _owners.resize(maxID + 100);
+    if (maxID > (Index) _regions.size()) {
+        resizeProxies(maxID + 100); // allocate the maxId and more
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -49,11 +97,13 @@ void Space::processResets(const Transaction::Resets& transactions) {
         if (!_IDAllocator.checkIndex(proxyID)) {
             continue;
         }
-        auto& item = _proxies[proxyID];
-
         // Reset the item with a new payload
-        item.sphere = (std::get<1>(reset));
-        item.prevRegion = item.region = Region::UNKNOWN;
+        const Sphere& sphere = std::get<1>(reset);
+        _proxyX[proxyID] = sphere.x;
+        _proxyY[proxyID] = sphere.y;
+        _proxyZ[proxyID] = sphere.z;
+        _proxyRadius[proxyID] = sphere.w;
+        _prevRegions[proxyID] = _regions[proxyID] = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -66,11 +116,8 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
         }
         _IDAllocator.freeIndex(removedID);
 
-        // Access the true item
-        auto& item = _proxies[removedID];
-
         // Kill it
-        item.prevRegion = item.region = Region::INVALID;
+        _prevRegions[removedID] = _regions[removedID] = Region::INVALID;
         _owners[removedID] = Owner();
     }
 }
@@ -82,39 +129,64 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Access the true item
-        auto& item = _proxies[updateID];
-
         // Update the item
-        item.sphere = (std::get<1>(update));
+        const Sphere& sphere = std::get<1>(update);
+        _proxyX[updateID] = sphere.x;
+        _proxyY[updateID] = sphere.y;
+        _proxyZ[updateID] = sphere.z;
+        _proxyRadius[updateID] = sphere.w;
     }
 }
 
+void Space::resizeProxies(uint32_t numProxies) {
+    _proxyX.resize(numProxies, 0.0f);
+    _proxyY.resize(numProxies, 0.0f);
+    _proxyZ.resize(numProxies, 0.0f);
+    _proxyRadius.resize(numProxies, 0.0f);
+    _regions.resize(numProxies, Region::INVALID);
+    _prevRegions.resize(numProxies, Region::INVALID);
+    _newRegions.resize(numProxies, Region::INVALID);
+    _owners.resize(numProxies);
+}
+
+void Space::classifyProxies(uint32_t begin, uint32_t end, const std::vector<Sphere>& viewRegions) {
+    static_assert(sizeof(Sphere) == 4 * sizeof(float), "Sphere size doesn't match.");
+    ::classifyProxies(&_proxyX[begin], &_proxyY[begin], &_proxyZ[begin], &_proxyRadius[begin], &_newRegions[begin],
+        (int)(end - begin), (const float(*)[4])viewRegions.data(), (int)_views.size());
+}
+
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
+    uint32_t numProxies = (uint32_t)_regions.size();
+    if (numProxies == 0) {
+        return;
+    }
+
+    std::vector<Sphere> viewRegions;
+    viewRegions.reserve(_views.size() * Region::NUM_VIEW_REGIONS);
+    for (const auto& view : _views) {
+        viewRegions.insert(viewRegions.end(), view.regions, view.regions + Region::NUM_VIEW_REGIONS);
+    }
+
+    // dead proxies are classified too, it's cheaper than skipping them
+    if (numProxies < MIN_NUM_PROXIES_FOR_PARALLEL_CLASSIFY) {
+        classifyProxies(0, numProxies, viewRegions);
+    } else {
+        // we hold _proxiesMutex, so this thread mustn't pick up unrelated work while it waits
+        tbb::this_task_arena::isolate([&] {
+            tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numProxies, CLASSIFY_GRAIN_SIZE),
+                [&](const tbb::blocked_range<uint32_t>& range) {
+                    classifyProxies(range.begin(), range.end(), viewRegions);
+                });
+        });
+    }
+
     for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::UNKNOWN;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+        if (_regions[i] < Region::INVALID) {
+            _prevRegions[i] = _regions[i];
+            _regions[i] = _newRegions[i];
+            if (_regions[i] != _prevRegions[i]) {
+                changes.emplace_back(Space::Change((int32_t)i, _regions[i], _prevRegions[i]));
             }
         }
     }
@@ -122,14 +194,19 @@ void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    auto numCopied = std::min(numDestProxies, (uint32_t)_proxies.size());
-    memcpy(proxies, _proxies.data(), numCopied * sizeof(Proxy));
+    auto numCopied = std::min(numDestProxies, (uint32_t)_regions.size());
+    for (uint32_t i = 0; i < numCopied; ++i) {
+        Proxy& proxy = proxies[i];
+        proxy.sphere = Sphere(_proxyX[i], _proxyY[i], _proxyZ[i], _proxyRadius[i]);
+        proxy.region = _regions[i];
+        proxy.prevRegion = _prevRegions[i];
+    }
     return numCopied;
 }
 
 const Owner Space::getOwner(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
+    if (isAllocatedID(proxyID) && (proxyID < (Index)_owners.size())) {
         return _owners[proxyID];
     }
     return Owner();
@@ -137,8 +214,8 @@ const Owner Space::getOwner(int32_t proxyID) const {
 
 uint8_t Space::getRegion(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
-        return _proxies[proxyID].region;
+    if (isAllocatedID(proxyID) && (proxyID < (Index)_regions.size())) {
+        return _regions[proxyID];
     }
     return (uint8_t)Region::INVALID;
 }
@@ -147,8 +224,7 @@ void Space::clear() {
     Collection::clear();
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     _IDAllocator.clear();
-    _proxies.clear();
-    _owners.clear();
+    resizeProxies(0);
     _views.clear();
 }
 
@@ -59,9 +59,19 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
-    // The database of proxies is protected for editing by a mutex
+    void resizeProxies(uint32_t numProxies);
+    void classifyProxies(uint32_t begin, uint32_t end, const std::vector<Sphere>& viewRegions);
+
+    // The database of proxies is protected for editing by a mutex.
+    // It is kept as columns so the spheres can be classified many at a time.
     mutable std::mutex _proxiesMutex;
-    Proxy::Vector _proxies;
+    std::vector<float> _proxyX;
+    std::vector<float> _proxyY;
+    std::vector<float> _proxyZ;
+    std::vector<float> _proxyRadius;
+    std::vector<uint8_t> _regions;
+    std::vector<uint8_t> _prevRegions;
+    std::vector<uint8_t> _newRegions; // scratch for categorizeAndGetChanges()
     std::vector<Owner> _owners;
 
     Views _views;
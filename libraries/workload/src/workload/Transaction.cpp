@@ -10,6 +10,12 @@
 //
 #include "Transaction.h"
 
+#include <algorithm>
+
+#include <Profile.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
+
 using namespace workload;
 
 
@@ -102,18 +108,38 @@ void Transaction::clear() {
     _updatedItems.clear();
 }
 
+template <typename T>
+void sortElementsByID(T& elements) {
+    std::stable_sort(elements.begin(), elements.end(), [](const typename T::value_type& a, const typename T::value_type& b) {
+        return std::get<0>(a) < std::get<0>(b);
+    });
+}
+
+void Transaction::sortByID() {
+    sortElementsByID(_resetItems);
+    std::sort(_removedItems.begin(), _removedItems.end());
+    sortElementsByID(_updatedItems);
+}
+
+
 
 
+class Collection::PendingTransactions : public tbb::concurrent_queue<Transaction> {};
 
-Collection::Collection() {
+Collection::Collection() :
+    _transactionQueue(std::make_unique<PendingTransactions>())
+{
 }
 
 Collection::~Collection() {
 }
 
 void Collection::clear() {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.clear();
+    // concurrent_queue::clear() isn't safe against concurrent pushes, try_pop is
+    Transaction transaction;
+    while (_transactionQueue->try_pop(transaction)) {
+    }
+    std::unique_lock<std::mutex> lock(_transactionFramesMutex);
     _transactionFrames.clear();
 }
 
@@ -128,24 +154,35 @@ bool Collection::isAllocatedID(const ProxyID& id) const {
 
 /// Enqueue change batch to the Collection
 void Collection::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    _transactionQueue->push(transaction);
 }
 
 void Collection::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    _transactionQueue->push(std::move(transaction));
 }
 
 uint32_t Collection::enqueueFrame() {
+    uint64_t mergeStart = usecTimestampNow();
     TransactionQueue localTransactionQueue;
     {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+        // transactions that arrive while we drain the queue wait for the next frame
+        size_t numQueued = _transactionQueue->unsafe_size();
+        localTransactionQueue.reserve(numQueued);
+        Transaction transaction;
+        while (localTransactionQueue.size() < numQueued && _transactionQueue->try_pop(transaction)) {
+            localTransactionQueue.push_back(std::move(transaction));
+        }
     }
+    uint32_t numTransactions = (uint32_t)localTransactionQueue.size();
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
+    consolidatedTransaction.sortByID();
+
+    uint64_t mergeTime = usecTimestampNow() - mergeStart;
+    _numFrameTransactions.store(numTransactions);
+    _frameMergeTime.store(mergeTime);
+    PROFILE_COUNTER(workload, "spaceTransactions", { { "transactions", numTransactions }, { "mergeUsecs", (quint64)mergeTime } });
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
         _transactionFrames.push_back(consolidatedTransaction);
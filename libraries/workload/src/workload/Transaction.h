@@ -123,6 +123,9 @@ public:
     void merge(Transaction&& transaction);
     void clear();
 
+    // Orders the changes by proxy ID, the changes to any one proxy keep their order
+    void sortByID();
+
 protected:
 
 
@@ -160,14 +163,20 @@ public:
     // Process the pending transactions queued
     virtual void processTransactionQueue();
 
+    // The number of transactions consolidated by the last enqueueFrame(), and how long that took in usecs
+    uint32_t getNumFrameTransactions() const { return _numFrameTransactions.load(); }
+    uint64_t getFrameMergeTime() const { return _frameMergeTime.load(); }
+
 protected:
 
     // Thread safe elements that can be accessed from anywhere
     indexed_container::Allocator<> _IDAllocator;
 
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
-
+    // transactions are enqueued from any thread without taking a lock, into a tbb::concurrent_queue
+    class PendingTransactions;
+    std::unique_ptr<PendingTransactions> _transactionQueue;
+    std::atomic<uint32_t> _numFrameTransactions { 0 };
+    std::atomic<uint64_t> _frameMergeTime { 0 };
 
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
@@ -0,0 +1,103 @@
+//
+//  AnimCompressedClipTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimCompressedClipTests.h"
+
+#include <glm/gtc/random.hpp>
+
+#include <AnimCompressedClip.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimCompressedClipTests)
+
+const int NUM_JOINTS = 60;
+const int NUM_FRAMES = 300;
+const float BONE_LENGTH = 10.0f;
+
+// joints swinging at different rates, the last third of them still
+static std::vector<AnimPoseVec> makeAnimation(int numFrames) {
+    std::vector<glm::vec3> axes;
+    std::vector<float> rates;
+    std::vector<glm::vec3> offsets;
+    for (int joint = 0; joint < NUM_JOINTS; joint++) {
+        axes.push_back(glm::sphericalRand(1.0f));
+        rates.push_back(joint < 2 * NUM_JOINTS / 3 ? glm::linearRand(0.005f, 0.05f) : 0.0f);
+        offsets.push_back(glm::sphericalRand(BONE_LENGTH));
+    }
+
+    std::vector<AnimPoseVec> frames(numFrames);
+    for (int frame = 0; frame < numFrames; frame++) {
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            float swing = sinf(rates[joint] * (float)frame);
+            frames[frame].push_back(AnimPose(glm::vec3(1.0f), glm::angleAxis(swing, axes[joint]),
+                                             offsets[joint] + 0.1f * BONE_LENGTH * swing * axes[joint]));
+        }
+    }
+    return frames;
+}
+
+static void compareFrames(const AnimCompressedClip& clip, const std::vector<AnimPoseVec>& frames) {
+    // the quantization and the dropped keys each get within their tolerance
+    const float ROTATION_ERROR = 2.0f * AnimCompressedClip::ROTATION_TOLERANCE;
+    const float TRANSLATION_ERROR = 2.0f * AnimCompressedClip::TRANSLATION_TOLERANCE * 1.1f * BONE_LENGTH;
+    const float SCALE_ERROR = 2.0f * AnimCompressedClip::SCALE_TOLERANCE * SQUARE_ROOT_OF_3;
+
+    AnimPoseVec poses;
+    for (int frame = 0; frame < (int)frames.size(); frame++) {
+        clip.decode(frame, poses);
+        QCOMPARE(poses.size(), frames[frame].size());
+        for (size_t joint = 0; joint < poses.size(); joint++) {
+            QCOMPARE_WITH_ABS_ERROR(poses[joint].scale(), frames[frame][joint].scale(), SCALE_ERROR);
+            QCOMPARE_QUATS(poses[joint].rot(), frames[frame][joint].rot(), ROTATION_ERROR);
+            QCOMPARE_WITH_ABS_ERROR(poses[joint].trans(), frames[frame][joint].trans(), TRANSLATION_ERROR);
+        }
+    }
+}
+
+void AnimCompressedClipTests::testDecode() {
+    auto frames = makeAnimation(NUM_FRAMES);
+    AnimCompressedClip clip(frames);
+    QCOMPARE(clip.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clip.getNumJoints(), NUM_JOINTS);
+    compareFrames(clip, frames);
+
+    size_t uncompressedSize = NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose);
+    QVERIFY(clip.getMemorySize() < uncompressedSize / 2);
+}
+
+void AnimCompressedClipTests::testConstantTracks() {
+    AnimPoseVec pose;
+    for (int joint = 0; joint < NUM_JOINTS; joint++) {
+        pose.push_back(AnimPose(glm::vec3(2.0f), glm::angleAxis(0.1f * joint, Vectors::UNIT_Y), glm::vec3(0.0f, BONE_LENGTH, 0.0f)));
+    }
+    std::vector<AnimPoseVec> frames(NUM_FRAMES, pose);
+    AnimCompressedClip clip(frames);
+    compareFrames(clip, frames);
+
+    // a key per track
+    size_t uncompressedSize = NUM_JOINTS * sizeof(AnimPose);
+    QVERIFY(clip.getMemorySize() < uncompressedSize * 2);
+}
+
+void AnimCompressedClipTests::testSingleFrame() {
+    auto frames = makeAnimation(1);
+    AnimCompressedClip clip(frames);
+    QCOMPARE(clip.getNumFrames(), 1);
+    compareFrames(clip, frames);
+
+    // past the end is the last frame
+    AnimPoseVec poses;
+    clip.decode(10, poses);
+    QCOMPARE((int)poses.size(), NUM_JOINTS);
+}
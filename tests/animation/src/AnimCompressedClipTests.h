@@ -0,0 +1,24 @@
+//
+//  AnimCompressedClipTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimCompressedClipTests_h
+#define hifi_AnimCompressedClipTests_h
+
+#include <QtTest/QtTest>
+
+class AnimCompressedClipTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testDecode();
+    void testConstantTracks();
+    void testSingleFrame();
+};
+
+#endif // hifi_AnimCompressedClipTests_h
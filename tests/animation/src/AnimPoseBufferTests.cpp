@@ -0,0 +1,206 @@
+//
+//  AnimPoseBufferTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <iostream>
+
+#include <glm/gtc/random.hpp>
+
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float TEST_EPSILON = 0.0001f;
+const int NUM_POSES = 103;  // not a multiple of 4
+const int NUM_JOINTS = 70;
+
+static glm::quat randomRotation() {
+    return glm::angleAxis(glm::linearRand(-PI, PI), glm::sphericalRand(1.0f));
+}
+
+static AnimPose randomPose(bool uniformScale = true) {
+    glm::vec3 scale = uniformScale ? glm::vec3(glm::linearRand(0.5f, 2.0f)) : glm::linearRand(glm::vec3(0.5f), glm::vec3(2.0f));
+    return AnimPose(scale, randomRotation(), glm::ballRand(1.0f));
+}
+
+static void compareRotations(const glm::quat& a, const glm::quat& b) {
+    // q and -q are the same rotation
+    QCOMPARE_WITH_ABS_ERROR(fabsf(glm::dot(a, b)), 1.0f, TEST_EPSILON);
+}
+
+static void comparePoses(const AnimPose& a, const AnimPose& b) {
+    QCOMPARE_WITH_ABS_ERROR(a.scale(), b.scale(), TEST_EPSILON);
+    compareRotations(a.rot(), b.rot());
+    QCOMPARE_WITH_ABS_ERROR(a.trans(), b.trans(), TEST_EPSILON);
+}
+
+// a skeleton of random branches, the parents before their children like in an FBX
+static AnimSkeleton::Pointer makeRandomSkeleton(int numJoints) {
+    std::vector<HFMJoint> joints(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        joints[i].name = QString("joint%1").arg(i);
+        joints[i].parentIndex = i == 0 ? -1 : rand() % i;
+        joints[i].translation = glm::ballRand(1.0f);
+        joints[i].rotation = randomRotation();
+    }
+    return std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+}
+
+void AnimPoseBufferTests::testBlend() {
+    AnimPoseVec a, b;
+    for (int i = 0; i < NUM_POSES; i++) {
+        a.push_back(randomPose());
+        b.push_back(randomPose(false));
+    }
+    // the same rotation as a, from the other hemisphere
+    b[1].rot() = -a[1].rot();
+
+    const float ALPHAS[] = { 0.0f, 0.3f, 0.5f, 1.0f };
+    for (float alpha : ALPHAS) {
+        AnimPoseVec result(NUM_POSES);
+        ::blend(NUM_POSES, a.data(), b.data(), alpha, result.data());
+        for (int i = 0; i < NUM_POSES; i++) {
+            AnimPose expected = b[i];
+            expected.blend(a[i], alpha);
+            comparePoses(result[i], expected);
+        }
+    }
+
+    // in place
+    AnimPoseVec expected(NUM_POSES);
+    ::blend(NUM_POSES, a.data(), b.data(), 0.25f, expected.data());
+    ::blend(NUM_POSES, a.data(), b.data(), 0.25f, a.data());
+    for (int i = 0; i < NUM_POSES; i++) {
+        comparePoses(a[i], expected[i]);
+    }
+}
+
+void AnimPoseBufferTests::testBlendWithAlphas() {
+    AnimPoseVec a, b;
+    std::vector<float> alphas;
+    for (int i = 0; i < NUM_POSES; i++) {
+        a.push_back(randomPose());
+        b.push_back(randomPose());
+        alphas.push_back(glm::linearRand(0.0f, 1.0f));
+    }
+
+    AnimPoseVec result(NUM_POSES);
+    ::blend(NUM_POSES, a.data(), b.data(), alphas.data(), result.data());
+    for (int i = 0; i < NUM_POSES; i++) {
+        AnimPose expected;
+        ::blend(1, &a[i], &b[i], alphas[i], &expected);
+        comparePoses(result[i], expected);
+    }
+}
+
+void AnimPoseBufferTests::testConvertRelativePosesToAbsolute() {
+    auto skeleton = makeRandomSkeleton(NUM_JOINTS);
+
+    AnimPoseVec relativePoses;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        relativePoses.push_back(randomPose());
+    }
+
+    AnimPoseVec absolutePoses = relativePoses;
+    skeleton->convertRelativePosesToAbsolute(absolutePoses);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        comparePoses(absolutePoses[i], skeleton->getAbsolutePose(i, relativePoses));
+    }
+
+    // and back again
+    skeleton->convertAbsolutePosesToRelative(absolutePoses);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        comparePoses(absolutePoses[i], relativePoses[i]);
+    }
+}
+
+void AnimPoseBufferTests::testNonUniformScale() {
+    auto skeleton = makeRandomSkeleton(NUM_JOINTS);
+
+    AnimPoseVec relativePoses;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        relativePoses.push_back(randomPose(i != NUM_JOINTS / 2));
+    }
+
+    AnimPoseVec absolutePoses = relativePoses;
+    skeleton->convertRelativePosesToAbsolute(absolutePoses);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        comparePoses(absolutePoses[i], skeleton->getAbsolutePose(i, relativePoses));
+    }
+}
+
+#ifdef MANUAL_TEST
+
+const int BENCHMARK_NUM_JOINTS = 150;  // a humanoid with fingers and a few extras
+const int BENCHMARK_NUM_ITERATIONS = 10000;
+
+void AnimPoseBufferTests::benchmark() {
+    auto skeleton = makeRandomSkeleton(BENCHMARK_NUM_JOINTS);
+
+    AnimPoseVec a, b;
+    std::vector<float> alphas;
+    for (int i = 0; i < BENCHMARK_NUM_JOINTS; i++) {
+        a.push_back(randomPose());
+        b.push_back(randomPose());
+        alphas.push_back(glm::linearRand(0.0f, 1.0f));
+    }
+    AnimPoseVec result(BENCHMARK_NUM_JOINTS);
+
+    // what blend and convertRelativePosesToAbsolute did a pose at a time
+    uint64_t startTime = usecTimestampNow();
+    for (int n = 0; n < BENCHMARK_NUM_ITERATIONS; n++) {
+        for (int i = 0; i < BENCHMARK_NUM_JOINTS; i++) {
+            result[i].scale() = lerp(a[i].scale(), b[i].scale(), alphas[i]);
+            result[i].rot() = safeLerp(a[i].rot(), b[i].rot(), alphas[i]);
+            result[i].trans() = lerp(a[i].trans(), b[i].trans(), alphas[i]);
+        }
+    }
+    uint64_t refBlendUsecs = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int n = 0; n < BENCHMARK_NUM_ITERATIONS; n++) {
+        ::blend(BENCHMARK_NUM_JOINTS, a.data(), b.data(), alphas.data(), result.data());
+    }
+    uint64_t blendUsecs = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int n = 0; n < BENCHMARK_NUM_ITERATIONS; n++) {
+        result = a;
+        for (int i = 0; i < BENCHMARK_NUM_JOINTS; i++) {
+            int parentIndex = skeleton->getParentIndex(i);
+            if (parentIndex != -1) {
+                result[i] = result[parentIndex] * result[i];
+            }
+        }
+    }
+    uint64_t refAbsoluteUsecs = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int n = 0; n < BENCHMARK_NUM_ITERATIONS; n++) {
+        result = a;
+        skeleton->convertRelativePosesToAbsolute(result);
+    }
+    uint64_t absoluteUsecs = usecTimestampNow() - startTime;
+
+    std::cout << BENCHMARK_NUM_ITERATIONS << " iterations over " << BENCHMARK_NUM_JOINTS << " joints:" << std::endl;
+    std::cout << "    blend ref = " << refBlendUsecs << " usec, " << (float)refBlendUsecs / (float)BENCHMARK_NUM_ITERATIONS << " usec/iteration" << std::endl;
+    std::cout << "    blend = " << blendUsecs << " usec, " << (float)blendUsecs / (float)BENCHMARK_NUM_ITERATIONS << " usec/iteration" << std::endl;
+    std::cout << "    relative to absolute ref = " << refAbsoluteUsecs << " usec, " << (float)refAbsoluteUsecs / (float)BENCHMARK_NUM_ITERATIONS << " usec/iteration" << std::endl;
+    std::cout << "    relative to absolute = " << absoluteUsecs << " usec, " << (float)absoluteUsecs / (float)BENCHMARK_NUM_ITERATIONS << " usec/iteration" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,30 @@
+//
+//  AnimPoseBufferTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBufferTests_h
+#define hifi_AnimPoseBufferTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class AnimPoseBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBlend();
+    void testBlendWithAlphas();
+    void testConvertRelativePosesToAbsolute();
+    void testNonUniformScale();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_AnimPoseBufferTests_h
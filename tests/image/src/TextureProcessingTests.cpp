@@ -0,0 +1,133 @@
+//
+//  TextureProcessingTests.cpp
+//  tests/image/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTests.h"
+
+#include <iostream>
+
+#include <image/Image.h>
+#include <image/TextureProcessing.h>
+#include <gpu/Texture.h>
+#include <SharedUtil.h>
+
+QTEST_GUILESS_MAIN(TextureProcessingTests)
+
+const float EPSILON = 0.0001f;
+
+static bool closeEnough(const glm::vec4& a, const glm::vec4& b) {
+    return glm::all(glm::lessThan(glm::abs(a - b), glm::vec4(EPSILON)));
+}
+
+void TextureProcessingTests::testNextMipLevel() {
+    image::Image source(4, 2, image::Image::Format_RGBAF);
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 4; x++) {
+            source.setFloatPixel(x, y, glm::vec4((float)x, (float)y, (float)(x * y), 1.0f));
+        }
+    }
+
+    auto mip = source.getNextMipLevel();
+    QCOMPARE(mip.getWidth(), (glm::uint32)2);
+    QCOMPARE(mip.getHeight(), (glm::uint32)1);
+    QVERIFY(closeEnough(mip.getFloatPixel(0, 0), glm::vec4(0.5f, 0.5f, 0.25f, 1.0f)));
+    QVERIFY(closeEnough(mip.getFloatPixel(1, 0), glm::vec4(2.5f, 0.5f, 1.25f, 1.0f)));
+
+    auto lastMip = mip.getNextMipLevel();
+    QCOMPARE(lastMip.getWidth(), (glm::uint32)1);
+    QCOMPARE(lastMip.getHeight(), (glm::uint32)1);
+    QVERIFY(closeEnough(lastMip.getFloatPixel(0, 0), glm::vec4(1.5f, 0.5f, 0.75f, 1.0f)));
+}
+
+void TextureProcessingTests::testNextMipLevelOddSize() {
+    image::Image source(5, 3, image::Image::Format_RGBAF);
+    glm::vec4 sum { 0.0f };
+    for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 5; x++) {
+            glm::vec4 value((float)(x + 5 * y), 1.0f, 0.0f, 0.5f);
+            source.setFloatPixel(x, y, value);
+            sum += value;
+        }
+    }
+
+    auto mip = source.getNextMipLevel();
+    QCOMPARE(mip.getWidth(), (glm::uint32)2);
+    QCOMPARE(mip.getHeight(), (glm::uint32)1);
+
+    // every source pixel is covered once, so the mip averages to the same as the source
+    auto average = (mip.getFloatPixel(0, 0) + mip.getFloatPixel(1, 0)) / 2.0f;
+    QVERIFY(closeEnough(average, sum / 15.0f));
+    QVERIFY(closeEnough(mip.getFloatPixel(0, 0), glm::vec4(5.0f + 0.4f * 0.0f + 0.4f * 1.0f + 0.2f * 2.0f, 1.0f, 0.0f, 0.5f)));
+}
+
+void TextureProcessingTests::testMipChain() {
+    const int SIZE = 256;
+    image::Image source(SIZE, SIZE / 2, image::Image::Format_ARGB32);
+    for (int y = 0; y < SIZE / 2; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            source.setPackedPixel(x, y, qRgba(x, y, 128, 255));
+        }
+    }
+
+    auto texture = gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, SIZE, SIZE / 2, gpu::Texture::MAX_NUM_MIPS,
+                                          gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
+    texture->setStoredMipFormat(gpu::Element::COLOR_RGBA_32);
+    image::convertToTextureWithMips(texture.get(), std::move(source), gpu::BackendTarget::GL45);
+
+    QCOMPARE(texture->getNumMips(), (gpu::uint16)9);
+    for (gpu::uint16 level = 0; level < texture->getNumMips(); level++) {
+        QVERIFY(texture->isStoredMipFaceAvailable(level));
+        QCOMPARE((gpu::Size)texture->accessStoredMipFace(level)->size(), texture->evalStoredMipSize(level, gpu::Element::COLOR_RGBA_32));
+    }
+}
+
+#ifdef MANUAL_TEST
+void TextureProcessingTests::benchmark() {
+    const int SIZE = 4096;
+    std::vector<std::pair<const char*, gpu::Element>> formats {
+        { "RGBA_32", gpu::Element::COLOR_RGBA_32 },
+        { "BC1", gpu::Element::COLOR_COMPRESSED_BCX_SRGB },
+        { "BC3", gpu::Element::COLOR_COMPRESSED_BCX_SRGBA },
+        { "BC4", gpu::Element::COLOR_COMPRESSED_BCX_RED },
+        { "BC5", gpu::Element::COLOR_COMPRESSED_BCX_XY },
+        { "BC7", gpu::Element::COLOR_COMPRESSED_BCX_SRGBA_HIGH },
+        { "R11G11B10", gpu::Element::COLOR_R11G11B10 },
+        { "BC6", gpu::Element::COLOR_COMPRESSED_BCX_HDR_RGB },
+    };
+
+    image::Image ldrSource(SIZE, SIZE, image::Image::Format_ARGB32);
+    image::Image hdrSource(SIZE, SIZE, image::Image::Format_RGBAF);
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            ldrSource.setPackedPixel(x, y, qRgba(x * y, x ^ y, rand(), 255));
+            hdrSource.setFloatPixel(x, y, glm::vec4((float)x / SIZE, (float)y / SIZE, randFloat() * 4.0f, 1.0f));
+        }
+    }
+
+    // all the mips of a texture come to a third more than its base
+    const float MEGAPIXELS = SIZE * SIZE * 4.0f / 3.0f / 1.0e6f;
+
+    std::cout << "[format, msecs, MP/s] = [" << std::endl;
+    for (const auto& format : formats) {
+        bool isHDR = format.second == gpu::Element::COLOR_R11G11B10 || format.second == gpu::Element::COLOR_COMPRESSED_BCX_HDR_RGB;
+        image::Image source = isHDR ? hdrSource : ldrSource;
+        auto texture = gpu::Texture::create2D(format.second, SIZE, SIZE, gpu::Texture::MAX_NUM_MIPS,
+                                              gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
+        texture->setStoredMipFormat(format.second);
+
+        uint64_t startTime = usecTimestampNow();
+        image::convertToTextureWithMips(texture.get(), std::move(source), gpu::BackendTarget::GL45);
+        uint64_t usec = usecTimestampNow() - startTime;
+
+        std::cout << "    " << format.first << ", " << usec / USECS_PER_MSEC << ", "
+                  << MEGAPIXELS / ((float)usec / USECS_PER_SECOND) << std::endl;
+    }
+    std::cout << "];" << std::endl;
+}
+#endif // MANUAL_TEST
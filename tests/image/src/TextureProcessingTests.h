@@ -0,0 +1,30 @@
+//
+//  TextureProcessingTests.h
+//  tests/image/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_image_TextureProcessingTests_h
+#define hifi_image_TextureProcessingTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class TextureProcessingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testNextMipLevel();
+    void testNextMipLevelOddSize();
+    void testMipChain();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_image_TextureProcessingTests_h
@@ -0,0 +1,120 @@
+//
+//  AssetChunkingTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkingTests.h"
+
+#include <cstring>
+
+#include <QtCore/QSet>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+#include <Sha256Hasher.h>
+
+QTEST_MAIN(AssetChunkingTests)
+
+// pseudo random bytes, content-defined cut points need data without a short period
+static QByteArray makeData(int size, uint32_t seed) {
+    QByteArray data(size, Qt::Uninitialized);
+    uint32_t state = seed;
+    for (int i = 0; i < size; ++i) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (char)(state >> 24);
+    }
+    return data;
+}
+
+void AssetChunkingTests::coverageTest() {
+    QVERIFY(AssetChunking::createManifest(nullptr, 0).empty());
+
+    auto data = makeData(8 * 1024 * 1024, 1);
+    auto manifest = AssetChunking::createManifest(data.constData(), data.size());
+    QVERIFY(!manifest.empty());
+    QCOMPARE(AssetChunking::getAssetSize(manifest), (qint64)data.size());
+
+    qint64 offset = 0;
+    for (size_t i = 0; i < manifest.size(); ++i) {
+        const auto& chunk = manifest[i];
+        QCOMPARE(chunk.offset, offset);
+        QVERIFY(chunk.size <= AssetChunking::MAX_CHUNK_SIZE);
+        if (i + 1 < manifest.size()) {
+            QVERIFY(chunk.size >= AssetChunking::MIN_CHUNK_SIZE);
+        }
+        QCOMPARE(chunk.hash, Sha256Hasher::hash(data.constData() + chunk.offset, chunk.size));
+        offset += chunk.size;
+    }
+
+    // sizes should gather around the average, not pile up at either limit
+    auto averageSize = data.size() / (qint64)manifest.size();
+    QVERIFY(averageSize > AssetChunking::AVERAGE_CHUNK_SIZE / 2);
+    QVERIFY(averageSize < AssetChunking::AVERAGE_CHUNK_SIZE * 2);
+
+    auto small = makeData(100, 2);
+    auto smallManifest = AssetChunking::createManifest(small.constData(), small.size());
+    QCOMPARE((int)smallManifest.size(), 1);
+    QCOMPARE(smallManifest[0].size, (qint64)small.size());
+}
+
+void AssetChunkingTests::deterministicTest() {
+    auto data = makeData(2 * 1024 * 1024, 3);
+    auto first = AssetChunking::createManifest(data.constData(), data.size());
+    auto second = AssetChunking::createManifest(data.constData(), data.size());
+    QCOMPARE(AssetChunking::serializeManifest(first), AssetChunking::serializeManifest(second));
+}
+
+void AssetChunkingTests::insertTest() {
+    auto original = makeData(16 * 1024 * 1024, 4);
+    auto edited = original;
+    edited.insert(original.size() / 2, makeData(100, 5));
+
+    auto originalManifest = AssetChunking::createManifest(original.constData(), original.size());
+    auto editedManifest = AssetChunking::createManifest(edited.constData(), edited.size());
+
+    QSet<QByteArray> originalChunks;
+    for (const auto& chunk : originalManifest) {
+        originalChunks.insert(chunk.hash);
+    }
+
+    int sharedChunks = 0;
+    for (const auto& chunk : editedManifest) {
+        if (originalChunks.contains(chunk.hash)) {
+            ++sharedChunks;
+        }
+    }
+
+    // only the chunks touching the insert should change
+    QVERIFY(sharedChunks >= (int)editedManifest.size() - 3);
+}
+
+void AssetChunkingTests::serializeTest() {
+    auto data = makeData(1024 * 1024, 6);
+    auto manifest = AssetChunking::createManifest(data.constData(), data.size());
+    auto serialized = AssetChunking::serializeManifest(manifest);
+
+    AssetChunking::Manifest roundTrip;
+    QVERIFY(AssetChunking::deserializeManifest(serialized, roundTrip));
+    QCOMPARE(roundTrip.size(), manifest.size());
+    for (size_t i = 0; i < manifest.size(); ++i) {
+        QCOMPARE(roundTrip[i].hash, manifest[i].hash);
+        QCOMPARE(roundTrip[i].offset, manifest[i].offset);
+        QCOMPARE(roundTrip[i].size, manifest[i].size);
+    }
+
+    AssetChunking::Manifest refused;
+    QVERIFY(!AssetChunking::deserializeManifest(QByteArray(), refused));
+    QVERIFY(!AssetChunking::deserializeManifest(serialized.left(serialized.size() - 1), refused));
+    QVERIFY(!AssetChunking::deserializeManifest(serialized + QByteArray(1, 0), refused));
+
+    // a chunk bigger than any chunker would cut
+    auto oversized = serialized;
+    uint32_t hugeSize = (uint32_t)AssetChunking::MAX_CHUNK_SIZE + 1;
+    memcpy(oversized.data() + sizeof(uint32_t) + AssetUtils::SHA256_HASH_LENGTH, &hugeSize, sizeof(hugeSize));
+    QVERIFY(!AssetChunking::deserializeManifest(oversized, refused));
+}
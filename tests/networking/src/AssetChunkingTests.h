@@ -0,0 +1,32 @@
+//
+//  AssetChunkingTests.h
+//  tests/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkingTests_h
+#define hifi_AssetChunkingTests_h
+
+#include <QtTest/QtTest>
+
+class AssetChunkingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the chunks cover the whole asset and stay within the size limits
+    void coverageTest();
+
+    // Test that the same data is always cut in the same places
+    void deterministicTest();
+
+    // Test that an edit in the middle of an asset leaves the chunks around it alone
+    void insertTest();
+
+    // Test that manifests survive a round trip and malformed ones are refused
+    void serializeTest();
+};
+
+#endif // hifi_AssetChunkingTests_h
@@ -0,0 +1,84 @@
+//
+//  Sha256HasherTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Sha256HasherTests.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QTemporaryFile>
+
+#include <AssetUtils.h>
+#include <Sha256Hasher.h>
+
+QTEST_MAIN(Sha256HasherTests)
+
+static QByteArray makeData(int size) {
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (char)((i * 31 + 7) & 0xff);
+    }
+    return data;
+}
+
+static QByteArray referenceHash(const QByteArray& data) {
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+void Sha256HasherTests::hashTest() {
+    QCOMPARE(Sha256Hasher::hash(nullptr, 0), referenceHash(QByteArray()));
+
+    auto data = makeData(100000);
+    QCOMPARE(Sha256Hasher::hash(data.constData(), data.size()), referenceHash(data));
+    QCOMPARE(AssetUtils::hashData(data), referenceHash(data));
+}
+
+void Sha256HasherTests::incrementalTest() {
+    auto data = makeData(3 * 1024 * 1024 + 17);
+
+    Sha256Hasher hasher;
+    int position = 0;
+    int pieceSize = 1;
+    while (position < data.size()) {
+        int size = std::min(pieceSize, data.size() - position);
+        hasher.addData(data.constData() + position, size);
+        position += size;
+        pieceSize = pieceSize * 3 + 1;
+    }
+
+    QCOMPARE(hasher.result(), referenceHash(data));
+}
+
+void Sha256HasherTests::reuseTest() {
+    auto first = makeData(1000);
+    auto second = makeData(2000);
+
+    Sha256Hasher hasher;
+    hasher.addData(first);
+    QCOMPARE(hasher.result(), referenceHash(first));
+
+    hasher.addData(second);
+    QCOMPARE(hasher.result(), referenceHash(second));
+}
+
+void Sha256HasherTests::hashFileTest() {
+    auto data = makeData(5 * 1024 * 1024 + 3);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), (qint64)data.size());
+    file.close();
+
+    QByteArray hash;
+    QVERIFY(AssetUtils::hashFile(file.fileName(), hash));
+    QCOMPARE(hash, referenceHash(data));
+
+    QVERIFY(!AssetUtils::hashFile(file.fileName() + ".missing", hash));
+}
@@ -0,0 +1,32 @@
+//
+//  Sha256HasherTests.h
+//  tests/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_Sha256HasherTests_h
+#define hifi_Sha256HasherTests_h
+
+#include <QtTest/QtTest>
+
+class Sha256HasherTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test a one shot hash against QCryptographicHash
+    void hashTest();
+
+    // Test hashing data that arrives in uneven pieces
+    void incrementalTest();
+
+    // Test that a hasher starts over after giving its result
+    void reuseTest();
+
+    // Test hashing a file a chunk at a time
+    void hashFileTest();
+};
+
+#endif // hifi_Sha256HasherTests_h
@@ -0,0 +1,143 @@
+//
+//  CollisionShapeCacheTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CollisionShapeCacheTests.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+
+#include <CollisionShapeCache.h>
+#include <ShapeFactory.h>
+#include <ShapeInfo.h>
+
+QTEST_MAIN(CollisionShapeCacheTests)
+
+const int GRID_SIZE = 33;
+const float GRID_SPACING = 0.5f;
+const QString MESH_URL = "http://example.com/terrain.fbx";
+
+// a bumpy GRID_SIZE x GRID_SIZE square of triangles
+static ShapeInfo makeTerrain(float bumpHeight, float halfExtent = 0.5f * (GRID_SIZE - 1) * GRID_SPACING) {
+    ShapeInfo::PointList points;
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            float height = bumpHeight * sinf((float)i) * cosf((float)j);
+            points.push_back(glm::vec3((i - 0.5f * (GRID_SIZE - 1)) * GRID_SPACING, height,
+                                       (j - 0.5f * (GRID_SIZE - 1)) * GRID_SPACING));
+        }
+    }
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(halfExtent, bumpHeight, halfExtent), MESH_URL);
+    info.setPointCollection({ points });
+    auto& indices = info.getTriangleIndices();
+    for (int i = 0; i < GRID_SIZE - 1; ++i) {
+        for (int j = 0; j < GRID_SIZE - 1; ++j) {
+            int corner = i * GRID_SIZE + j;
+            indices << corner << corner + 1 << corner + GRID_SIZE;
+            indices << corner + 1 << corner + GRID_SIZE + 1 << corner + GRID_SIZE;
+        }
+    }
+    return info;
+}
+
+class TriangleCounter : public btTriangleCallback {
+public:
+    void processTriangle(btVector3* triangle, int partId, int triangleIndex) override { ++count; }
+    int count { 0 };
+};
+
+// the number of triangles the BVH of shape finds around the middle of the terrain
+static int countTrianglesNearMiddle(const btCollisionShape* shape) {
+    auto meshShape = static_cast<const btBvhTriangleMeshShape*>(shape);
+    TriangleCounter counter;
+    const btVector3 HALF_EXTENTS(2.0f, 2.0f, 2.0f);
+    meshShape->processAllTriangles(&counter, -HALF_EXTENTS, HALF_EXTENTS);
+    return counter.count;
+}
+
+void CollisionShapeCacheTests::testFetchStoredBvh() {
+    QTemporaryDir directory;
+    CollisionShapeCache cache { directory.path() };
+    ShapeInfo info = makeTerrain(1.0f);
+
+    const btCollisionShape* builtShape = ShapeFactory::createShapeFromInfo(info, &cache);
+    QVERIFY(builtShape != nullptr);
+    QCOMPARE(builtShape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    QCOMPARE(cache.getStats().misses, (quint64)1);
+    QCOMPARE(cache.getStats().stores, (quint64)1);
+
+    // a new session with the same cache folder
+    CollisionShapeCache otherCache { directory.path() };
+    const btCollisionShape* cachedShape = ShapeFactory::createShapeFromInfo(info, &otherCache);
+    QVERIFY(cachedShape != nullptr);
+    QCOMPARE(otherCache.getStats().hits, (quint64)1);
+    QCOMPARE(otherCache.getStats().stores, (quint64)0);
+
+    auto builtBvh = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(builtShape))->getOptimizedBvh();
+    auto cachedBvh = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(cachedShape))->getOptimizedBvh();
+    QCOMPARE(cachedBvh->isQuantized(), builtBvh->isQuantized());
+    QCOMPARE(cachedBvh->getQuantizedNodeArray().size(), builtBvh->getQuantizedNodeArray().size());
+
+    int numTriangles = countTrianglesNearMiddle(builtShape);
+    QVERIFY(numTriangles > 0);
+    QCOMPARE(countTrianglesNearMiddle(cachedShape), numTriangles);
+
+    ShapeFactory::deleteShape(builtShape);
+    ShapeFactory::deleteShape(cachedShape);
+}
+
+void CollisionShapeCacheTests::testOtherMeshMisses() {
+    QTemporaryDir directory;
+    CollisionShapeCache cache { directory.path() };
+
+    // the model at the URL changed since the BVH was stored, but the dimensions didn't
+    ShapeInfo info = makeTerrain(1.0f);
+    ShapeInfo changedInfo = makeTerrain(1.0f);
+    changedInfo.getPointCollection()[0][0].y += 1.0f;
+    QCOMPARE(changedInfo.getHash(), info.getHash());
+
+    ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(info, &cache));
+    ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(changedInfo, &cache));
+    QCOMPARE(cache.getStats().hits, (quint64)0);
+    QCOMPARE(cache.getStats().misses, (quint64)2);
+    QCOMPARE(cache.getStats().stores, (quint64)2);
+
+    // the changed mesh replaced the old one
+    ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(changedInfo, &cache));
+    QCOMPARE(cache.getStats().hits, (quint64)1);
+}
+
+void CollisionShapeCacheTests::testEviction() {
+    QTemporaryDir directory;
+    QFileInfo entryInfo;
+    {
+        CollisionShapeCache cache { directory.path() };
+        ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(makeTerrain(1.0f), &cache));
+        auto entries = QDir(directory.path()).entryInfoList(QDir::Files);
+        QCOMPARE(entries.size(), 1);
+        entryInfo = entries[0];
+
+        // last used an hour ago
+        QFile entryFile { entryInfo.absoluteFilePath() };
+        QVERIFY(entryFile.open(QIODevice::ReadWrite));
+        entryFile.setFileTime(QDateTime::currentDateTime().addSecs(-60 * 60), QFileDevice::FileModificationTime);
+    }
+
+    // only room for one entry
+    CollisionShapeCache cache { directory.path(), entryInfo.size() + entryInfo.size() / 2 };
+    ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(makeTerrain(2.0f, 10.0f), &cache));
+    QCOMPARE(cache.getStats().stores, (quint64)1);
+    QCOMPARE(cache.getStats().evictions, (quint64)1);
+    QCOMPARE(QDir(directory.path()).entryInfoList(QDir::Files).size(), 1);
+    QVERIFY(!QFileInfo::exists(entryInfo.absoluteFilePath()));
+}
@@ -0,0 +1,24 @@
+//
+//  CollisionShapeCacheTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CollisionShapeCacheTests_h
+#define hifi_CollisionShapeCacheTests_h
+
+#include <QtTest/QtTest>
+
+class CollisionShapeCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testFetchStoredBvh();
+    void testOtherMeshMisses();
+    void testEviction();
+};
+
+#endif // hifi_CollisionShapeCacheTests_h
@@ -0,0 +1,165 @@
+//
+//  PhysicsEngineTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineTests.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <QThread>
+
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(PhysicsEngineTests)
+
+const float GRAVITY = -9.8f;
+const float BOX_HALF_EXTENT = 0.25f;
+const float GROUND_HALF_EXTENT = 0.5f;
+const int NUM_STACKS_PER_SIDE = 6;
+const int NUM_BOXES_PER_STACK = 5;
+const int NUM_STEPS = 180;
+
+// Stacks of boxes falling onto a static floor, each stack a little off center so they topple into each other.
+// Nothing in it is random, so the same number of threads always starts from the same world.
+class BoxStacks {
+public:
+    BoxStacks(int numThreads, int numStacksPerSide = NUM_STACKS_PER_SIDE) :
+        _engine(glm::vec3(0.0f)),
+        _boxShape(btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT)),
+        _groundShape(btVector3(numStacksPerSide * 4.0f * BOX_HALF_EXTENT, GROUND_HALF_EXTENT,
+                               numStacksPerSide * 4.0f * BOX_HALF_EXTENT))
+    {
+        _engine.setNumThreads(numThreads);
+        _engine.init();
+        auto world = _engine.getDynamicsWorld();
+
+        btTransform groundTransform;
+        groundTransform.setIdentity();
+        groundTransform.setOrigin(btVector3(0.0f, -GROUND_HALF_EXTENT, 0.0f));
+        _ground.reset(new btRigidBody(0.0f, nullptr, &_groundShape));
+        _ground->setWorldTransform(groundTransform);
+        world->addRigidBody(_ground.get());
+
+        const float MASS = 1.0f;
+        btVector3 inertia;
+        _boxShape.calculateLocalInertia(MASS, inertia);
+        const float SPACING = 3.0f * BOX_HALF_EXTENT;
+        const float OFFSET = 0.2f * BOX_HALF_EXTENT;
+        for (int i = 0; i < numStacksPerSide; ++i) {
+            for (int j = 0; j < numStacksPerSide; ++j) {
+                for (int k = 0; k < NUM_BOXES_PER_STACK; ++k) {
+                    btTransform transform;
+                    transform.setIdentity();
+                    transform.setOrigin(btVector3((i - 0.5f * numStacksPerSide) * SPACING + k * OFFSET,
+                                                  (2 * k + 1) * BOX_HALF_EXTENT * 1.01f,
+                                                  (j - 0.5f * numStacksPerSide) * SPACING - k * OFFSET));
+                    auto box = new btRigidBody(MASS, nullptr, &_boxShape, inertia);
+                    box->setWorldTransform(transform);
+                    world->addRigidBody(box);
+                    // the world has no gravity of its own, every object brings its own
+                    box->setGravity(btVector3(0.0f, GRAVITY, 0.0f));
+                    _boxes.emplace_back(box);
+                }
+            }
+        }
+    }
+
+    ~BoxStacks() {
+        auto world = _engine.getDynamicsWorld();
+        for (auto& box : _boxes) {
+            world->removeRigidBody(box.get());
+        }
+        world->removeRigidBody(_ground.get());
+    }
+
+    int getNumThreads() const { return _engine.getNumThreads(); }
+
+    void step(int numSteps) {
+        auto world = _engine.getThreadSafeDynamicsWorld();
+        for (int i = 0; i < numSteps; ++i) {
+            world->stepSimulationWithSubstepCallback(PHYSICS_ENGINE_FIXED_SUBSTEP, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
+                                                     PHYSICS_ENGINE_FIXED_SUBSTEP);
+        }
+    }
+
+    const std::vector<std::unique_ptr<btRigidBody>>& getBoxes() const { return _boxes; }
+
+private:
+    PhysicsEngine _engine;
+    btBoxShape _boxShape;
+    btBoxShape _groundShape;
+    std::unique_ptr<btRigidBody> _ground;
+    std::vector<std::unique_ptr<btRigidBody>> _boxes;
+};
+
+void PhysicsEngineTests::testSingleThreadedIsDeterministic() {
+    BoxStacks first(1);
+    BoxStacks second(1);
+    QCOMPARE(first.getNumThreads(), 1);
+
+    first.step(NUM_STEPS);
+    second.step(NUM_STEPS);
+
+    for (size_t i = 0; i < first.getBoxes().size(); ++i) {
+        const auto& a = first.getBoxes()[i]->getWorldTransform();
+        const auto& b = second.getBoxes()[i]->getWorldTransform();
+        QCOMPARE(a.getOrigin() == b.getOrigin(), true);
+        QCOMPARE(a.getRotation() == b.getRotation(), true);
+    }
+}
+
+void PhysicsEngineTests::testMultiThreadedStep() {
+    const int NUM_THREADS = 4;
+    BoxStacks stacks(NUM_THREADS);
+#if defined(USE_BULLET_MULTITHREADING) && BT_THREADSAFE
+    QCOMPARE(stacks.getNumThreads(), std::min(NUM_THREADS, std::max(1, QThread::idealThreadCount())));
+#else
+    QCOMPARE(stacks.getNumThreads(), 1);
+#endif
+
+    stacks.step(NUM_STEPS);
+
+    // the threads may solve the islands in another order, but every box has to end up resting on the floor or on
+    // another box, and the stacks that fell over can't have pushed anything far
+    const float MAX_DISTANCE = NUM_STACKS_PER_SIDE * 4.0f * BOX_HALF_EXTENT;
+    const float PENETRATION_TOLERANCE = 0.05f;
+    for (const auto& box : stacks.getBoxes()) {
+        const auto& origin = box->getWorldTransform().getOrigin();
+        QCOMPARE(origin.getY() > BOX_HALF_EXTENT - PENETRATION_TOLERANCE, true);
+        QCOMPARE(origin.getY() < NUM_BOXES_PER_STACK * 2.0f * BOX_HALF_EXTENT, true);
+        QCOMPARE(btFabs(origin.getX()) < MAX_DISTANCE && btFabs(origin.getZ()) < MAX_DISTANCE, true);
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void PhysicsEngineTests::benchmark() {
+    const int BENCHMARK_NUM_STACKS_PER_SIDE = 16;
+    const int BENCHMARK_NUM_STEPS = 600;
+
+    std::cout << BENCHMARK_NUM_STEPS << " steps of " << BENCHMARK_NUM_STACKS_PER_SIDE * BENCHMARK_NUM_STACKS_PER_SIDE *
+        NUM_BOXES_PER_STACK << " stacked boxes:" << std::endl;
+
+    int maxNumThreads = std::max(1, QThread::idealThreadCount());
+    for (int numThreads = 1; numThreads <= maxNumThreads; numThreads *= 2) {
+        BoxStacks stacks(numThreads, BENCHMARK_NUM_STACKS_PER_SIDE);
+        uint64_t startTime = usecTimestampNow();
+        stacks.step(BENCHMARK_NUM_STEPS);
+        uint64_t usecs = usecTimestampNow() - startTime;
+        std::cout << "    " << stacks.getNumThreads() << " threads = " << usecs << " usec, " <<
+            (float)usecs / (float)BENCHMARK_NUM_STEPS << " usec/step" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,28 @@
+//
+//  PhysicsEngineTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsEngineTests_h
+#define hifi_PhysicsEngineTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PhysicsEngineTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSingleThreadedIsDeterministic();
+    void testMultiThreadedStep();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PhysicsEngineTests_h
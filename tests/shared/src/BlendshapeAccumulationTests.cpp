@@ -0,0 +1,242 @@
+//
+//  BlendshapeAccumulationTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeAccumulationTests.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+#include <GLMHelpers.h>
+#include <SharedUtil.h>
+#include <glm/gtc/random.hpp>
+
+struct BlendshapeOffsetUnpacked {
+    glm::vec3 positionOffset;
+    glm::vec3 normalOffset;
+    glm::vec3 tangentOffset;
+};
+
+QTEST_MAIN(BlendshapeAccumulationTests)
+
+static void accumulateBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, const int* indices, const glm::vec3* vertices,
+                                            const glm::vec3* normals, const glm::vec3* tangents, int size,
+                                            float vertexCoefficient, float normalCoefficient) {
+    for (int i = 0; i < size; ++i) {
+        auto& currentBlendshapeOffset = unpacked[indices[i]];
+        currentBlendshapeOffset.positionOffset += vertices[i] * vertexCoefficient;
+        currentBlendshapeOffset.normalOffset += normals[i] * normalCoefficient;
+        if (tangents) {
+            currentBlendshapeOffset.tangentOffset += tangents[i] * normalCoefficient;
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*vertices)[3],
+                                      const float (*normals)[3], const float (*tangents)[3], int size,
+                                      float vertexCoefficient, float normalCoefficient);
+
+static void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const int* indices, const glm::vec3* vertices,
+                                        const glm::vec3* normals, const glm::vec3* tangents, int size,
+                                        float vertexCoefficient, float normalCoefficient) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        static_assert(sizeof(BlendshapeOffsetUnpacked) == 9 * sizeof(float), "struct BlendshapeOffsetUnpacked size doesn't match.");
+        static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "struct glm::vec3 size doesn't match.");
+        accumulateBlendshapeOffsets_AVX2((float(*)[9])unpacked, indices, (const float(*)[3])vertices, (const float(*)[3])normals,
+                                         (const float(*)[3])tangents, size, vertexCoefficient, normalCoefficient);
+    } else {
+        accumulateBlendshapeOffsets_ref(unpacked, indices, vertices, normals, tangents, size, vertexCoefficient, normalCoefficient);
+    }
+}
+
+#else   // portable reference code
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
+#endif
+
+struct TestBlendshape {
+    std::vector<int> indices;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> tangents;
+};
+
+// a blendshape moving numIndices of the numVertices vertices in a mesh, each at most once unless repeatIndices
+static TestBlendshape generateBlendshape(int numVertices, int numIndices, bool repeatIndices) {
+    TestBlendshape blendshape;
+    if (repeatIndices) {
+        for (int i = 0; i < numIndices; ++i) {
+            blendshape.indices.push_back(rand() % numVertices);
+        }
+    } else {
+        std::vector<int> vertexIndices(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            vertexIndices[i] = i;
+        }
+        static std::mt19937 generator;
+        std::shuffle(vertexIndices.begin(), vertexIndices.end(), generator);
+        blendshape.indices.assign(vertexIndices.begin(), vertexIndices.begin() + numIndices);
+        // exporters write them in vertex order
+        std::sort(blendshape.indices.begin(), blendshape.indices.end());
+    }
+    for (int i = 0; i < numIndices; ++i) {
+        blendshape.vertices.push_back(glm::linearRand(glm::vec3(-0.02f), glm::vec3(0.02f)));
+        blendshape.normals.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        blendshape.tangents.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+    }
+    return blendshape;
+}
+
+static void compareOffsets(const std::vector<BlendshapeOffsetUnpacked>& ref, const std::vector<BlendshapeOffsetUnpacked>& tst) {
+    // the order of the adds can differ between the versions for repeated indices
+    const float EPSILON = 1.0e-5f;
+    QCOMPARE(tst.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        QCOMPARE_WITH_ABS_ERROR(tst[i].positionOffset, ref[i].positionOffset, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(tst[i].normalOffset, ref[i].normalOffset, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(tst[i].tangentOffset, ref[i].tangentOffset, EPSILON);
+    }
+}
+
+void BlendshapeAccumulationTests::testAVX2() {
+    const int NUM_VERTICES = 512;
+    const float VERTEX_COEFFICIENT = 0.75f;
+    const float NORMAL_COEFFICIENT = 0.0075f;
+
+    for (int numIndices = 0; numIndices < NUM_VERTICES; ++numIndices) {
+        auto blendshape = generateBlendshape(NUM_VERTICES, numIndices, false);
+        // the tangents stop short of the rest in some models
+        int numTangents = numIndices / 2;
+
+        std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets1(NUM_VERTICES);
+        std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets2(NUM_VERTICES);
+        for (int i = 0; i < NUM_VERTICES; ++i) {
+            unpackedBlendshapeOffsets1[i] = {
+                glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)),
+                glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)),
+                glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)),
+            };
+        }
+        unpackedBlendshapeOffsets2 = unpackedBlendshapeOffsets1;
+
+        // ref version
+        accumulateBlendshapeOffsets_ref(unpackedBlendshapeOffsets1.data(), blendshape.indices.data(), blendshape.vertices.data(),
+                                        blendshape.normals.data(), blendshape.tangents.data(), numTangents,
+                                        VERTEX_COEFFICIENT, NORMAL_COEFFICIENT);
+        accumulateBlendshapeOffsets_ref(unpackedBlendshapeOffsets1.data(), blendshape.indices.data() + numTangents,
+                                        blendshape.vertices.data() + numTangents, blendshape.normals.data() + numTangents,
+                                        nullptr, numIndices - numTangents, VERTEX_COEFFICIENT, NORMAL_COEFFICIENT);
+
+        // AVX2 version, if supported by CPU
+        accumulateBlendshapeOffsets(unpackedBlendshapeOffsets2.data(), blendshape.indices.data(), blendshape.vertices.data(),
+                                    blendshape.normals.data(), blendshape.tangents.data(), numTangents,
+                                    VERTEX_COEFFICIENT, NORMAL_COEFFICIENT);
+        accumulateBlendshapeOffsets(unpackedBlendshapeOffsets2.data(), blendshape.indices.data() + numTangents,
+                                    blendshape.vertices.data() + numTangents, blendshape.normals.data() + numTangents,
+                                    nullptr, numIndices - numTangents, VERTEX_COEFFICIENT, NORMAL_COEFFICIENT);
+
+        compareOffsets(unpackedBlendshapeOffsets1, unpackedBlendshapeOffsets2);
+    }
+}
+
+void BlendshapeAccumulationTests::testRepeatedIndices() {
+    // glTF blendshapes index by triangle, so most vertices come up more than once
+    const int NUM_INDICES = 4096;
+    const float VERTEX_COEFFICIENT = 0.5f;
+    const float NORMAL_COEFFICIENT = 0.005f;
+
+    for (int numVertices = 1; numVertices <= 64; ++numVertices) {
+        auto blendshape = generateBlendshape(numVertices, NUM_INDICES, true);
+
+        std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets1(numVertices);
+        std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets2(numVertices);
+
+        accumulateBlendshapeOffsets_ref(unpackedBlendshapeOffsets1.data(), blendshape.indices.data(), blendshape.vertices.data(),
+                                        blendshape.normals.data(), blendshape.tangents.data(), NUM_INDICES,
+                                        VERTEX_COEFFICIENT, NORMAL_COEFFICIENT);
+        accumulateBlendshapeOffsets(unpackedBlendshapeOffsets2.data(), blendshape.indices.data(), blendshape.vertices.data(),
+                                    blendshape.normals.data(), blendshape.tangents.data(), NUM_INDICES,
+                                    VERTEX_COEFFICIENT, NORMAL_COEFFICIENT);
+
+        compareOffsets(unpackedBlendshapeOffsets1, unpackedBlendshapeOffsets2);
+    }
+}
+
+#ifdef MANUAL_TEST
+
+// shaped like the face of a typical avatar: the 52 ARKit blendshapes over a 12k vertex head, each moving a region of it
+const int FACE_NUM_VERTICES = 12000;
+const int FACE_NUM_BLENDSHAPES = 52;
+const int FACE_MIN_INDICES = 200;
+const int FACE_MAX_INDICES = 3000;
+// a talking face has a handful of blendshapes above the threshold in any frame
+const int FACE_ACTIVE_BLENDSHAPES = 12;
+const float COEFFICIENT_THRESHOLD = 0.0001f;
+const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+
+using AccumulateFunction = void (*)(BlendshapeOffsetUnpacked*, const int*, const glm::vec3*, const glm::vec3*, const glm::vec3*,
+                                    int, float, float);
+
+static uint64_t timeFaceFrames(AccumulateFunction accumulate, const std::vector<TestBlendshape>& blendshapes,
+                               const std::vector<std::vector<float>>& frames, std::vector<BlendshapeOffsetUnpacked>& offsets) {
+    uint64_t startTime = usecTimestampNow();
+    for (const auto& coefficients : frames) {
+        memset(offsets.data(), 0, offsets.size() * sizeof(BlendshapeOffsetUnpacked));
+        for (size_t i = 0; i < blendshapes.size(); ++i) {
+            float vertexCoefficient = coefficients[i];
+            if (vertexCoefficient < COEFFICIENT_THRESHOLD) {
+                continue;
+            }
+            const auto& blendshape = blendshapes[i];
+            accumulate(offsets.data(), blendshape.indices.data(), blendshape.vertices.data(), blendshape.normals.data(),
+                       blendshape.tangents.data(), (int)blendshape.indices.size(), vertexCoefficient,
+                       vertexCoefficient * NORMAL_COEFFICIENT_SCALE);
+        }
+    }
+    return usecTimestampNow() - startTime;
+}
+
+void BlendshapeAccumulationTests::benchmark() {
+    std::vector<TestBlendshape> blendshapes;
+    for (int i = 0; i < FACE_NUM_BLENDSHAPES; ++i) {
+        int numIndices = FACE_MIN_INDICES + rand() % (FACE_MAX_INDICES - FACE_MIN_INDICES);
+        blendshapes.push_back(generateBlendshape(FACE_NUM_VERTICES, numIndices, false));
+    }
+
+    const int NUM_FRAMES = 1000;
+    std::vector<std::vector<float>> frames(NUM_FRAMES, std::vector<float>(FACE_NUM_BLENDSHAPES, 0.0f));
+    for (auto& coefficients : frames) {
+        for (int i = 0; i < FACE_ACTIVE_BLENDSHAPES; ++i) {
+            coefficients[rand() % FACE_NUM_BLENDSHAPES] = glm::linearRand(0.0f, 1.0f);
+        }
+    }
+
+    std::vector<BlendshapeOffsetUnpacked> offsets1(FACE_NUM_VERTICES);
+    std::vector<BlendshapeOffsetUnpacked> offsets2(FACE_NUM_VERTICES);
+    uint64_t refUsecs = timeFaceFrames(&accumulateBlendshapeOffsets_ref, blendshapes, frames, offsets1);
+    uint64_t usecs = timeFaceFrames(&accumulateBlendshapeOffsets, blendshapes, frames, offsets2);
+    compareOffsets(offsets1, offsets2);
+
+    std::cout << "blendshape accumulation over " << NUM_FRAMES << " frames of a " << FACE_NUM_VERTICES << " vertex face:" << std::endl;
+    std::cout << "    ref = " << refUsecs << " usec, " << (float)refUsecs / (float)NUM_FRAMES << " usec/frame" << std::endl;
+    std::cout << "    dispatched = " << usecs << " usec, " << (float)usecs / (float)NUM_FRAMES << " usec/frame" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,28 @@
+//
+//  BlendshapeAccumulationTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeAccumulationTests_h
+#define hifi_BlendshapeAccumulationTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class BlendshapeAccumulationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAVX2();
+    void testRepeatedIndices();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_BlendshapeAccumulationTests_h
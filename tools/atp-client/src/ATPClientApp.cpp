@@ -11,6 +11,8 @@
 
 #include "ATPClientApp.h"
 
+#include <algorithm>
+
 #include <QDataStream>
 #include <QTextStream>
 #include <QThread>
@@ -57,6 +59,13 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption benchmarkOption("bench", "download the asset this many times, uncached, and report throughput",
+                                             "request-count");
+    parser.addOption(benchmarkOption);
+
+    const QCommandLineOption concurrencyOption("concurrency", "downloads to keep in flight while benchmarking", "8");
+    parser.addOption(concurrencyOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -125,6 +134,19 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
         _listenPort = parser.value(listenPortOption).toInt();
     }
 
+    if (parser.isSet(benchmarkOption)) {
+        _benchmarkCount = parser.value(benchmarkOption).toInt();
+        if (_benchmarkCount <= 0 || !_localUploadFile.isEmpty()) {
+            qDebug() << "--bench takes a positive request count and can't be combined with an upload";
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+    }
+
+    if (parser.isSet(concurrencyOption)) {
+        _benchmarkConcurrency = std::max(1, parser.value(concurrencyOption).toInt());
+    }
+
     _domainServerAddress = QString("127.0.0.1") + ":" + QString::number(domainPort);
     if (parser.isSet(domainAddressOption)) {
         _domainServerAddress = parser.value(domainAddressOption);
@@ -197,7 +219,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     }
 
     auto assetClient = DependencyManager::set<AssetClient>();
-    assetClient->initCaching();
+    if (_benchmarkCount == 0) {
+        // a benchmark has to hit the asset-server every time
+        assetClient->initCaching();
+    }
 
     if (_verbose) {
         qDebug() << "domain-server address is" << _domainServerAddress;
@@ -205,7 +230,7 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
 
-    QTimer* _timeoutTimer = new QTimer(this);
+    _timeoutTimer = new QTimer(this);
     _timeoutTimer->setSingleShot(true);
     connect(_timeoutTimer, &QTimer::timeout, this, &ATPClientApp::timedOut);
     _timeoutTimer->start(TIMEOUT_MILLISECONDS);
@@ -351,7 +376,11 @@ void ATPClientApp::lookupAsset() {
             qDebug() << "not found: " << request->getErrorString();
         } else if (result == GetMappingRequest::NoError) {
             qDebug() << "found, hash is " << request->getHash();
-            download(request->getHash());
+            if (_benchmarkCount > 0) {
+                benchmark(request->getHash());
+            } else {
+                download(request->getHash());
+            }
         } else {
             qDebug() << "error -- " << request->getError() << " -- " << request->getErrorString();
         }
@@ -390,6 +419,60 @@ void ATPClientApp::download(AssetUtils::AssetHash hash) {
     assetRequest->start();
 }
 
+void ATPClientApp::benchmark(AssetUtils::AssetHash hash) {
+    // a long benchmark would otherwise be cut off by the connection timeout
+    if (_timeoutTimer) {
+        _timeoutTimer->stop();
+    }
+
+    _benchmarkTimer.start();
+    for (int i = 0; i < std::min(_benchmarkConcurrency, _benchmarkCount); ++i) {
+        startBenchmarkRequest(hash);
+    }
+}
+
+void ATPClientApp::startBenchmarkRequest(AssetUtils::AssetHash hash) {
+    ++_benchmarkStarted;
+    auto assetRequest = new AssetRequest(hash);
+
+    connect(assetRequest, &AssetRequest::finished, this, [this, hash](AssetRequest* request) mutable {
+        if (request->getError() == AssetRequest::Error::NoError) {
+            _benchmarkBytes += request->getData().size();
+        } else {
+            ++_benchmarkFailed;
+            if (_verbose) {
+                qDebug() << "download failed: " << request->getErrorString();
+            }
+        }
+        request->deleteLater();
+
+        ++_benchmarkFinished;
+        if (_benchmarkStarted < _benchmarkCount) {
+            startBenchmarkRequest(hash);
+        } else if (_benchmarkFinished == _benchmarkCount) {
+            finishBenchmark();
+        }
+    });
+
+    assetRequest->start();
+}
+
+void ATPClientApp::finishBenchmark() {
+    static const double MSECS_PER_SECOND = 1000.0;
+    static const double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+
+    double seconds = std::max((qint64)1, _benchmarkTimer.elapsed()) / MSECS_PER_SECOND;
+    int succeeded = _benchmarkFinished - _benchmarkFailed;
+
+    QTextStream cout(stdout);
+    cout << "requests: " << _benchmarkFinished << " (" << _benchmarkFailed << " failed), "
+        << "concurrency: " << _benchmarkConcurrency << endl;
+    cout << "elapsed: " << seconds << " s, " << succeeded / seconds << " requests/s, "
+        << _benchmarkBytes / BYTES_PER_MEGABYTE / seconds << " MB/s" << endl;
+
+    finish(_benchmarkFailed > 0 ? 1 : 0);
+}
+
 void ATPClientApp::finish(int exitCode) {
     auto nodeList = DependencyManager::get<NodeList>();
 
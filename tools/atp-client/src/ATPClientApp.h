@@ -14,6 +14,7 @@
 #define hifi_ATPClientApp_h
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <udt/Constants.h>
 #include <udt/Socket.h>
 #include <ReceivedMessage.h>
@@ -46,6 +47,9 @@ private:
     void lookupAsset();
     void listAssets();
     void download(AssetUtils::AssetHash hash);
+    void benchmark(AssetUtils::AssetHash hash);
+    void startBenchmarkRequest(AssetUtils::AssetHash hash);
+    void finishBenchmark();
     void finish(int exitCode);
     bool _verbose;
 
@@ -60,6 +64,15 @@ private:
     QString _username;
     QString _password;
 
+    // repeated downloads of the same asset to measure asset-server throughput
+    int _benchmarkCount { 0 };
+    int _benchmarkConcurrency { 8 };
+    int _benchmarkStarted { 0 };
+    int _benchmarkFinished { 0 };
+    int _benchmarkFailed { 0 };
+    qint64 _benchmarkBytes { 0 };
+    QElapsedTimer _benchmarkTimer;
+
     bool _waitingForLogin { false };
     bool _waitingForNode { true };
 
@@ -14,8 +14,17 @@
 #include <QObject>
 #include <QImageReader>
 #include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QFile>
 
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "OvenCLIApplication.h"
@@ -29,6 +38,11 @@ BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
 
+void BakerCLI::setBakeCacheDirectory(const QString& directory) {
+    qDebug() << "Using the bake cache in" << directory;
+    _bakeCache.reset(new BakeCache(directory));
+}
+
 void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
 
     // if the URL doesn't have a scheme, assume it is a local file
@@ -37,6 +51,7 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
     }
 
     qDebug() << "Baking file type: " << type;
+    _isBaking = true;
 
     static const QString MODEL_EXTENSION { "model" };
     static const QString FBX_EXTENSION { "fbx" };     // legacy
@@ -45,13 +60,26 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
     _outputPath = outputPath;
 
+    if (fetchFromBakeCache(inputUrl, type)) {
+        return;
+    }
+
     // create our appropiate baker
     if (type == MODEL_EXTENSION || type == FBX_EXTENSION) {
         QUrl bakeableModelURL = getBakeableModelURL(inputUrl);
         if (!bakeableModelURL.isEmpty()) {
-            _baker = getModelBaker(bakeableModelURL, outputPath);
-            if (_baker) {
-                _baker->moveToThread(Oven::instance().getNextWorkerThread());
+            std::unique_ptr<ModelBaker> modelBaker;
+            if (!_bakedOutputDirectory.isEmpty() && !_originalOutputDirectory.isEmpty()) {
+                modelBaker = getModelBakerWithOutputDirectories(bakeableModelURL, _bakedOutputDirectory, _originalOutputDirectory);
+            } else {
+                modelBaker = getModelBaker(bakeableModelURL, outputPath);
+            }
+            if (modelBaker) {
+                if (!_outputURLSuffix.isEmpty()) {
+                    modelBaker->setOutputURLSuffix(_outputURLSuffix);
+                }
+                modelBaker->moveToThread(Oven::instance().getNextWorkerThread());
+                _baker = std::move(modelBaker);
             }
         }
     } else if (type == SCRIPT_EXTENSION) {
@@ -91,7 +119,8 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
             auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
             if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
                 qCDebug(model_baking) << "Unknown texture usage type:" << type;
-                QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                finishBake(OVEN_STATUS_CODE_FAIL);
+                return;
             }
             _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
             _baker->moveToThread(Oven::instance().getNextWorkerThread());
@@ -100,10 +129,15 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
     if (!_baker) {
         qCDebug(model_baking) << "Failed to determine baker type for file" << inputUrl;
-        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        _bakeCacheKey.clear();
+        finishBake(OVEN_STATUS_CODE_FAIL);
         return;
     }
 
+    if (!_bakeCacheKey.isEmpty()) {
+        BakeCache::startRecording();
+    }
+
     // invoke the bake method on the baker thread
     QMetaObject::invokeMethod(_baker.get(), "bake");
 
@@ -125,5 +159,198 @@ void BakerCLI::handleFinishedBaker() {
             errorFile.close();
         }
     }
-    QCoreApplication::exit(exitCode);
+    storeInBakeCache(exitCode);
+
+    if (_isWorker) {
+        QUrl outputURL;
+        if (auto modelBaker = dynamic_cast<ModelBaker*>(_baker.get())) {
+            outputURL = modelBaker->getFullOutputMappingURL();
+        }
+        writeWorkerDetails(outputURL, _baker->getErrors(), _baker->getWarnings(), false);
+    }
+    finishBake(exitCode);
+}
+
+bool BakerCLI::fetchFromBakeCache(const QUrl& inputUrl, const QString& type) {
+    _bakeCacheKey.clear();
+    if (!_bakeCache || !inputUrl.isLocalFile()) {
+        return false;
+    }
+
+    // the whole output folder is what gets cached, so it has to hold this bake and nothing else
+    if (!_outputPath.entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden).isEmpty()) {
+        return false;
+    }
+    auto outputRoot = _outputPath.absolutePath() + "/";
+    if ((!_bakedOutputDirectory.isEmpty() && !QDir(_bakedOutputDirectory).absolutePath().startsWith(outputRoot)) ||
+        (!_originalOutputDirectory.isEmpty() && !QDir(_originalOutputDirectory).absolutePath().startsWith(outputRoot))) {
+        return false;
+    }
+
+    // texture compression changes what textures, and the models and materials using them, bake to
+    auto options = TextureBaker::isCompressionEnabled() ? "compressed" : "uncompressed";
+    auto key = !_inputContentHash.isEmpty() ? BakeCache::makeKeyFromHash(_inputContentHash, type, options)
+                                            : BakeCache::makeKey(inputUrl.toLocalFile(), type, options);
+    if (key.isEmpty()) {
+        return false;
+    }
+
+    BakeCache::Result result;
+    if (!_bakeCache->fetch(key, _outputPath.absolutePath(), result)) {
+        qCDebug(model_baking) << "Bake cache miss for" << inputUrl;
+        _bakeCacheKey = key;
+        _inputPath = inputUrl.toLocalFile();
+        return false;
+    }
+
+    qCDebug(model_baking) << "Bake cache hit for" << inputUrl;
+    if (_isWorker) {
+        QUrl outputURL;
+        if (!result.outputURL.isEmpty()) {
+            // the same as ModelBaker::getFullOutputMappingURL
+            outputURL = _outputPath.absoluteFilePath(result.outputURL);
+            outputURL.setFragment(_outputURLSuffix.fragment());
+            outputURL.setQuery(_outputURLSuffix.query());
+            outputURL.setUserInfo(_outputURLSuffix.userInfo());
+        }
+        writeWorkerDetails(outputURL, QStringList(), result.warnings, true);
+    }
+    finishBake(OVEN_STATUS_CODE_SUCCESS);
+    return true;
+}
+
+void BakerCLI::storeInBakeCache(int statusCode) {
+    if (_bakeCacheKey.isEmpty()) {
+        return;
+    }
+    auto key = _bakeCacheKey;
+    _bakeCacheKey.clear();
+
+    std::vector<BakeCache::Input> inputs;
+    bool canCheckInputs = BakeCache::stopRecording(inputs);
+    if (statusCode != OVEN_STATUS_CODE_SUCCESS || !canCheckInputs) {
+        return;
+    }
+
+    // the input itself is part of the key
+    inputs.erase(std::remove_if(inputs.begin(), inputs.end(), [this](const BakeCache::Input& input) {
+        return input.filePath == _inputPath;
+    }), inputs.end());
+
+    if (!_inputContentHash.isEmpty()) {
+        // anything loaded from next to a throwaway input is gone by the time the entry would be checked again
+        auto inputDirectory = QFileInfo(_inputPath).absolutePath() + "/";
+        for (const auto& input : inputs) {
+            if (QFileInfo(input.filePath).absoluteFilePath().startsWith(inputDirectory)) {
+                qCDebug(model_baking) << "Not keeping the bake of" << _inputPath << "in the bake cache, it loaded" << input.filePath;
+                return;
+            }
+        }
+    }
+
+    BakeCache::Result result;
+    if (auto modelBaker = dynamic_cast<ModelBaker*>(_baker.get())) {
+        // without the suffix, that comes from the job
+        auto outputURL = modelBaker->getFullOutputMappingURL().adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment | QUrl::RemoveUserInfo);
+        result.outputURL = _outputPath.relativeFilePath(outputURL.toString());
+    }
+    result.warnings = _baker->getWarnings();
+    _bakeCache->store(key, _outputPath.absolutePath(), result, inputs);
+}
+
+void BakerCLI::finishBake(int statusCode) {
+    if (!_isWorker) {
+        QCoreApplication::exit(statusCode);
+        return;
+    }
+
+    if (_baker) {
+        // the baker may still have events queued on its thread, let it go from there
+        _baker.release()->deleteLater();
+    }
+    _isBaking = false;
+
+    // one line, one write, so it can't be interleaved with log output
+    auto result = (OVEN_WORKER_RESULT_PREFIX + QString::number(statusCode) + "\n").toUtf8();
+    fwrite(result.constData(), 1, result.size(), stdout);
+    fflush(stdout);
+
+    bakeNextJob();
+}
+
+void BakerCLI::writeWorkerDetails(const QUrl& outputURL, const QStringList& errors, const QStringList& warnings, bool fromCache) {
+    QJsonObject details;
+    if (!outputURL.isEmpty()) {
+        details["outputURL"] = outputURL.toString();
+    }
+    details["errors"] = QJsonArray::fromStringList(errors);
+    details["warnings"] = QJsonArray::fromStringList(warnings);
+    details["fromCache"] = fromCache;
+
+    auto line = (OVEN_WORKER_DETAILS_PREFIX + QJsonDocument(details).toJson(QJsonDocument::Compact) + "\n").toUtf8();
+    fwrite(line.constData(), 1, line.size(), stdout);
+    fflush(stdout);
+}
+
+void BakerCLI::runWorker() {
+    _isWorker = true;
+
+    // stdin can't be watched by the event loop on every platform, so block on it from a thread of its own
+    std::thread([this] {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            QMetaObject::invokeMethod(this, "queueBakeJob", Qt::QueuedConnection,
+                                      Q_ARG(QByteArray, QByteArray::fromStdString(line)));
+        }
+        QMetaObject::invokeMethod(this, "handleInputClosed", Qt::QueuedConnection);
+    }).detach();
+}
+
+void BakerCLI::queueBakeJob(QByteArray job) {
+    job = job.trimmed();
+    if (job.isEmpty()) {
+        return;
+    }
+    _pendingJobs.enqueue(job);
+    bakeNextJob();
+}
+
+void BakerCLI::handleInputClosed() {
+    _inputClosed = true;
+    bakeNextJob();
+}
+
+void BakerCLI::bakeNextJob() {
+    if (_isBaking) {
+        return;
+    }
+
+    if (_pendingJobs.isEmpty()) {
+        if (_inputClosed) {
+            if (_bakeCache) {
+                auto& stats = _bakeCache->getStats();
+                qDebug() << "Bake cache:" << stats.hits << "hits," << stats.misses << "misses," << stats.stores << "stored,"
+                         << stats.evictions << "evicted";
+            }
+            QCoreApplication::exit(OVEN_STATUS_CODE_SUCCESS);
+        }
+        return;
+    }
+
+    auto job = QJsonDocument::fromJson(_pendingJobs.dequeue()).object();
+    auto input = job["input"].toString();
+    auto output = job["output"].toString();
+    if (input.isEmpty() || output.isEmpty()) {
+        qCWarning(model_baking) << "Worker received a bake job without an input and output";
+        _isBaking = true;
+        finishBake(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+
+    _bakedOutputDirectory = QDir::fromNativeSeparators(job["bakedOutput"].toString());
+    _originalOutputDirectory = QDir::fromNativeSeparators(job["originalOutput"].toString());
+    _outputURLSuffix = QUrl(job["urlSuffix"].toString());
+    _inputContentHash = QByteArray::fromHex(job["contentHash"].toString().toLatin1());
+
+    bakeFile(QUrl(QDir::fromNativeSeparators(input)), QDir::fromNativeSeparators(output), job["type"].toString());
 }
@@ -13,19 +13,16 @@
 #define hifi_BakerCLI_h
 
 #include <QtCore/QObject>
+#include <QtCore/QQueue>
 #include <QDir>
 #include <QUrl>
 
 #include <memory>
 
+#include "BakeCache.h"
 #include "Baker.h"
 #include "OvenCLIApplication.h"
-
-static const int OVEN_STATUS_CODE_SUCCESS { 0 };
-static const int OVEN_STATUS_CODE_FAIL { 1 };
-static const int OVEN_STATUS_CODE_ABORT { 2 };
-
-static const QString OVEN_ERROR_FILENAME = "errors.txt";
+#include "OvenWorkerProtocol.h"
 
 class BakerCLI : public QObject {
     Q_OBJECT
@@ -33,15 +30,49 @@ class BakerCLI : public QObject {
 public:
     BakerCLI(OvenCLIApplication* parent);
 
+    /// Keeps finished bakes of local files in directory and copies them out again when the same content is baked
+    void setBakeCacheDirectory(const QString& directory);
+
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString::null);
 
+    /// Stays up and bakes the jobs read from stdin, one JSON object per line with an input, output and type, reporting
+    /// each result on stdout. Model jobs can also name the exact bakedOutput and originalOutput directories and a
+    /// urlSuffix for the baked model URL. A job whose input is a throwaway copy names the contentHash (hex SHA-256) of
+    /// the input, which the bake is cached under. Exits once stdin is closed.
+    void runWorker();
+    void queueBakeJob(QByteArray job);
+    void handleInputClosed();
+
 private slots:
     void handleFinishedBaker();  
 
 private:
+    void finishBake(int statusCode);
+    void bakeNextJob();
+    bool fetchFromBakeCache(const QUrl& inputUrl, const QString& type);
+    void storeInBakeCache(int statusCode);
+    void writeWorkerDetails(const QUrl& outputURL, const QStringList& errors, const QStringList& warnings, bool fromCache);
+
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
+
+    bool _isWorker { false };
+    bool _isBaking { false };
+    bool _inputClosed { false };
+    QQueue<QByteArray> _pendingJobs;
+
+    // where the model of the current job goes, when the job says
+    QString _bakedOutputDirectory;
+    QString _originalOutputDirectory;
+    QUrl _outputURLSuffix;
+    // the hash of the input's content when the job gave it, the input is then a copy that will be gone after the bake
+    QByteArray _inputContentHash;
+
+    std::unique_ptr<BakeCache> _bakeCache;
+    // set while a bake that can be kept in the cache is running
+    QByteArray _bakeCacheKey;
+    QString _inputPath;
 };
 
 #endif // hifi_BakerCLI_h
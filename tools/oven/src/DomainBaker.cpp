@@ -17,6 +17,8 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonObject>
 
+#include <NumericalConstants.h>
+
 #include "Gzip.h"
 #include "Oven.h"
 #include "baking/BakerLibrary.h"
@@ -37,7 +39,16 @@ DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainNam
     }
 }
 
+static const QString CONTENT_OUTPUT_FOLDER_NAME = "content";
+static const QString BAKED_ENTITIES_FILE_NAME = "models.json.gz";
+// what was being baked into an output folder, so an interrupted bake can find it again
+static const QString BAKE_STATE_FILE_NAME = "bake-state.json";
+// a line for each model baked into an output folder
+static const QString BAKE_JOURNAL_FILE_NAME = "bake-journal.jsonl";
+
 void DomainBaker::bake() {
+    _bakeTimer.start();
+
     setupOutputFolder();
 
     if (hasErrors()) {
@@ -50,6 +61,12 @@ void DomainBaker::bake() {
         return;
     }
 
+    if (_modelProcessCount > 0) {
+        _workerPool.reset(new OvenWorkerPool(_modelProcessCount));
+        connect(_workerPool.get(), &OvenWorkerPool::modelBakeFinished, this, &DomainBaker::handleFinishedModelBake);
+        qDebug() << "Baking models in" << _workerPool->getProcessCount() << "oven processes";
+    }
+
     enumerateEntities();
 
     if (hasErrors()) {
@@ -61,6 +78,10 @@ void DomainBaker::bake() {
 }
 
 void DomainBaker::setupOutputFolder() {
+    if (resumeOutputFolder()) {
+        return;
+    }
+
     // in order to avoid overwriting previous bakes, we create a special output folder with the domain name and timestamp
 
     // first, construct the directory name
@@ -85,7 +106,6 @@ void DomainBaker::setupOutputFolder() {
     _uniqueOutputPath = outputDir.absolutePath();
 
     // add a content folder inside the unique output folder
-    static const QString CONTENT_OUTPUT_FOLDER_NAME = "content";
     if (!outputDir.mkpath(CONTENT_OUTPUT_FOLDER_NAME)) {
         // add an error to specify that the content output directory could not be created
         handleError("Could not create content folder");
@@ -93,6 +113,89 @@ void DomainBaker::setupOutputFolder() {
     }
 
     _contentOutputPath = outputDir.absoluteFilePath(CONTENT_OUTPUT_FOLDER_NAME);
+
+    // remember what goes in here in case this bake is interrupted
+    QFile stateFile { outputDir.absoluteFilePath(BAKE_STATE_FILE_NAME) };
+    if (!stateFile.open(QIODevice::WriteOnly) || stateFile.write(QJsonDocument(getBakeState()).toJson()) == -1) {
+        qWarning() << "Could not write" << stateFile.fileName() << "- this bake will not be resumable";
+    }
+}
+
+QJsonObject DomainBaker::getBakeState() const {
+    QFileInfo entitiesFileInfo { _localEntitiesFileURL.toLocalFile() };
+
+    QJsonObject state;
+    state["entitiesFile"] = entitiesFileInfo.absoluteFilePath();
+    state["entitiesFileSize"] = entitiesFileInfo.size();
+    state["entitiesFileModified"] = entitiesFileInfo.lastModified().toMSecsSinceEpoch();
+    state["rebakeOriginals"] = _shouldRebakeOriginals;
+    return state;
+}
+
+bool DomainBaker::resumeOutputFolder() {
+    // the newest output folder of this domain that never got its baked entities file, from a bake of the same file
+    auto domainPrefix = !_domainName.isEmpty() ? _domainName + "-" : "";
+    QDir baseOutputDir { _baseOutputPath };
+    auto candidates = baseOutputDir.entryList({ domainPrefix + "*" }, QDir::Dirs | QDir::NoDotAndDotDot,
+                                              QDir::Name | QDir::Reversed);
+
+    auto expectedState = getBakeState();
+    for (const auto& candidate : candidates) {
+        QDir outputDir { baseOutputDir.absoluteFilePath(candidate) };
+        if (outputDir.exists(BAKED_ENTITIES_FILE_NAME) || !outputDir.exists(CONTENT_OUTPUT_FOLDER_NAME)) {
+            continue;
+        }
+
+        QFile stateFile { outputDir.absoluteFilePath(BAKE_STATE_FILE_NAME) };
+        if (!stateFile.open(QIODevice::ReadOnly) || QJsonDocument::fromJson(stateFile.readAll()).object() != expectedState) {
+            continue;
+        }
+
+        _uniqueOutputPath = outputDir.absolutePath();
+        _contentOutputPath = outputDir.absoluteFilePath(CONTENT_OUTPUT_FOLDER_NAME);
+
+        // a line cut short by the interruption is just left out, that model gets baked again, and so does one whose
+        // output has gone missing since
+        QDir contentDir { _contentOutputPath };
+        QFile journalFile { outputDir.absoluteFilePath(BAKE_JOURNAL_FILE_NAME) };
+        if (journalFile.open(QIODevice::ReadOnly)) {
+            while (!journalFile.atEnd()) {
+                auto entry = QJsonDocument::fromJson(journalFile.readLine()).object();
+                auto modelURL = QUrl(entry["model"].toString());
+                auto output = entry["output"].toString();
+                if (modelURL.isEmpty() || output.isEmpty()) {
+                    continue;
+                }
+
+                // the output is a mapping URL, which can carry the query and fragment of the model URL
+                QFileInfo mappingFile { contentDir.absoluteFilePath(QUrl(output).path(QUrl::FullyDecoded)) };
+                if (!mappingFile.isFile() || mappingFile.size() == 0) {
+                    qDebug() << "Baking" << modelURL << "again," << mappingFile.filePath() << "is missing";
+                    _journaledModelBakes.remove(modelURL);
+                    continue;
+                }
+                _journaledModelBakes.insert(modelURL, output);
+            }
+        }
+
+        qDebug() << "Resuming the interrupted bake in" << _uniqueOutputPath << "-"
+                 << _journaledModelBakes.size() << "models are already baked";
+        return true;
+    }
+
+    return false;
+}
+
+void DomainBaker::appendToBakeJournal(const QUrl& modelURL, const QString& relativeMappingFilePath) {
+    QJsonObject entry;
+    entry["model"] = modelURL.toString();
+    entry["output"] = relativeMappingFilePath;
+
+    QFile journalFile { QDir(_uniqueOutputPath).absoluteFilePath(BAKE_JOURNAL_FILE_NAME) };
+    if (!journalFile.open(QIODevice::Append) ||
+        journalFile.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + "\n") == -1) {
+        qWarning() << "Could not add" << modelURL << "to the bake journal";
+    }
 }
 
 const QString ENTITIES_OBJECT_KEY = "Entities";
@@ -101,8 +204,10 @@ void DomainBaker::loadLocalFile() {
     // load up the local entities file
     QFile entitiesFile { _localEntitiesFileURL.toLocalFile() };
 
-    // first make a copy of the local entities file in our output folder
-    if (!entitiesFile.copy(_uniqueOutputPath + "/" + "original-" + _localEntitiesFileURL.fileName())) {
+    // first make a copy of the local entities file in our output folder, a resumed bake already has one
+    auto originalCopyPath = _uniqueOutputPath + "/" + "original-" + _localEntitiesFileURL.fileName();
+    QFile::remove(originalCopyPath);
+    if (!entitiesFile.copy(originalCopyPath)) {
         // add an error to our list to specify that the file could not be copied
         handleError("Could not make a copy of entities file");
 
@@ -148,9 +253,24 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
     // grab a QUrl for the model URL
     QUrl bakeableModelURL = getBakeableModelURL(url);
     if (!bakeableModelURL.isEmpty() && (_shouldRebakeOriginals || !isModelBaked(bakeableModelURL))) {
+        auto journalIt = _journaledModelBakes.find(bakeableModelURL);
+        if (journalIt != _journaledModelBakes.end()) {
+            // baked before this bake was interrupted
+            rewriteModelReference(property, jsonRef, _destinationPath.resolved(journalIt.value()));
+            return;
+        }
+
         // setup a ModelBaker for this URL, as long as we don't already have one
-        bool haveBaker = _modelBakers.contains(bakeableModelURL);
-        if (!haveBaker) {
+        bool haveBaker = _modelBakers.contains(bakeableModelURL) || _modelsBakingOutOfProcess.contains(bakeableModelURL);
+        if (!haveBaker && _workerPool) {
+            auto outputDirectory = reserveModelOutputDirectory(bakeableModelURL);
+            _workerPool->queueModelBake({ bakeableModelURL, url, outputDirectory + "/baked", outputDirectory + "/original" });
+            _modelsBakingOutOfProcess.insert(bakeableModelURL);
+            haveBaker = true;
+
+            // keep track of the total number of baking entities
+            ++_totalNumberOfSubBakes;
+        } else if (!haveBaker) {
             QSharedPointer<ModelBaker> baker = QSharedPointer<ModelBaker>(getModelBaker(bakeableModelURL, _contentOutputPath).release(), &Baker::deleteLater);
             if (baker) {
                 // Hold on to the old url userinfo/query/fragment data so ModelBaker::getFullOutputMappingURL retains that data from the original model URL
@@ -423,79 +543,133 @@ void DomainBaker::enumerateEntities() {
         }
     }
 
+    if (!_journaledModelBakes.isEmpty()) {
+        qDebug() << "Left out" << _journaledModelBakes.size() << "models baked before the bake was interrupted";
+    }
+
     // emit progress now to say we're just starting
-    emit bakeProgress(0, _totalNumberOfSubBakes);
+    emitBakeProgress();
 }
 
 void DomainBaker::handleFinishedModelBaker() {
     auto baker = qobject_cast<ModelBaker*>(sender());
 
     if (baker) {
-        if (!baker->hasErrors()) {
-            // this ModelBaker is done and everything went according to plan
-            qDebug() << "Re-writing entity references to" << baker->getModelURL();
+        auto modelURL = baker->getModelURL();
+        finishModelBake(modelURL, baker->hasErrors() ? QUrl() : baker->getFullOutputMappingURL(), baker->getErrors());
 
-            // setup a new URL using the prefix we were passed
-            auto relativeMappingFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getFullOutputMappingURL().toString());
-            if (relativeMappingFilePath.startsWith("/")) {
-                relativeMappingFilePath = relativeMappingFilePath.right(relativeMappingFilePath.length() - 1);
-            }
+        // drop our shared pointer to this baker so that it gets cleaned up
+        _modelBakers.remove(modelURL);
 
-            QUrl newURL = _destinationPath.resolved(relativeMappingFilePath);
+        // check if this was the last model we needed to re-write and if we are done now
+        checkIfRewritingComplete();
+    }
+}
 
-            // enumerate the QJsonRef values for the URL of this model from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getModelURL())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
+void DomainBaker::handleFinishedModelBake(QUrl modelURL, bool succeeded, QUrl outputMappingURL, QStringList errors,
+                                          QStringList warnings, bool fromCache) {
+    if (!_modelsBakingOutOfProcess.remove(modelURL)) {
+        return;
+    }
 
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
+    if (fromCache) {
+        qDebug() << "Took the bake of" << modelURL << "from the bake cache";
+    }
 
-                    // set the new URL as the value in our temp QJsonObject
-                    // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
+    _warningList << warnings;
+    finishModelBake(modelURL, succeeded ? outputMappingURL : QUrl(), errors);
 
-                    // copy the fragment and query, and user info from the old model URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
+    // check if this was the last model we needed to re-write and if we are done now
+    checkIfRewritingComplete();
+}
 
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
+void DomainBaker::finishModelBake(const QUrl& modelURL, const QUrl& outputMappingURL, const QStringList& errors) {
+    if (!outputMappingURL.isEmpty()) {
+        // this model is done and everything went according to plan
+        qDebug() << "Re-writing entity references to" << modelURL;
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
-        } else {
-            // this model failed to bake - this doesn't fail the entire bake but we need to add
-            // the errors from the model to our warnings
-            _warningList << baker->getErrors();
+        // setup a new URL using the prefix we were passed
+        auto relativeMappingFilePath = QDir(_contentOutputPath).relativeFilePath(outputMappingURL.toString());
+        if (relativeMappingFilePath.startsWith("/")) {
+            relativeMappingFilePath = relativeMappingFilePath.right(relativeMappingFilePath.length() - 1);
         }
 
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getModelURL());
+        QUrl newURL = _destinationPath.resolved(relativeMappingFilePath);
 
-        // drop our shared pointer to this baker so that it gets cleaned up
-        _modelBakers.remove(baker->getModelURL());
+        // enumerate the QJsonRef values for the URL of this model from our multi hash of
+        // entity objects needing a URL re-write
+        for (auto propertyEntityPair : _entitiesNeedingRewrite.values(modelURL)) {
+            rewriteModelReference(propertyEntityPair.first, propertyEntityPair.second, newURL);
+        }
 
-        // emit progress to tell listeners how many models we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+        // a resumed bake can skip this model
+        appendToBakeJournal(modelURL, relativeMappingFilePath);
+    } else {
+        // this model failed to bake - this doesn't fail the entire bake but we need to add
+        // the errors from the model to our warnings
+        _warningList << errors;
+    }
 
-        // check if this was the last model we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+    // remove the baked URL from the multi hash of entities needing a re-write
+    _entitiesNeedingRewrite.remove(modelURL);
+
+    // emit progress to tell listeners how many models we have baked
+    ++_completedSubBakes;
+    emitBakeProgress();
+}
+
+void DomainBaker::rewriteModelReference(const QString& property, QJsonValueRef jsonRef, QUrl newURL) {
+    // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
+    auto entity = jsonRef.toObject();
+
+    if (!property.contains(".")) {
+        // set the new URL as the value in our temp QJsonObject
+        // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
+        entity[property] = newURL.toString();
+    } else {
+        // Group property
+        QStringList propertySplit = property.split(".");
+        assert(propertySplit.length() == 2);
+        // grab the old URL
+        auto oldObject = entity[propertySplit[0]].toObject();
+        QUrl oldURL = oldObject[propertySplit[1]].toString();
+
+        // copy the fragment and query, and user info from the old model URL
+        newURL.setQuery(oldURL.query());
+        newURL.setFragment(oldURL.fragment());
+        newURL.setUserInfo(oldURL.userInfo());
+
+        // set the new URL as the value in our temp QJsonObject
+        oldObject[propertySplit[1]] = newURL.toString();
+        entity[propertySplit[0]] = oldObject;
     }
+
+    // replace our temp object with the value referenced by our QJsonValueRef
+    jsonRef = entity;
+}
+
+QString DomainBaker::reserveModelOutputDirectory(const QUrl& modelURL) {
+    // the same naming as getModelBaker, but the folders of the models still waiting on an oven have to be skipped too
+    auto filename = modelURL.fileName();
+    auto baseName = filename.left(filename.lastIndexOf('.')).left(filename.lastIndexOf(".baked"));
+    auto subDirName = baseName;
+    int i = 1;
+    while (_reservedModelDirectories.contains(subDirName) || QDir(_contentOutputPath + "/" + subDirName).exists()) {
+        subDirName = baseName + "-" + QString::number(i++);
+    }
+    _reservedModelDirectories.insert(subDirName);
+
+    return _contentOutputPath + "/" + subDirName;
+}
+
+void DomainBaker::emitBakeProgress() {
+    // guess from how long the bakes so far took, the models that are left are as good a guess as any
+    qint64 msecsRemaining = -1;
+    if (_completedSubBakes > 0) {
+        msecsRemaining = _bakeTimer.elapsed() * (_totalNumberOfSubBakes - _completedSubBakes) / _completedSubBakes;
+        qDebug() << "Baked" << _completedSubBakes << "of" << _totalNumberOfSubBakes << "-" << msecsRemaining / MSECS_PER_SECOND << "seconds left";
+    }
+    emit bakeProgress(_completedSubBakes, _totalNumberOfSubBakes, msecsRemaining);
 }
 
 void DomainBaker::handleFinishedTextureBaker() {
@@ -567,7 +741,8 @@ void DomainBaker::handleFinishedTextureBaker() {
         _textureBakers.remove({ baker->getTextureURL(), baker->getTextureType() });
 
         // emit progress to tell listeners how many textures we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+        ++_completedSubBakes;
+        emitBakeProgress();
 
         // check if this was the last texture we needed to re-write and if we are done now
         checkIfRewritingComplete();
@@ -641,7 +816,8 @@ void DomainBaker::handleFinishedScriptBaker() {
         _scriptBakers.remove(baker->getJSPath());
 
         // emit progress to tell listeners how many scripts we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+        ++_completedSubBakes;
+        emitBakeProgress();
 
         // check if this was the last script we needed to re-write and if we are done now
         checkIfRewritingComplete();
@@ -731,7 +907,8 @@ void DomainBaker::handleFinishedMaterialBaker() {
         _materialBakers.remove(baker->getMaterialData());
 
         // emit progress to tell listeners how many materials we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+        ++_completedSubBakes;
+        emitBakeProgress();
 
         // check if this was the last material we needed to re-write and if we are done now
         checkIfRewritingComplete();
@@ -740,6 +917,11 @@ void DomainBaker::handleFinishedMaterialBaker() {
 
 void DomainBaker::checkIfRewritingComplete() {
     if (_entitiesNeedingRewrite.isEmpty()) {
+        if (_workerPool) {
+            // we may be in one of its signals
+            _workerPool.release()->deleteLater();
+        }
+
         writeNewEntitiesFile();
 
         if (hasErrors()) {
@@ -767,9 +949,7 @@ void DomainBaker::writeNewEntitiesFile() {
     gzip(jsonByteArray, compressedJson);
 
     // write the gzipped json to a new models file
-    static const QString MODELS_FILE_NAME = "models.json.gz";
-
-    auto bakedEntitiesFilePath = QDir(_uniqueOutputPath).filePath(MODELS_FILE_NAME);
+    auto bakedEntitiesFilePath = QDir(_uniqueOutputPath).filePath(BAKED_ENTITIES_FILE_NAME);
     QFile compressedEntitiesFile { bakedEntitiesFilePath };
 
     if (!compressedEntitiesFile.open(QIODevice::WriteOnly)
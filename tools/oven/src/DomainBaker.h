@@ -12,9 +12,14 @@
 #ifndef hifi_DomainBaker_h
 #define hifi_DomainBaker_h
 
+#include <memory>
+
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
 
@@ -22,34 +27,49 @@
 #include "TextureBaker.h"
 #include "JSBaker.h"
 #include "MaterialBaker.h"
+#include "OvenWorkerPool.h"
 
 class DomainBaker : public Baker {
     Q_OBJECT
 public:
-    // This is a real bummer, but the FBX SDK is not thread safe - even with separate FBXManager objects.
-    // This means that we need to put all of the FBX importing/exporting from the same process on the same thread.
-    // That means you must pass a usable running QThread when constructing a domain baker.
+    // An interrupted bake of the same entities file into the same base output path picks up where it left off,
+    // the models it had baked are not baked again.
     DomainBaker(const QUrl& localEntitiesFileURL, const QString& domainName,
                 const QString& baseOutputPath, const QUrl& destinationPath,
                 bool shouldRebakeOriginals);
 
+    // Bake the models in this many child oven processes instead of on the worker threads of this one, so a model
+    // that brings its oven down only fails itself. 0 bakes them in this process. Set before baking.
+    void setModelProcessCount(int processCount) { _modelProcessCount = processCount; }
+
 signals:
     void allModelsFinished();
-    void bakeProgress(int baked, int total);
+    // msecsRemaining is -1 until there is enough to go on
+    void bakeProgress(int baked, int total, qint64 msecsRemaining);
 
 private slots:
     virtual void bake() override;
     void handleFinishedModelBaker();
+    void handleFinishedModelBake(QUrl modelURL, bool succeeded, QUrl outputMappingURL, QStringList errors, QStringList warnings,
+                                 bool fromCache);
     void handleFinishedTextureBaker();
     void handleFinishedScriptBaker();
     void handleFinishedMaterialBaker();
 
 private:
     void setupOutputFolder();
+    bool resumeOutputFolder();
+    QJsonObject getBakeState() const;
     void loadLocalFile();
     void enumerateEntities();
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
+    void emitBakeProgress();
+
+    QString reserveModelOutputDirectory(const QUrl& modelURL);
+    void finishModelBake(const QUrl& modelURL, const QUrl& outputMappingURL, const QStringList& errors);
+    void rewriteModelReference(const QString& property, QJsonValueRef jsonRef, QUrl newURL);
+    void appendToBakeJournal(const QUrl& modelURL, const QString& relativeMappingFilePath);
 
     QUrl _localEntitiesFileURL;
     QString _domainName;
@@ -64,6 +84,12 @@ private:
     QJsonArray _entities;
 
     QHash<QUrl, QSharedPointer<ModelBaker>> _modelBakers;
+    int _modelProcessCount { 0 };
+    std::unique_ptr<OvenWorkerPool> _workerPool;
+    QSet<QUrl> _modelsBakingOutOfProcess;
+    QSet<QString> _reservedModelDirectories;
+    // models baked by an earlier run of an interrupted bake, with where their mapping went relative to the content
+    QHash<QUrl, QString> _journaledModelBakes;
     QHash<TextureKey, QSharedPointer<TextureBaker>> _textureBakers;
     TextureFileNamer _textureFileNamer;
     QHash<QUrl, QSharedPointer<JSBaker>> _scriptBakers;
@@ -73,6 +99,7 @@ private:
 
     int _totalNumberOfSubBakes { 0 };
     int _completedSubBakes { 0 };
+    QElapsedTimer _bakeTimer;
 
     bool _shouldRebakeOriginals { false };
 
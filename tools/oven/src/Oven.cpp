@@ -81,6 +81,13 @@ void Oven::setupWorkerThreads(int numWorkerThreads) {
     }
 }
 
+void Oven::limitWorkerThreads(int maxWorkerThreads) {
+    // none of them has been started yet, so they can just go
+    if (maxWorkerThreads > 0 && (size_t)maxWorkerThreads < _workerThreads.size()) {
+        _workerThreads.resize(maxWorkerThreads);
+    }
+}
+
 QThread* Oven::getNextWorkerThread() {
     // FIXME: we assign these threads when we make the bakers, but if certain bakers finish quickly, we could end up
     // in a situation where threads have finished and others have tons of work queued.  Instead of assigning them at initialization,
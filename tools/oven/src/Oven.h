@@ -28,6 +28,9 @@ public:
 
     QThread* getNextWorkerThread();
 
+    /// Bakes on at most maxWorkerThreads threads, call before anything is baked
+    void limitWorkerThreads(int maxWorkerThreads);
+
 private:
     void setupWorkerThreads(int numWorkerThreads);
     void setupFBXBakerThread();
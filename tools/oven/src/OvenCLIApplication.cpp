@@ -15,6 +15,7 @@
 #include <QtCore/QUrl>
 
 #include <image/TextureProcessing.h>
+#include <PathUtils.h>
 #include <TextureBaker.h>
 
 #include "BakerCLI.h"
@@ -23,6 +24,10 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_WORKER_PARAMETER = "worker";
+static const QString CLI_BAKE_CACHE_PARAMETER = "bake-cache";
+static const QString CLI_NO_BAKE_CACHE_PARAMETER = "no-bake-cache";
+static const QString CLI_THREADS_PARAMETER = "threads";
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -34,23 +39,47 @@ OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_WORKER_PARAMETER, "Stay running and bake the jobs written to stdin, one JSON object per line." },
+        { CLI_BAKE_CACHE_PARAMETER, "Folder to keep finished bakes of local files in and reuse them from.", "directory" },
+        { CLI_NO_BAKE_CACHE_PARAMETER, "Always bake, don't use the bake cache." },
+        { CLI_THREADS_PARAMETER, "Most worker threads to bake with, one per core by default.", "count" }
     });
 
     parser.addHelpOption();
     parser.process(*this);
 
-    if (parser.isSet(CLI_INPUT_PARAMETER) && parser.isSet(CLI_OUTPUT_PARAMETER)) {
+    if (parser.isSet(CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER)) {
+        qDebug() << "Disabling texture compression";
+        TextureBaker::setCompressionEnabled(false);
+    }
+
+    if (parser.isSet(CLI_THREADS_PARAMETER)) {
+        limitWorkerThreads(parser.value(CLI_THREADS_PARAMETER).toInt());
+    }
+
+    // shared by every oven run by this user, the asset server's included
+    QString bakeCacheDirectory;
+    if (!parser.isSet(CLI_NO_BAKE_CACHE_PARAMETER)) {
+        bakeCacheDirectory = parser.isSet(CLI_BAKE_CACHE_PARAMETER) ? parser.value(CLI_BAKE_CACHE_PARAMETER)
+                                                                    : PathUtils::getAppLocalDataPath() + "bake-cache";
+    }
+
+    if (parser.isSet(CLI_WORKER_PARAMETER)) {
         BakerCLI* cli = new BakerCLI(this);
+        if (!bakeCacheDirectory.isEmpty()) {
+            cli->setBakeCacheDirectory(bakeCacheDirectory);
+        }
+        QMetaObject::invokeMethod(cli, "runWorker", Qt::QueuedConnection);
+    } else if (parser.isSet(CLI_INPUT_PARAMETER) && parser.isSet(CLI_OUTPUT_PARAMETER)) {
+        BakerCLI* cli = new BakerCLI(this);
+        if (!bakeCacheDirectory.isEmpty()) {
+            cli->setBakeCacheDirectory(bakeCacheDirectory);
+        }
         QUrl inputUrl(QDir::fromNativeSeparators(parser.value(CLI_INPUT_PARAMETER)));
         QUrl outputUrl(QDir::fromNativeSeparators(parser.value(CLI_OUTPUT_PARAMETER)));
         QString type = parser.isSet(CLI_TYPE_PARAMETER) ? parser.value(CLI_TYPE_PARAMETER) : QString::null;
 
-        if (parser.isSet(CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER)) {
-            qDebug() << "Disabling texture compression";
-            TextureBaker::setCompressionEnabled(false);
-        }
-
         QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, inputUrl),
                                     Q_ARG(QString, outputUrl.toString()), Q_ARG(QString, type));
     } else {
@@ -0,0 +1,112 @@
+//
+//  OvenWorkerPool.cpp
+//  tools/oven/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OvenWorkerPool.h"
+
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QThread>
+
+#include <OvenWorker.h>
+#include <TextureBaker.h>
+
+static QStringList toStringList(const QJsonValue& value) {
+    QStringList list;
+    for (const auto& item : value.toArray()) {
+        list << item.toString();
+    }
+    return list;
+}
+
+OvenWorkerPool::OvenWorkerPool(int processCount, QObject* parent) :
+    QObject(parent)
+{
+    // every oven runs its own worker threads, so give each of them its share of the cores rather than all of them
+    int coreCount = std::max(1, QThread::idealThreadCount());
+    processCount = std::max(1, std::min(processCount, coreCount));
+
+    OvenWorker::Options options;
+    options.ovenPath = QCoreApplication::applicationFilePath();
+    options.arguments << "--threads" << QString::number(std::max(1, coreCount / processCount));
+    if (!TextureBaker::isCompressionEnabled()) {
+        options.arguments << "--disable-texture-compression";
+    }
+
+    _workers.resize(processCount);
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        auto oven = new OvenWorker(options, this);
+        connect(oven, &OvenWorker::bakeFinished, this, [this, i](int statusCode, QJsonObject details) {
+            handleBakeFinished(i, statusCode, details);
+        });
+        connect(oven, &OvenWorker::bakeCrashed, this, [this, i](QString reason, bool) {
+            handleBakeCrashed(i, reason);
+        });
+        _workers[i].oven = oven;
+    }
+}
+
+void OvenWorkerPool::queueModelBake(const ModelBakeJob& job) {
+    _pendingJobs.enqueue(job);
+    dispatchJobs();
+}
+
+void OvenWorkerPool::dispatchJobs() {
+    for (auto& worker : _workers) {
+        if (_pendingJobs.isEmpty()) {
+            return;
+        }
+        if (worker.oven->isBaking()) {
+            continue;
+        }
+
+        worker.job = _pendingJobs.dequeue();
+
+        QJsonObject job;
+        job["input"] = worker.job.modelURL.toString();
+        // the folder holding both outputs, so the oven can cache the whole bake
+        job["output"] = QFileInfo(worker.job.bakedOutputDirectory).path();
+        job["type"] = "model";
+        job["bakedOutput"] = worker.job.bakedOutputDirectory;
+        job["originalOutput"] = worker.job.originalOutputDirectory;
+        job["urlSuffix"] = worker.job.outputURLSuffix.toString();
+        worker.oven->bake(job, 0);
+    }
+}
+
+void OvenWorkerPool::handleBakeFinished(size_t workerIndex, int statusCode, const QJsonObject& details) {
+    auto modelURL = _workers[workerIndex].job.modelURL;
+
+    auto errors = toStringList(details["errors"]);
+    auto warnings = toStringList(details["warnings"]);
+    bool succeeded = statusCode == OVEN_STATUS_CODE_SUCCESS && errors.isEmpty();
+    if (!succeeded && errors.isEmpty()) {
+        errors << "Failed to bake " + modelURL.toString();
+    }
+
+    dispatchJobs();
+
+    emit modelBakeFinished(modelURL, succeeded, QUrl(details["outputURL"].toString()), errors, warnings,
+                           details["fromCache"].toBool());
+}
+
+void OvenWorkerPool::handleBakeCrashed(size_t workerIndex, const QString& reason) {
+    // the model took its oven down with it, fail it and carry on with a new oven
+    auto modelURL = _workers[workerIndex].job.modelURL;
+    qWarning() << "Oven worker failed while baking" << modelURL << "-" << reason;
+
+    dispatchJobs();
+
+    emit modelBakeFinished(modelURL, false, QUrl(), { "The oven baking " + modelURL.toString() + " failed: " + reason }, {},
+                           false);
+}
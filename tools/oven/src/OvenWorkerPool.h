@@ -0,0 +1,62 @@
+//
+//  OvenWorkerPool.h
+//  tools/oven/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OvenWorkerPool_h
+#define hifi_OvenWorkerPool_h
+
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QStringList>
+#include <QtCore/QUrl>
+
+class OvenWorker;
+
+/// Child oven processes running in worker mode that model bakes can be handed to. Each process has its own model
+/// importing and exporting, so the bakes scale with the processes, and a model that crashes its oven only fails itself.
+/// The cores are split between the processes, so together they don't run more worker threads than this oven would.
+/// Has to live on a thread with an event loop.
+class OvenWorkerPool : public QObject {
+    Q_OBJECT
+public:
+    struct ModelBakeJob {
+        QUrl modelURL;
+        QUrl outputURLSuffix;
+        QString bakedOutputDirectory;
+        QString originalOutputDirectory;
+    };
+
+    OvenWorkerPool(int processCount, QObject* parent = nullptr);
+
+    int getProcessCount() const { return (int)_workers.size(); }
+
+    void queueModelBake(const ModelBakeJob& job);
+
+signals:
+    void modelBakeFinished(QUrl modelURL, bool succeeded, QUrl outputMappingURL, QStringList errors, QStringList warnings,
+                           bool fromCache);
+
+private:
+    struct Worker {
+        OvenWorker* oven { nullptr };
+        ModelBakeJob job;
+    };
+
+    void dispatchJobs();
+    void handleBakeFinished(size_t workerIndex, int statusCode, const QJsonObject& details);
+    void handleBakeCrashed(size_t workerIndex, const QString& reason);
+
+    std::vector<Worker> _workers;
+    QQueue<ModelBakeJob> _pendingJobs;
+};
+
+#endif // hifi_OvenWorkerPool_h
@@ -22,6 +22,9 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
+#include <QtCore/QThread>
+
+#include <NumericalConstants.h>
 
 #include "../OvenGUIApplication.h"
 
@@ -130,6 +133,11 @@ void DomainBakeWidget::setupUI() {
     _rebakeOriginalsCheckBox = new QCheckBox("Re-bake originals");
     gridLayout->addWidget(_rebakeOriginalsCheckBox, rowIndex, 0);
 
+    // setup a checkbox to bake models in ovens of their own, which scales with the cores and survives crashing models
+    _separateProcessesCheckBox = new QCheckBox("Bake models in separate processes");
+    _separateProcessesCheckBox->setChecked(true);
+    gridLayout->addWidget(_separateProcessesCheckBox, rowIndex, 1);
+
     // add a button that will kickoff the bake
     QPushButton* bakeButton = new QPushButton("Bake");
     connect(bakeButton, &QPushButton::clicked, this, &DomainBakeWidget::bakeButtonClicked);
@@ -215,6 +223,10 @@ void DomainBakeWidget::bakeButtonClicked() {
                                 _rebakeOriginalsCheckBox->isChecked())
         };
 
+        if (_separateProcessesCheckBox->isChecked()) {
+            domainBaker->setModelProcessCount(QThread::idealThreadCount());
+        }
+
         // make sure we hear from the baker when it is done
         connect(domainBaker.get(), &DomainBaker::finished, this, &DomainBakeWidget::handleFinishedBaker);
 
@@ -238,7 +250,7 @@ void DomainBakeWidget::bakeButtonClicked() {
     }
 }
 
-void DomainBakeWidget::handleBakerProgress(int baked, int total) {
+void DomainBakeWidget::handleBakerProgress(int baked, int total, qint64 msecsRemaining) {
     if (auto baker = qobject_cast<DomainBaker*>(sender())) {
         // add the results of this bake to the results window
         auto it = std::find_if(_bakers.begin(), _bakers.end(), [baker](const BakerRowPair& value) {
@@ -254,6 +266,10 @@ void DomainBakeWidget::handleBakerProgress(int baked, int total) {
             int percentage = roundf(float(baked) / float(total) * 100.0f);
 
             auto statusString = QString("Baking - %1 of %2 - %3%").arg(baked).arg(total).arg(percentage);
+            if (msecsRemaining >= 0) {
+                int minutesRemaining = (int)ceilf(msecsRemaining / (float)(SECS_PER_MINUTE * MSECS_PER_SECOND));
+                statusString += QString(" - about %1 min left").arg(minutesRemaining);
+            }
             resultsWindow->changeStatusForRow(resultRow, statusString);
         }
     }
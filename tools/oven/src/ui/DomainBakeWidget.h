@@ -35,7 +35,7 @@ private slots:
 
     void outputDirectoryChanged(const QString& newDirectory);
 
-    void handleBakerProgress(int baked, int total);
+    void handleBakerProgress(int baked, int total, qint64 msecsRemaining);
     void handleFinishedBaker();
 
 private:
@@ -46,6 +46,7 @@ private:
     QLineEdit* _outputDirLineEdit;
     QLineEdit* _destinationPathLineEdit;
     QCheckBox* _rebakeOriginalsCheckBox;
+    QCheckBox* _separateProcessesCheckBox;
 
     Setting::Handle<QString> _domainNameSetting;
     Setting::Handle<QString> _exportDirectory;